@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 class Screen;
 
+// Each App exposes this as a public `static constexpr AppMetadata METADATA` so
+// the registry and launcher can use it without constructing the app.
 struct AppMetadata {
     const char* id;       // "home", "mtg", "settings"
     const char* name;     // "Home", "MTG Life", "Settings"
@@ -31,4 +34,17 @@ class App {
 
     // Internal navigation - return true if handled, false to pop/exit
     virtual bool handleBack() { return false; }
+
+    // Deep-sleep resume: copy state to/from RTC memory so a warm wake skips
+    // the NVS load in onLaunch(). Returns bytes written / whether restored.
+    virtual size_t saveResumeState(uint8_t* buf, size_t capacity) const {
+        (void)buf;
+        (void)capacity;
+        return 0;
+    }
+    virtual bool restoreResumeState(const uint8_t* buf, size_t len) {
+        (void)buf;
+        (void)len;
+        return false;
+    }
 };
@@ -1,59 +1,170 @@
 #include "AppRegistry.hpp"
 #include <cstring>
 #include "../utils/Log.hpp"
+#include "../utils/Memory.hpp"
 
 AppRegistry& AppRegistry::instance() {
     static AppRegistry instance;
     return instance;
 }
 
+AppRegistry::AppRegistry() : _catalog(installedApps()) {
+    rebuildLauncher();
+}
+
+#ifdef NATIVE_TEST
 void AppRegistry::registerApp(App* app) {
     if (!app) {
         LOG_W("AppRegistry: Attempted to register null app");
         return;
     }
-    if (_count >= MAX_APPS) {
-        LOG_E("AppRegistry: Cannot register app '%s' - MAX_APPS (%d) exceeded", app->metadata().id,
-              MAX_APPS);
+    addRuntimeApp({&app->metadata(), hashAppId(app->metadata().id), nullptr}, app);
+}
+
+void AppRegistry::addRuntimeApp(const AppDescriptor& app, App* instance) {
+    int index = _catalog.count + _runtimeCount;
+    if (index >= static_cast<int>(MAX_APPS)) {
+        LOG_E("AppRegistry: Cannot register app '%s' - MAX_APPS (%d) exceeded", app.metadata->id,
+              static_cast<int>(MAX_APPS));
         return;
     }
+    _runtimeApps[_runtimeCount++] = app;
+    _instances[index] = instance;
+    rebuildLauncher();
+}
+#endif
 
-    _apps[_count++] = app;
+int AppRegistry::appCount() const {
+#ifdef NATIVE_TEST
+    return _catalog.count + _runtimeCount;
+#else
+    return _catalog.count;
+#endif
+}
 
-    // Track home app (non-launchable) separately
-    if (!app->metadata().showInLauncher) {
-        _homeApp = app;
+const AppDescriptor& AppRegistry::descriptor(int index) const {
+#ifdef NATIVE_TEST
+    if (index >= _catalog.count) {
+        return _runtimeApps[index - _catalog.count];
     }
+#endif
+    return _catalog.apps[index];
 }
 
-int AppRegistry::launchableAppCount() const {
-    int count = 0;
-    for (int i = 0; i < _count; i++) {
-        if (_apps[i]->metadata().showInLauncher) {
-            count++;
+// The catalog's launcher order minus hidden apps (then runtime test apps)
+void AppRegistry::rebuildLauncher() {
+    _launcherCount = 0;
+    for (int i = 0; i < _catalog.launcherCount; i++) {
+        uint8_t app = _catalog.launcher[i];
+        if (!(_hiddenMask & (1u << app))) {
+            _launcher[_launcherCount++] = app;
         }
     }
-    return count;
+#ifdef NATIVE_TEST
+    for (int i = 0; i < _runtimeCount; i++) {
+        if (_runtimeApps[i].metadata->showInLauncher) {
+            _launcher[_launcherCount++] = static_cast<uint8_t>(_catalog.count + i);
+        }
+    }
+#endif
+}
+
+int AppRegistry::launchableAppCount() const {
+    return _launcherCount;
+}
+
+const AppMetadata* AppRegistry::getLaunchableMetadata(int index) const {
+    if (index < 0 || index >= _launcherCount)
+        return nullptr;
+    return descriptor(_launcher[index]).metadata;
+}
+
+void AppRegistry::setHidden(const char* id, bool hidden) {
+    int index = findIndex(id);
+    if (index < 0 || index >= _catalog.count) {
+        return;
+    }
+    if (hidden) {
+        _hiddenMask |= 1u << index;
+    } else {
+        _hiddenMask &= ~(1u << index);
+    }
+    rebuildLauncher();
 }
 
-App* AppRegistry::getLaunchableApp(int index) {
-    int seen = 0;
-    for (int i = 0; i < _count; i++) {
-        if (_apps[i]->metadata().showInLauncher) {
-            if (seen == index) {
-                return _apps[i];
-            }
-            seen++;
+bool AppRegistry::isHidden(const char* id) const {
+    int index = findIndex(id);
+    return index >= 0 && index < _catalog.count && (_hiddenMask & (1u << index));
+}
+
+int AppRegistry::findIndex(const char* id) const {
+    if (!id)
+        return -1;
+
+    // One slot probe; the id compare rejects unknown ids that share a slot
+    uint32_t hash = hashAppId(id);
+    int index = _catalog.slots[hash & _catalog.slotMask];
+    if (index >= 0 && _catalog.apps[index].idHash == hash &&
+        strcmp(_catalog.apps[index].metadata->id, id) == 0) {
+        return index;
+    }
+
+#ifdef NATIVE_TEST
+    for (int i = 0; i < _runtimeCount; i++) {
+        if (_runtimeApps[i].idHash == hash && strcmp(_runtimeApps[i].metadata->id, id) == 0) {
+            return _catalog.count + i;
         }
     }
-    return nullptr;
+#endif
+    return -1;
+}
+
+App* AppRegistry::acquire(int index) {
+    if (index < 0)
+        return nullptr;
+
+    if (!_instances[index] && descriptor(index).create) {
+        _instances[index] = descriptor(index).create();
+        LOG_D("AppRegistry: Constructed app '%s'", descriptor(index).metadata->id);
+    }
+    return _instances[index];
 }
 
 App* AppRegistry::findApp(const char* id) {
-    for (int i = 0; i < _count; i++) {
-        if (strcmp(_apps[i]->metadata().id, id) == 0) {
-            return _apps[i];
+    return acquire(findIndex(id));
+}
+
+App* AppRegistry::homeApp() {
+    return acquire(_catalog.home);
+}
+
+bool AppRegistry::isConstructed(const char* id) const {
+    int index = findIndex(id);
+    return index >= 0 && _instances[index] != nullptr;
+}
+
+void AppRegistry::setReclaimPolicy(ReclaimPolicy policy, size_t minFreeInternal) {
+    _reclaimPolicy = policy;
+    _reclaimThreshold = minFreeInternal;
+}
+
+bool AppRegistry::reclaim(App* app) {
+    if (!app || _reclaimPolicy == ReclaimPolicy::Never)
+        return false;
+
+    if (_reclaimPolicy == ReclaimPolicy::WhenLow &&
+        Memory::usage().internalFree >= _reclaimThreshold) {
+        return false;
+    }
+
+    for (int i = 0; i < appCount(); i++) {
+        // Only factory-built apps are ours to destroy; home is relaunched too often to bother
+        if (_instances[i] == app && descriptor(i).create && i != _catalog.home) {
+            LOG_I("AppRegistry: Reclaiming suspended app '%s'", app->metadata().id);
+            delete _instances[i];
+            _instances[i] = nullptr;
+            return true;
         }
     }
-    return nullptr;
+    return false;
 }
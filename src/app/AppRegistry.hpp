@@ -1,26 +1,76 @@
 #pragma once
 
+#include <cstddef>
 #include "App.hpp"
+#include "AppTable.hpp"
 
+// Runtime side of the compile-time app table. Apps are constructed on first
+// launch, so the app set costs flash, not RAM, until it is used.
 class AppRegistry {
    public:
-    static AppRegistry& instance();
+    // When to destroy a suspended app after switching away (state is
+    // persisted in onSuspend, so it is rebuilt on the next launch)
+    enum class ReclaimPolicy : uint8_t {
+        Never,    // Keep every launched app resident
+        WhenLow,  // Reclaim when free internal heap drops below the threshold
+        Always,   // Reclaim on every app switch
+    };
 
-    void registerApp(App* app);
+    static AppRegistry& instance();
 
-    // For HomeApp to enumerate launchable apps
+    // For HomeApp to enumerate launchable apps without constructing them
     int launchableAppCount() const;
-    App* getLaunchableApp(int index);
+    const AppMetadata* getLaunchableMetadata(int index) const;
 
-    // For Navigation
+    // Keep an installed app off the launcher (e.g. Diagnostics until enabled
+    // in settings); it can still be launched by id
+    void setHidden(const char* id, bool hidden);
+    bool isHidden(const char* id) const;
+
+    // For Navigation - constructs the app on first use
     App* findApp(const char* id);
-    App* homeApp() const { return _homeApp; }
+    App* homeApp();
+    bool isConstructed(const char* id) const;
+
+    // Suspended-app memory reclamation
+    void setReclaimPolicy(ReclaimPolicy policy, size_t minFreeInternal = DEFAULT_RECLAIM_THRESHOLD);
+    ReclaimPolicy reclaimPolicy() const { return _reclaimPolicy; }
+    bool reclaim(App* app);  // Returns true if the app was destroyed
+
+    static constexpr size_t DEFAULT_RECLAIM_THRESHOLD = 48 * 1024;
+
+#ifdef NATIVE_TEST
+    // Runtime registration for test apps; firmware apps are declared in InstalledApps.cpp
+    template <typename T>
+    void registerApp() {
+        addRuntimeApp({&T::METADATA, hashAppId(T::METADATA.id), &createApp<T>}, nullptr);
+    }
+    void registerApp(App* app);  // Pre-built, owned by the caller (never reclaimed)
+#endif
 
    private:
-    AppRegistry() = default;
+    AppRegistry();
+
+    // Index space: compile-time apps first, then runtime (test) apps
+    int appCount() const;
+    int findIndex(const char* id) const;
+    const AppDescriptor& descriptor(int index) const;
+    App* acquire(int index);
+    void rebuildLauncher();
+
+    const AppCatalog& _catalog;
+    App* _instances[MAX_APPS] = {nullptr};
+    uint16_t _hiddenMask = 0;  // Bit per compile-time app index
+    // Visible launcher entries (app indices), rebuilt when visibility changes so
+    // HomeScreen reads them in constant time
+    uint8_t _launcher[MAX_APPS] = {};
+    int _launcherCount = 0;
+    ReclaimPolicy _reclaimPolicy = ReclaimPolicy::WhenLow;
+    size_t _reclaimThreshold = DEFAULT_RECLAIM_THRESHOLD;
 
-    static constexpr int MAX_APPS = 8;
-    App* _apps[MAX_APPS] = {nullptr};
-    int _count = 0;
-    App* _homeApp = nullptr;
+#ifdef NATIVE_TEST
+    void addRuntimeApp(const AppDescriptor& app, App* instance);
+    AppDescriptor _runtimeApps[MAX_APPS] = {};
+    int _runtimeCount = 0;
+#endif
 };
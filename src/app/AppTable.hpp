@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "App.hpp"
+
+// Compile-time app table. The firmware's app set is a type list
+// (see apps/InstalledApps.cpp); ids are hashed, checked for collisions and
+// laid out in a direct-mapped slot table at compile time, and the launcher
+// order is a precomputed index array. Written for C++11 constexpr.
+
+static constexpr size_t MAX_APPS = 8;
+static constexpr uint32_t MAX_APP_SLOTS = 256;
+
+// FNV-1a
+constexpr uint32_t hashAppId(const char* id, uint32_t hash = 2166136261u) {
+    return *id ? hashAppId(id + 1, (hash ^ static_cast<uint8_t>(*id)) * 16777619u) : hash;
+}
+
+struct AppDescriptor {
+    const AppMetadata* metadata;
+    uint32_t idHash;
+    App* (*create)();  // nullptr for pre-built apps
+};
+
+// Type-erased view of an AppTable, consumed by AppRegistry
+struct AppCatalog {
+    const AppDescriptor* apps;
+    uint8_t count;
+    const int8_t* slots;  // (idHash & slotMask) -> app index, -1 if empty
+    uint32_t slotMask;
+    const uint8_t* launcher;  // App indices in launcher order
+    uint8_t launcherCount;
+    int8_t home;
+};
+
+// The firmware's app set - defined in apps/InstalledApps.cpp
+const AppCatalog& installedApps();
+
+template <typename T>
+App* createApp() {
+    return new T();
+}
+
+namespace AppTableDetail {
+
+template <size_t... Is>
+struct Indices {};
+template <size_t N, size_t... Is>
+struct MakeIndices : MakeIndices<N - 1, N - 1, Is...> {};
+template <size_t... Is>
+struct MakeIndices<0, Is...> {
+    using type = Indices<Is...>;
+};
+
+constexpr bool slotFree(uint32_t, uint32_t) {
+    return true;
+}
+template <typename... H>
+constexpr bool slotFree(uint32_t mask, uint32_t slot, uint32_t hash, H... rest) {
+    return (hash & mask) != slot && slotFree(mask, slot, rest...);
+}
+
+constexpr bool distinctSlots(uint32_t) {
+    return true;
+}
+template <typename... H>
+constexpr bool distinctSlots(uint32_t mask, uint32_t hash, H... rest) {
+    return slotFree(mask, hash & mask, rest...) && distinctSlots(mask, rest...);
+}
+
+// Smallest power-of-two table (at least 2x the app count) with no collisions;
+// 0 if none fits, which also catches duplicate ids
+template <typename... H>
+constexpr uint32_t slotMask(uint32_t slots, H... hashes) {
+    return slots > MAX_APP_SLOTS                ? 0
+           : distinctSlots(slots - 1, hashes...) ? slots - 1
+                                                 : slotMask(slots * 2, hashes...);
+}
+
+constexpr uint32_t initialSlots(size_t count, uint32_t slots = 2) {
+    return slots >= 2 * count ? slots : initialSlots(count, slots * 2);
+}
+
+constexpr int8_t slotOwner(uint32_t, uint32_t, int) {
+    return -1;
+}
+template <typename... H>
+constexpr int8_t slotOwner(uint32_t mask, uint32_t slot, int index, uint32_t hash, H... rest) {
+    return (hash & mask) == slot ? index : slotOwner(mask, slot, index + 1, rest...);
+}
+
+constexpr size_t countLaunchable() {
+    return 0;
+}
+template <typename... F>
+constexpr size_t countLaunchable(bool launchable, F... rest) {
+    return (launchable ? 1 : 0) + countLaunchable(rest...);
+}
+
+constexpr uint8_t nthLaunchable(size_t, int) {
+    return 0;
+}
+template <typename... F>
+constexpr uint8_t nthLaunchable(size_t n, int index, bool launchable, F... rest) {
+    return !launchable ? nthLaunchable(n, index + 1, rest...)
+           : n == 0    ? index
+                       : nthLaunchable(n - 1, index + 1, rest...);
+}
+
+constexpr int8_t firstHome(int) {
+    return -1;
+}
+template <typename... F>
+constexpr int8_t firstHome(int index, bool launchable, F... rest) {
+    return !launchable ? index : firstHome(index + 1, rest...);
+}
+
+template <uint32_t Mask, typename Slots, uint32_t... Hashes>
+struct SlotTable;
+template <uint32_t Mask, size_t... Slots, uint32_t... Hashes>
+struct SlotTable<Mask, Indices<Slots...>, Hashes...> {
+    static constexpr int8_t VALUES[sizeof...(Slots)] = {slotOwner(Mask, Slots, 0, Hashes...)...};
+};
+template <uint32_t Mask, size_t... Slots, uint32_t... Hashes>
+constexpr int8_t SlotTable<Mask, Indices<Slots...>, Hashes...>::VALUES[];
+
+template <typename Positions, bool... Launchable>
+struct LauncherTable;
+template <size_t... Positions, bool... Launchable>
+struct LauncherTable<Indices<Positions...>, Launchable...> {
+    // Sized to at least 1 so an app set with no launchable apps still compiles
+    static constexpr uint8_t VALUES[sizeof...(Positions) + 1] = {
+        nthLaunchable(Positions, 0, Launchable...)...};
+};
+template <size_t... Positions, bool... Launchable>
+constexpr uint8_t LauncherTable<Indices<Positions...>, Launchable...>::VALUES[];
+
+}  // namespace AppTableDetail
+
+// Each app type must expose a public `static constexpr AppMetadata METADATA`
+template <typename... Apps>
+class AppTable {
+   public:
+    static constexpr size_t COUNT = sizeof...(Apps);
+    static constexpr uint32_t SLOT_MASK = AppTableDetail::slotMask(
+        AppTableDetail::initialSlots(COUNT), hashAppId(Apps::METADATA.id)...);
+    static constexpr size_t LAUNCHER_COUNT =
+        AppTableDetail::countLaunchable(Apps::METADATA.showInLauncher...);
+    static constexpr int8_t HOME = AppTableDetail::firstHome(0, Apps::METADATA.showInLauncher...);
+
+    static_assert(COUNT > 0 && COUNT <= MAX_APPS, "AppTable: app count exceeds MAX_APPS");
+    static_assert(SLOT_MASK != 0, "AppTable: duplicate app ids");
+    static_assert(HOME >= 0, "AppTable: no home app (showInLauncher = false)");
+
+    static constexpr AppDescriptor APPS[COUNT] = {
+        {&Apps::METADATA, hashAppId(Apps::METADATA.id), &createApp<Apps>}...};
+
+    using Slots =
+        AppTableDetail::SlotTable<SLOT_MASK,
+                                  typename AppTableDetail::MakeIndices<SLOT_MASK + 1>::type,
+                                  hashAppId(Apps::METADATA.id)...>;
+    using Launcher =
+        AppTableDetail::LauncherTable<typename AppTableDetail::MakeIndices<LAUNCHER_COUNT>::type,
+                                      Apps::METADATA.showInLauncher...>;
+
+    static constexpr AppCatalog CATALOG = {
+        APPS, COUNT, Slots::VALUES, SLOT_MASK, Launcher::VALUES, LAUNCHER_COUNT, HOME};
+};
+
+template <typename... Apps>
+constexpr size_t AppTable<Apps...>::COUNT;
+template <typename... Apps>
+constexpr uint32_t AppTable<Apps...>::SLOT_MASK;
+template <typename... Apps>
+constexpr size_t AppTable<Apps...>::LAUNCHER_COUNT;
+template <typename... Apps>
+constexpr int8_t AppTable<Apps...>::HOME;
+template <typename... Apps>
+constexpr AppDescriptor AppTable<Apps...>::APPS[];
+template <typename... Apps>
+constexpr AppCatalog AppTable<Apps...>::CATALOG;
@@ -2,13 +2,19 @@
 #include <Preferences.h>
 #include <cstring>
 #include "../ui/Screen.hpp"
+#include "../utils/FixedString.hpp"
 #include "../utils/Log.hpp"
+#include "../utils/Memory.hpp"
+#include "../utils/Metrics.hpp"
+#include "../utils/Stall.hpp"
+#include "../utils/Trace.hpp"
 #include "App.hpp"
 #include "AppRegistry.hpp"
 
 static constexpr const char* PREF_NAMESPACE = "nav";
 static constexpr const char* PREF_APP_ID = "appId";
 static constexpr const char* PREF_SCREEN_ID = "screenId";
+static constexpr size_t MAX_ID_LEN = 15;  // App and screen ids are short literals
 
 Navigation& Navigation::instance() {
     static Navigation nav;
@@ -38,8 +44,9 @@ void Navigation::launchApp(App* app) {
         return;
 
     // Suspend current app if exists
-    if (_currentApp) {
-        _currentApp->onSuspend();
+    App* previous = _currentApp;
+    if (previous) {
+        previous->onSuspend();
     }
 
     // Clear the screen stack
@@ -54,10 +61,18 @@ void Navigation::launchApp(App* app) {
     if (mainScreen) {
         _screenStack[0] = mainScreen;
         _stackDepth = 1;
+        enterMemoryScope(mainScreen);
+        Stall::Watch watch(StallPhase::Enter, mainScreen->screenId());
         mainScreen->onEnter();
         mainScreen->setNeedsFullRedraw(true);
     }
 
+    // The suspended app may still be on the call stack (e.g. a HOME button
+    // callback), so any teardown waits for the next update()
+    if (previous && previous != app) {
+        _pendingReclaim = previous;
+    }
+
     saveState();
 }
 
@@ -91,7 +106,11 @@ void Navigation::pushScreen(Screen* screen) {
 
     // Push new screen
     _screenStack[_stackDepth++] = screen;
-    screen->onEnter();
+    enterMemoryScope(screen);
+    {
+        Stall::Watch watch(StallPhase::Enter, screen->screenId());
+        screen->onEnter();
+    }
     screen->setNeedsFullRedraw(true);
 
     saveState();
@@ -115,6 +134,8 @@ void Navigation::popScreen() {
     // Re-enter previous screen
     Screen* prev = currentScreen();
     if (prev) {
+        enterMemoryScope(prev);
+        Stall::Watch watch(StallPhase::Enter, prev->screenId());
         prev->onEnter();
         prev->setNeedsFullRedraw(true);
     }
@@ -122,8 +143,16 @@ void Navigation::popScreen() {
 }
 
 void Navigation::update() {
+    if (_pendingReclaim) {
+        if (_pendingReclaim != _currentApp) {
+            AppRegistry::instance().reclaim(_pendingReclaim);
+        }
+        _pendingReclaim = nullptr;
+    }
+
     Screen* screen = currentScreen();
     if (screen) {
+        Stall::Watch watch(StallPhase::Update, screen->screenId());
         screen->update();
     }
 }
@@ -131,19 +160,61 @@ void Navigation::update() {
 void Navigation::draw(M5GFX* gfx) {
     Screen* screen = currentScreen();
     if (screen) {
+        TRACE_SCOPE_ARG("draw", screen->screenId());
+        Stall::Watch watch(StallPhase::Draw, screen->screenId());
         screen->draw(gfx);
+        Memory::sampleScope();
     }
 }
 
-bool Navigation::handleTouch(int16_t x, int16_t y, bool pressed, bool released) {
+void Navigation::enterMemoryScope(Screen* screen) {
+    // Baseline is taken before onEnter() so the screen's own allocations count
+    Memory::enterScope(_currentApp ? _currentApp->metadata().id : "?", screen->screenId(),
+                       screen->memoryBudget());
+}
+
+bool Navigation::handleTouch(TouchPoint point) {
+    // The first finger down stays primary until it lifts, even if a second
+    // one lands meanwhile; single-touch screens only see the primary point.
+    // Only a touch starting now can become primary: a finger still held when
+    // the primary lifts never does, so no screen sees a touch begin mid-hold.
+    uint32_t bit = 1u << (point.id & 31);
+    bool starting = !(_touchesDown & bit);
+    if (point.released) {
+        _touchesDown &= ~bit;
+    } else if (point.pressed) {
+        _touchesDown |= bit;
+    }
+    if (_primaryTouch < 0 && starting && (point.pressed || point.released)) {
+        _primaryTouch = static_cast<int8_t>(point.id);
+    }
+    point.primary = point.id == _primaryTouch;
+    if (point.primary && point.released) {
+        _primaryTouch = -1;
+    }
+
     Screen* screen = currentScreen();
     if (screen) {
-        return screen->handleTouch(x, y, pressed, released);
+        Stall::Watch watch(StallPhase::Touch, screen->screenId());
+        return screen->handleTouchPoint(point);
     }
     return false;
 }
 
+bool Navigation::handleTouch(int16_t x, int16_t y, bool pressed, bool released) {
+    TouchPoint point;
+    point.x = x;
+    point.y = y;
+    point.pressed = pressed;
+    point.released = released;
+    return handleTouch(point);
+}
+
 void Navigation::saveState() {
+    if (!_persist)
+        return;
+
+    TRACE_SCOPE_ARG("nvs.save", PREF_NAMESPACE);
     Preferences prefs;
     prefs.begin(PREF_NAMESPACE, false);
 
@@ -158,14 +229,19 @@ void Navigation::saveState() {
     }
 
     prefs.end();
+    Metrics::onNvsWrite();
 }
 
 void Navigation::restoreState() {
+    TRACE_SCOPE_ARG("nvs.load", PREF_NAMESPACE);
     Preferences prefs;
     prefs.begin(PREF_NAMESPACE, true);  // Read-only
 
-    String appId = prefs.getString(PREF_APP_ID, "home");
-    String screenId = prefs.getString(PREF_SCREEN_ID, "main");
+    // Read into inline buffers; defaults are kept if a key is missing or oversized
+    FixedString<MAX_ID_LEN> appId("home");
+    FixedString<MAX_ID_LEN> screenId("main");
+    prefs.getString(PREF_APP_ID, appId.data(), appId.capacity() + 1);
+    prefs.getString(PREF_SCREEN_ID, screenId.data(), screenId.capacity() + 1);
     prefs.end();
 
     LOG_D("[Nav] Restoring: app='%s', screen='%s'", appId.c_str(), screenId.c_str());
@@ -188,3 +264,37 @@ void Navigation::restoreState() {
         }
     }
 }
+
+void Navigation::captureStack(NavStackSnapshot& out) const {
+    memset(&out, 0, sizeof(out));
+    if (!_currentApp)
+        return;
+
+    strncpy(out.appId, _currentApp->metadata().id, NavStackSnapshot::ID_LEN - 1);
+    out.depth = static_cast<uint8_t>(_stackDepth);
+    for (int i = 0; i < _stackDepth; i++) {
+        strncpy(out.screenIds[i], _screenStack[i]->screenId(), NavStackSnapshot::ID_LEN - 1);
+    }
+}
+
+bool Navigation::restoreStack(const NavStackSnapshot& snapshot) {
+    App* app = AppRegistry::instance().findApp(snapshot.appId);
+    if (!app || snapshot.depth == 0 || snapshot.depth > MAX_DEPTH)
+        return false;
+
+    _persist = false;
+    launchApp(app);
+    for (int i = 1; i < snapshot.depth; i++) {
+        Screen* screen = app->getScreen(snapshot.screenIds[i]);
+        if (screen) {
+            pushScreen(screen);
+        }
+    }
+    _persist = true;
+
+    Screen* top = currentScreen();
+    if (top) {
+        top->setPanelRetained(true);
+    }
+    return true;
+}
@@ -1,10 +1,21 @@
 #pragma once
 
 #include <M5GFX.h>
+#include "../utils/TouchPoint.hpp"
 
 class App;
 class Screen;
 
+// Plain-data copy of the navigation stack, kept in RTC memory across deep sleep
+struct NavStackSnapshot {
+    static constexpr int MAX_DEPTH = 4;
+    static constexpr int ID_LEN = 16;
+
+    char appId[ID_LEN];
+    uint8_t depth;
+    char screenIds[MAX_DEPTH][ID_LEN];
+};
+
 class Navigation {
    public:
     static Navigation& instance();
@@ -22,7 +33,10 @@ class Navigation {
     // Main loop
     void update();
     void draw(M5GFX* gfx);
-    bool handleTouch(int16_t x, int16_t y, bool pressed, bool released);
+    // One touch point per call; several may arrive in one loop. Marks the
+    // primary point before handing it to the screen.
+    bool handleTouch(TouchPoint point);
+    bool handleTouch(int16_t x, int16_t y, bool pressed, bool released);  // Point 0
 
     // Accessors
     App* currentApp() const { return _currentApp; }
@@ -32,13 +46,23 @@ class Navigation {
     void saveState();
     void restoreState();
 
+    // Deep-sleep resume: rebuild the stack without touching NVS. The restored
+    // screen is marked as still shown on the EPD.
+    void captureStack(NavStackSnapshot& out) const;
+    bool restoreStack(const NavStackSnapshot& snapshot);
+
    private:
     Navigation() = default;
 
     App* _currentApp = nullptr;
-    static constexpr int MAX_DEPTH = 4;
+    App* _pendingReclaim = nullptr;  // Suspended app to offer to AppRegistry::reclaim()
+    static constexpr int MAX_DEPTH = NavStackSnapshot::MAX_DEPTH;
     Screen* _screenStack[MAX_DEPTH] = {nullptr};
     int _stackDepth = 0;
+    bool _persist = true;  // Cleared while restoring from RTC so NVS is left alone
+    int8_t _primaryTouch = -1;  // Id of the first finger down, -1 when none
+    uint32_t _touchesDown = 0;  // Bit per finger id seen pressed and not yet released
 
     void clearStack();
+    void enterMemoryScope(Screen* screen);
 };
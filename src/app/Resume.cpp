@@ -0,0 +1,97 @@
+#include "Resume.hpp"
+#include <Arduino.h>
+#include <esp_sleep.h>
+#include <cstring>
+#include <type_traits>
+#include "../utils/Log.hpp"
+#include "App.hpp"
+#include "AppRegistry.hpp"
+#include "Navigation.hpp"
+
+namespace Resume {
+
+static constexpr uint32_t SNAPSHOT_MAGIC = 0x52534D31;  // "RSM1"
+
+// Plain data only: a constructor would re-run on wake and wipe the snapshot
+struct Snapshot {
+    uint32_t magic;
+    uint32_t checksum;  // Over everything after this field
+    uint8_t settings[sizeof(Settings)];
+    NavStackSnapshot nav;
+    uint16_t appStateLen;
+    uint8_t appState[APP_STATE_MAX];
+};
+
+static_assert(std::is_trivially_copyable<Settings>::value, "Settings is copied as bytes");
+
+RTC_DATA_ATTR static Snapshot rtcSnapshot;
+
+// FNV-1a
+static uint32_t checksum(const Snapshot& snapshot) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&snapshot.checksum + 1);
+    const uint8_t* end = reinterpret_cast<const uint8_t*>(&snapshot + 1);
+    uint32_t hash = 2166136261u;
+    for (; bytes < end; bytes++) {
+        hash = (hash ^ *bytes) * 16777619u;
+    }
+    return hash;
+}
+
+static bool snapshotValid() {
+    return rtcSnapshot.magic == SNAPSHOT_MAGIC && rtcSnapshot.checksum == checksum(rtcSnapshot);
+}
+
+void capture(const Settings& settings) {
+    memset(&rtcSnapshot, 0, sizeof(rtcSnapshot));
+    memcpy(rtcSnapshot.settings, &settings, sizeof(Settings));
+
+    auto& nav = Navigation::instance();
+    nav.captureStack(rtcSnapshot.nav);
+    if (nav.currentApp()) {
+        rtcSnapshot.appStateLen = static_cast<uint16_t>(
+            nav.currentApp()->saveResumeState(rtcSnapshot.appState, APP_STATE_MAX));
+    }
+
+    rtcSnapshot.magic = SNAPSHOT_MAGIC;
+    rtcSnapshot.checksum = checksum(rtcSnapshot);
+    LOG_D("Resume: captured app='%s' depth=%d state=%u bytes", rtcSnapshot.nav.appId,
+          rtcSnapshot.nav.depth, rtcSnapshot.appStateLen);
+}
+
+bool isWarmWake() {
+    return esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_UNDEFINED && snapshotValid();
+}
+
+bool restore(Settings& settings) {
+    if (!isWarmWake()) {
+        invalidate();
+        return false;
+    }
+
+    // Consume first so a crash while restoring falls back to a cold boot next time
+    Snapshot snapshot = rtcSnapshot;
+    invalidate();
+
+    NavStackSnapshot& nav = snapshot.nav;
+    nav.appId[NavStackSnapshot::ID_LEN - 1] = '\0';
+    for (int i = 0; i < NavStackSnapshot::MAX_DEPTH; i++) {
+        nav.screenIds[i][NavStackSnapshot::ID_LEN - 1] = '\0';
+    }
+
+    App* app = AppRegistry::instance().findApp(nav.appId);
+    if (!app)
+        return false;
+    if (snapshot.appStateLen > 0 &&
+        !app->restoreResumeState(snapshot.appState, snapshot.appStateLen)) {
+        return false;
+    }
+
+    memcpy(&settings, snapshot.settings, sizeof(Settings));
+    return Navigation::instance().restoreStack(nav);
+}
+
+void invalidate() {
+    rtcSnapshot.magic = 0;
+}
+
+}  // namespace Resume
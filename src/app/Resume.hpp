@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../models/Settings.hpp"
+
+// Instant resume from deep sleep. Before sleeping, Settings, the navigation
+// stack and the foreground app's state are copied into RTC memory, which
+// survives deep sleep but not a power cut. A warm wake restores them without
+// touching NVS and redraws over the image the EPD is still showing.
+namespace Resume {
+
+static constexpr size_t APP_STATE_MAX = 160;  // Fits GameState with headroom
+
+// Snapshot the running system (call right before deep sleep)
+void capture(const Settings& settings);
+
+// True if this boot is a wake from deep sleep with a valid snapshot
+bool isWarmWake();
+
+// Restore settings and navigation from the snapshot. Returns false (cold boot
+// path) if there is no valid snapshot. Consumes the snapshot either way.
+bool restore(Settings& settings);
+
+void invalidate();
+
+}  // namespace Resume
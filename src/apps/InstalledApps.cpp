@@ -0,0 +1,12 @@
+#include "../app/AppTable.hpp"
+#include "diagnostics/DiagnosticsApp.hpp"
+#include "home/HomeApp.hpp"
+#include "mtg/MTGApp.hpp"
+#include "settings/SettingsApp.hpp"
+
+// Every app in the firmware. Launcher order follows this list.
+using InstalledApps = AppTable<HomeApp, MTGApp, SettingsApp, DiagnosticsApp>;
+
+const AppCatalog& installedApps() {
+    return InstalledApps::CATALOG;
+}
@@ -0,0 +1,4 @@
+#include "DiagnosticsApp.hpp"
+
+// Define static constexpr member (required for ODR-use)
+constexpr AppMetadata DiagnosticsApp::METADATA;
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../../app/App.hpp"
+#include "../../assets/icons.hpp"
+#include "DiagnosticsScreen.hpp"
+
+// Live performance readout. Off the launcher until enabled in System Settings.
+class DiagnosticsApp : public App {
+   public:
+    static constexpr AppMetadata METADATA = {
+        "diag", "Diagnostics", ICON_DIAGNOSTICS,
+        true  // Shown in launcher unless hidden by the setting
+    };
+
+    DiagnosticsApp() = default;
+
+    const AppMetadata& metadata() const override { return METADATA; }
+    Screen* getMainScreen() override { return &_screen; }
+
+   private:
+    DiagnosticsScreen _screen;
+};
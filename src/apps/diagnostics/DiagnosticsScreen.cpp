@@ -0,0 +1,256 @@
+#include "DiagnosticsScreen.hpp"
+#include <Arduino.h>
+#include <cstdio>
+#include "../../app/Navigation.hpp"
+#include "../../ui/Layout.hpp"
+#include "../../utils/AllocTracker.hpp"
+#include "../../utils/Battery.hpp"
+#include "../../utils/Memory.hpp"
+#include "../../utils/Metrics.hpp"
+#include "../../utils/Power.hpp"
+#include "../../utils/Stall.hpp"
+
+// Two columns of label/value rows, then the full-width stall and
+// allocation summaries
+static constexpr int16_t START_Y = Layout::headerContentY() + 24;
+static constexpr int16_t ROW_HEIGHT = 50;
+static constexpr int16_t VALUE_H = 36;
+static constexpr int16_t LEFT_LABEL_X = 30;
+static constexpr int16_t LEFT_VALUE_X = 210;
+static constexpr int16_t RIGHT_LABEL_X = 510;
+static constexpr int16_t RIGHT_VALUE_X = 640;
+static constexpr int16_t LEFT_VALUE_W = RIGHT_LABEL_X - LEFT_VALUE_X - 20;
+static constexpr int16_t RIGHT_VALUE_W = Layout::screenW() - RIGHT_VALUE_X - 20;
+
+struct FieldLayout {
+    const char* label;
+    int16_t labelX;
+    int16_t valueX;
+    int16_t valueW;
+    int8_t row;
+};
+
+static const FieldLayout FIELDS[DiagnosticsScreen::FIELD_COUNT] = {
+    {"Loop:", LEFT_LABEL_X, LEFT_VALUE_X, LEFT_VALUE_W, 0},
+    {"Draw:", LEFT_LABEL_X, LEFT_VALUE_X, LEFT_VALUE_W, 1},
+    {"Present:", LEFT_LABEL_X, LEFT_VALUE_X, LEFT_VALUE_W, 2},
+    {"Refresh:", LEFT_LABEL_X, LEFT_VALUE_X, LEFT_VALUE_W, 3},
+    {"NVS:", LEFT_LABEL_X, LEFT_VALUE_X, LEFT_VALUE_W, 4},
+    {"Heap:", RIGHT_LABEL_X, RIGHT_VALUE_X, RIGHT_VALUE_W, 0},
+    {"PSRAM:", RIGHT_LABEL_X, RIGHT_VALUE_X, RIGHT_VALUE_W, 1},
+    {"Uptime:", RIGHT_LABEL_X, RIGHT_VALUE_X, RIGHT_VALUE_W, 2},
+    {"Battery:", RIGHT_LABEL_X, RIGHT_VALUE_X, RIGHT_VALUE_W, 3},
+    {"Trend:", RIGHT_LABEL_X, RIGHT_VALUE_X, RIGHT_VALUE_W, 4},
+    {"Stalls:", LEFT_LABEL_X, LEFT_VALUE_X, Layout::screenW() - LEFT_VALUE_X - 20, 5},
+    {"Allocs:", LEFT_LABEL_X, LEFT_VALUE_X, Layout::screenW() - LEFT_VALUE_X - 20, 6},
+};
+
+static constexpr size_t ALLOC_SCREENS = 3;
+
+// The trend field's text is the history, one character per point
+static constexpr char TREND_BASE = 'A';
+static constexpr int TREND_STEP = 2;  // Percent per character step
+
+DiagnosticsScreen::DiagnosticsScreen() : HeaderScreen("DIAGNOSTICS") {}
+
+void DiagnosticsScreen::onEnter() {
+    setLeftButton("< HOME", []() { Navigation::instance().goHome(); });
+    readValues();
+    _lastUpdateMs = millis();
+    setNeedsFullRedraw(true);
+}
+
+void DiagnosticsScreen::onUpdate() {
+    uint32_t now = millis();
+    if (now - _lastUpdateMs >= UPDATE_MS) {
+        _lastUpdateMs = now;
+        readValues();
+    }
+}
+
+Rect DiagnosticsScreen::valueRect(Field field) {
+    const FieldLayout& f = FIELDS[field];
+    return Rect(f.valueX, START_Y + f.row * ROW_HEIGHT, f.valueW, VALUE_H);
+}
+
+void DiagnosticsScreen::setValue(Field field, const char* text) {
+    if (_values[field] != text) {
+        _values[field] = text;
+        _dirty[field] = true;
+    }
+}
+
+// Tenths of a millisecond from microseconds, e.g. "12.3"
+static void formatMs(char* buf, size_t len, uint32_t us) {
+    snprintf(buf, len, "%lu.%01lu", static_cast<unsigned long>(us / 1000),
+             static_cast<unsigned long>(us / 100 % 10));
+}
+
+void DiagnosticsScreen::readValues() {
+    const PerfCounters& perf = Metrics::counters();
+    char text[VALUE_LEN + 1];
+    char avg[16];
+    char max[16];
+
+    snprintf(text, sizeof(text), "%lu.%01lu Hz",
+             static_cast<unsigned long>(perf.loopCentiHz() / 100),
+             static_cast<unsigned long>(perf.loopCentiHz() / 10 % 10));
+    setValue(LOOP_RATE, text);
+
+    formatMs(avg, sizeof(avg), perf.renderAvgUs());
+    formatMs(max, sizeof(max), perf.renderMaxUs());
+    snprintf(text, sizeof(text), "%s ms (max %s)", avg, max);
+    setValue(DRAW_TIME, text);
+
+    formatMs(avg, sizeof(avg), perf.presentAvgUs());
+    formatMs(max, sizeof(max), perf.presentMaxUs());
+    snprintf(text, sizeof(text), "%s ms (max %s)", avg, max);
+    setValue(PRESENT_TIME, text);
+
+    snprintf(text, sizeof(text), "%lu full, %lu partial",
+             static_cast<unsigned long>(perf.fullRefreshes()),
+             static_cast<unsigned long>(perf.partialRefreshes()));
+    setValue(REFRESHES, text);
+
+    snprintf(text, sizeof(text), "%lu writes", static_cast<unsigned long>(perf.nvsWrites()));
+    setValue(NVS_WRITES, text);
+
+    // Free now and the lowest free since boot (the usage high-water mark)
+    Memory::Usage mem = Memory::usage();
+    snprintf(text, sizeof(text), "%uK free, low %uK",
+             static_cast<unsigned>(mem.internalFree / 1024),
+             static_cast<unsigned>(mem.internalMinFree / 1024));
+    setValue(HEAP, text);
+    snprintf(text, sizeof(text), "%uK free, low %uK", static_cast<unsigned>(mem.psramFree / 1024),
+             static_cast<unsigned>(mem.psramMinFree / 1024));
+    setValue(PSRAM, text);
+
+    uint32_t secs = millis() / 1000;
+    snprintf(text, sizeof(text), "%luh %02lum %02lus", static_cast<unsigned long>(secs / 3600),
+             static_cast<unsigned long>(secs / 60 % 60), static_cast<unsigned long>(secs % 60));
+    setValue(UPTIME, text);
+
+    const BatteryEstimator& battery = Battery::estimator();
+    PowerProfile profile = Power::activeProfile();
+    uint16_t drain = battery.drainCentiPercentPerHour(profile);
+    if (Battery::percent() < 0) {
+        snprintf(text, sizeof(text), "--");
+    } else if (battery.charging()) {
+        snprintf(text, sizeof(text), "%d%% charging", Battery::percent());
+    } else {
+        // '?' until this profile's drain rate has been learned
+        snprintf(text, sizeof(text), "%d%% -%u.%01u%%/h%s", Battery::percent(), drain / 100,
+                 drain / 10 % 10, battery.learned(profile) ? "" : "?");
+    }
+    setValue(BATTERY, text);
+
+    int8_t levels[Battery::HISTORY_POINTS];
+    int points = Battery::history(levels, Battery::HISTORY_POINTS);
+    for (int i = 0; i < points; i++) {
+        text[i] = static_cast<char>(TREND_BASE + levels[i] / TREND_STEP);
+    }
+    text[points] = '\0';
+    setValue(BATTERY_TREND, text);
+
+    Stall::format(text, sizeof(text));
+    setValue(STALLS, text);
+
+    formatAllocs(text, sizeof(text));
+    setValue(ALLOCS, text);
+}
+
+// The screens with the most heap allocations while on top, e.g.
+// "mtg/main 42  home/main 7  diag/main 0"
+void DiagnosticsScreen::formatAllocs(char* buf, size_t len) {
+    if (!AllocTracker::enabled()) {
+        snprintf(buf, len, "-- (ALLOC_TRACK builds)");
+        return;
+    }
+    const MemoryLedger& ledger = Memory::ledger();
+    const MemoryScopeStats* top[ALLOC_SCREENS] = {nullptr};
+    for (size_t i = 0; i < ledger.count(); i++) {
+        const MemoryScopeStats* s = &ledger.at(i);
+        for (size_t t = 0; t < ALLOC_SCREENS; t++) {
+            if (!top[t] || s->allocs > top[t]->allocs) {
+                for (size_t m = ALLOC_SCREENS - 1; m > t; m--) {
+                    top[m] = top[m - 1];
+                }
+                top[t] = s;
+                break;
+            }
+        }
+    }
+    size_t o = 0;
+    buf[0] = '\0';
+    for (size_t t = 0; t < ALLOC_SCREENS && top[t] && o < len; t++) {
+        int n = snprintf(buf + o, len - o, "%s%s %lu", t ? "  " : "", top[t]->name.c_str(),
+                         static_cast<unsigned long>(top[t]->allocs));
+        if (n < 0) {
+            break;
+        }
+        o += static_cast<size_t>(n);
+    }
+}
+
+void DiagnosticsScreen::drawTrend(M5GFX* gfx, const Rect& r) {
+    // Filtered level, 0-100% over the box height, one point per history interval
+    const char* trend = _values[BATTERY_TREND].c_str();
+    int points = static_cast<int>(_values[BATTERY_TREND].length());
+    gfx->drawRect(r.x, r.y, r.w, r.h, TFT_BLACK);
+    if (points == 0) {
+        return;
+    }
+    int16_t stepX = (r.w - 4) / (Battery::HISTORY_POINTS - 1);
+    int16_t lastX = 0;
+    int16_t lastY = 0;
+    for (int i = 0; i < points; i++) {
+        int level = (trend[i] - TREND_BASE) * TREND_STEP;
+        int16_t x = r.x + 2 + i * stepX;
+        int16_t y = r.y + r.h - 2 - level * (r.h - 4) / 100;
+        if (i > 0) {
+            gfx->drawLine(lastX, lastY, x, y, TFT_BLACK);
+        }
+        gfx->fillRect(x - 1, y - 1, 3, 3, TFT_BLACK);
+        lastX = x;
+        lastY = y;
+    }
+}
+
+void DiagnosticsScreen::drawValue(M5GFX* gfx, Field field) {
+    Rect r = valueRect(field);
+    gfx->fillRect(r.x, r.y, r.w, r.h, TFT_WHITE);
+    if (field == BATTERY_TREND) {
+        drawTrend(gfx, r);
+    } else {
+        gfx->setTextColor(TFT_BLACK);
+        gfx->setTextDatum(ML_DATUM);
+        gfx->setTextSize(2);
+        gfx->drawString(_values[field].c_str(), r.x, r.y + r.h / 2);
+    }
+    _dirty[field] = false;
+}
+
+void DiagnosticsScreen::onHeaderFullRedraw(M5GFX* gfx) {
+    gfx->setTextColor(TFT_BLACK);
+    gfx->setTextDatum(ML_DATUM);
+    gfx->setTextSize(2);
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        const FieldLayout& f = FIELDS[i];
+        gfx->drawString(f.label, f.labelX, START_Y + f.row * ROW_HEIGHT + VALUE_H / 2);
+    }
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        drawValue(gfx, static_cast<Field>(i));
+    }
+}
+
+bool DiagnosticsScreen::onDraw(M5GFX* gfx) {
+    bool drew = false;
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        if (_dirty[i]) {
+            drawValue(gfx, static_cast<Field>(i));
+            markRefreshed(valueRect(static_cast<Field>(i)));
+            drew = true;
+        }
+    }
+    return drew;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../../ui/HeaderScreen.hpp"
+#include "../../utils/FixedString.hpp"
+
+// Loop rate, frame timing, refreshes, heap, NVS writes, uptime, battery,
+// stalls and the screens making the most heap allocations.
+// Values are re-read every UPDATE_MS and only the fields whose text changed
+// are redrawn, so the readout costs small partial refreshes.
+class DiagnosticsScreen : public HeaderScreen {
+   public:
+    static constexpr uint32_t UPDATE_MS = 2000;
+
+    DiagnosticsScreen();
+
+    void onEnter() override;
+
+    enum Field : uint8_t {
+        LOOP_RATE,
+        DRAW_TIME,
+        PRESENT_TIME,
+        REFRESHES,
+        NVS_WRITES,
+        HEAP,
+        PSRAM,
+        UPTIME,
+        BATTERY,
+        BATTERY_TREND,
+        STALLS,
+        ALLOCS,
+        FIELD_COUNT
+    };
+
+    // Current text of a field (for tests)
+    const char* value(Field field) const { return _values[field].c_str(); }
+
+   protected:
+    void onUpdate() override;
+    void onHeaderFullRedraw(M5GFX* gfx) override;
+    bool onDraw(M5GFX* gfx) override;
+
+   private:
+    static constexpr size_t VALUE_LEN = 47;
+
+    FixedString<VALUE_LEN> _values[FIELD_COUNT];
+    bool _dirty[FIELD_COUNT] = {false};
+    uint32_t _lastUpdateMs = 0;
+
+    void readValues();
+    static void formatAllocs(char* buf, size_t len);
+    void setValue(Field field, const char* text);
+    void drawValue(M5GFX* gfx, Field field);
+    void drawTrend(M5GFX* gfx, const Rect& r);
+    static Rect valueRect(Field field);
+};
@@ -1,4 +1,4 @@
 #include "HomeApp.hpp"
 
 // Define static constexpr member (required for ODR-use)
-constexpr AppMetadata HomeApp::_metadata;
+constexpr AppMetadata HomeApp::METADATA;
@@ -5,17 +5,17 @@
 
 class HomeApp : public App {
    public:
-    HomeApp() = default;
-
-    const AppMetadata& metadata() const override { return _metadata; }
-    Screen* getMainScreen() override { return &_homeScreen; }
-
-   private:
-    static constexpr AppMetadata _metadata = {
+    static constexpr AppMetadata METADATA = {
         "home", "Home",
         nullptr,  // No icon for home
         false     // Not shown in launcher
     };
 
+    HomeApp() = default;
+
+    const AppMetadata& metadata() const override { return METADATA; }
+    Screen* getMainScreen() override { return &_homeScreen; }
+
+   private:
     HomeScreen _homeScreen;
 };
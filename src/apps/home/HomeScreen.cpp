@@ -40,10 +40,10 @@ void HomeScreen::onFullRedraw(M5GFX* gfx) {
     int appCount = registry.launchableAppCount();
 
     for (int i = 0; i < appCount; i++) {
-        App* app = registry.getLaunchableApp(i);
-        if (app) {
+        const AppMetadata* meta = registry.getLaunchableMetadata(i);
+        if (meta) {
             Rect r = getAppCardRect(i, appCount);
-            drawAppCard(gfx, r, app->metadata().icon, app->metadata().name);
+            drawAppCard(gfx, r, meta->icon, meta->name);
         }
     }
 }
@@ -58,10 +58,10 @@ bool HomeScreen::handleTouch(int16_t x, int16_t y, bool pressed, bool released)
     for (int i = 0; i < appCount; i++) {
         Rect r = getAppCardRect(i, appCount);
         if (r.contains(x, y)) {
-            App* app = registry.getLaunchableApp(i);
-            if (app) {
+            const AppMetadata* meta = registry.getLaunchableMetadata(i);
+            if (meta) {
                 Sound::click();
-                Navigation::instance().launchApp(app);
+                Navigation::instance().launchApp(meta->id);
             }
             return true;
         }
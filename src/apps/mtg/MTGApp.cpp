@@ -3,18 +3,40 @@
 #include <cstring>
 
 // Define static constexpr member (required for ODR-use)
-constexpr AppMetadata MTGApp::_metadata;
+constexpr AppMetadata MTGApp::METADATA;
 
 MTGApp::MTGApp() : _lifeScreen(this), _settingsScreen(this) {}
 
 void MTGApp::onLaunch() {
-    Preferences prefs;
-    _gameState.load(prefs);
+    loadGameState();
 }
 
 void MTGApp::onSuspend() {
     Preferences prefs;
     _gameState.save(prefs);
+    _resumed = false;
+}
+
+void MTGApp::loadGameState() {
+    if (_resumed)
+        return;
+    Preferences prefs;
+    _gameState.load(prefs);
+}
+
+size_t MTGApp::saveResumeState(uint8_t* buf, size_t capacity) const {
+    if (capacity < sizeof(_gameState))
+        return 0;
+    memcpy(buf, &_gameState, sizeof(_gameState));
+    return sizeof(_gameState);
+}
+
+bool MTGApp::restoreResumeState(const uint8_t* buf, size_t len) {
+    if (len != sizeof(_gameState))
+        return false;
+    memcpy(&_gameState, buf, sizeof(_gameState));
+    _resumed = true;
+    return true;
 }
 
 Screen* MTGApp::getScreen(const char* id) {
@@ -8,12 +8,19 @@
 
 class MTGApp : public App {
    public:
+    static constexpr AppMetadata METADATA = {
+        "mtg", "MTG Life", ICON_MTG,
+        true  // Show in launcher
+    };
+
     MTGApp();
 
-    const AppMetadata& metadata() const override { return _metadata; }
+    const AppMetadata& metadata() const override { return METADATA; }
 
     void onLaunch() override;
     void onSuspend() override;
+    size_t saveResumeState(uint8_t* buf, size_t capacity) const override;
+    bool restoreResumeState(const uint8_t* buf, size_t len) override;
 
     Screen* getMainScreen() override { return &_lifeScreen; }
     Screen* getScreen(const char* id) override;
@@ -21,16 +28,15 @@ class MTGApp : public App {
     // State access for screens
     GameState& gameState() { return _gameState; }
 
+    // Load from NVS, unless RAM already holds state restored from deep sleep
+    void loadGameState();
+
     // Screen access
     MTGSettingsScreen* settingsScreen() { return &_settingsScreen; }
 
    private:
-    static constexpr AppMetadata _metadata = {
-        "mtg", "MTG Life", ICON_MTG,
-        true  // Show in launcher
-    };
-
     GameState _gameState;
+    bool _resumed = false;  // State came from RTC memory; NVS may be stale until suspend
     MTGLifeScreen _lifeScreen;
     MTGSettingsScreen _settingsScreen;
 };
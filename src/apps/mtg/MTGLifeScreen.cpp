@@ -16,8 +16,7 @@ GameState& MTGLifeScreen::gameState() {
 
 void MTGLifeScreen::onEnter() {
     // Load state from NVS
-    Preferences prefs;
-    gameState().load(prefs);
+    _app->loadGameState();
 
     // Set up navigation buttons
     setLeftButton("< HOME", []() { Navigation::instance().goHome(); });
@@ -28,12 +27,18 @@ void MTGLifeScreen::onEnter() {
     setNeedsFullRedraw(true);
 }
 
+MTGLifeScreen::~MTGLifeScreen() {
+    destroyPlayerCards();
+    delete _keyboard;
+}
+
 void MTGLifeScreen::onExit() {
+    releaseCardTouches();
+
     // Save state to NVS
     Preferences prefs;
     gameState().save(prefs);
 
-    destroyPlayerCards();
     if (_keyboard) {
         delete _keyboard;
         _keyboard = nullptr;
@@ -41,12 +46,16 @@ void MTGLifeScreen::onExit() {
 }
 
 void MTGLifeScreen::createPlayerCards() {
-    destroyPlayerCards();
-
-    for (int i = 0; i < gameState().playerCount; i++) {
+    // One card per possible player, created on the first visit and kept, so
+    // later visits (and player count changes) allocate nothing
+    for (int i = 0; i < GameState::MAX_PLAYERS; i++) {
         int idx = i;  // Capture for lambda
-        _playerCards[i] =
-            new PlayerCard(&gameState().players[i], [this, idx]() { showKeyboard(idx); });
+        if (!_playerCards[i]) {
+            _playerCards[i] =
+                new PlayerCard(&gameState().players[i], [this, idx]() { showKeyboard(idx); });
+        } else {
+            _playerCards[i]->setPlayer(&gameState().players[i]);
+        }
     }
     layoutPlayerCards();
 }
@@ -69,7 +78,7 @@ void MTGLifeScreen::layoutPlayerCards() {
     }
 }
 
-Rect MTGLifeScreen::getPlayerCardRect(int index, int playerCount) const {
+Rect MTGLifeScreen::getPlayerCardRect(int index, int playerCount) {
     int16_t startY = Layout::headerContentY() + Layout::MARGIN_S;
     int16_t availableH = Layout::headerContentH() - Layout::MARGIN_S * 2;
     int16_t availableW = Layout::screenW() - Layout::MARGIN_M;
@@ -146,7 +155,7 @@ void MTGLifeScreen::onHeaderFullRedraw(M5GFX* gfx) {
         }
     }
     if (_keyboard) {
-        _keyboard->setDirty(true);
+        _keyboard->invalidate();
         _keyboard->draw(gfx);
     }
 }
@@ -158,6 +167,7 @@ bool MTGLifeScreen::onDraw(M5GFX* gfx) {
     for (int i = 0; i < gameState().playerCount; i++) {
         if (_playerCards[i] && _playerCards[i]->isDirty()) {
             _playerCards[i]->draw(gfx);
+            markRefreshed(_playerCards[i]->getBounds());
             needsDisplay = true;
         }
     }
@@ -165,25 +175,73 @@ bool MTGLifeScreen::onDraw(M5GFX* gfx) {
     // Draw keyboard overlay if active (only if dirty)
     if (_keyboard && _keyboard->isDirty()) {
         _keyboard->draw(gfx);
+        markRefreshed(_keyboard->drawnArea());
         needsDisplay = true;
     }
 
     return needsDisplay;
 }
 
-bool MTGLifeScreen::onTouch(int16_t x, int16_t y, bool pressed, bool released) {
-    // Keyboard has priority when visible
-    if (_keyboard) {
-        return _keyboard->handleTouch(x, y, pressed, released);
+bool MTGLifeScreen::handleTouchPoint(const TouchPoint& point) {
+    if (!_keyboard) {
+        int card = cardForTouch(point);
+        if (card == CARD_TAKEN) {
+            return true;  // A second finger on a card already in use
+        }
+        if (card >= 0) {
+            bool consumed =
+                _playerCards[card]->handleTouch(point.x, point.y, point.pressed, point.released);
+            if (point.released) {
+                _cardTouch[card] = -1;
+            }
+            return consumed;
+        }
     }
 
-    // Check player cards
-    for (int i = 0; i < gameState().playerCount; i++) {
-        if (_playerCards[i] && _playerCards[i]->handleTouch(x, y, pressed, released)) {
-            return true;
+    // Every finger types, so a key struck while another is still down is
+    // kept; the header stays single-touch
+    if (_keyboard && _keyboard->contains(point.x, point.y)) {
+        return _keyboard->handleTouch(point.x, point.y, point.pressed, point.released);
+    }
+    return HeaderScreen::handleTouchPoint(point);
+}
+
+// The card a point drives: the one it claimed, which keeps it until the
+// finger lifts (a drag may leave the card), or the free card under it
+int MTGLifeScreen::cardForTouch(const TouchPoint& point) {
+    int count = gameState().playerCount;
+    for (int i = 0; i < count; i++) {
+        if (_cardTouch[i] == point.id) {
+            return i;
         }
     }
+    for (int i = 0; i < count; i++) {
+        if (_playerCards[i] && _playerCards[i]->getBounds().contains(point.x, point.y)) {
+            if (_cardTouch[i] >= 0) {
+                return CARD_TAKEN;
+            }
+            _cardTouch[i] = static_cast<int8_t>(point.id);
+            return i;
+        }
+    }
+    return -1;
+}
 
+// Drops every finger's claim, abandoning any drag or hold in progress
+void MTGLifeScreen::releaseCardTouches() {
+    for (int i = 0; i < GameState::MAX_PLAYERS; i++) {
+        if (_cardTouch[i] >= 0 && _playerCards[i]) {
+            _playerCards[i]->cancelTouch();
+        }
+        _cardTouch[i] = -1;
+    }
+}
+
+bool MTGLifeScreen::onTouch(int16_t x, int16_t y, bool pressed, bool released) {
+    // Player cards are routed per point in handleTouchPoint()
+    if (_keyboard) {
+        return _keyboard->handleTouch(x, y, pressed, released);
+    }
     return false;
 }
 
@@ -191,12 +249,11 @@ void MTGLifeScreen::showKeyboard(int playerIndex) {
     if (_keyboard) {
         delete _keyboard;
     }
+    releaseCardTouches();
     _editingPlayerIndex = playerIndex;
     _keyboard = new Keyboard(gameState().players[playerIndex].name,
                              [this](const char* result, bool confirmed) {
-                                 // Save index before hideKeyboard clears it
                                  int idx = _editingPlayerIndex;
-                                 hideKeyboard(confirmed);
                                  if (confirmed && idx >= 0) {
                                      gameState().players[idx].setName(result);
                                      // Mark player card dirty to show updated name
@@ -206,6 +263,9 @@ void MTGLifeScreen::showKeyboard(int playerIndex) {
                                      Preferences prefs;
                                      gameState().save(prefs);
                                  }
+                                 // Last: this deletes the keyboard, which owns result
+                                 // and this callback
+                                 hideKeyboard(confirmed);
                              });
     setNeedsFullRedraw(true);
 }
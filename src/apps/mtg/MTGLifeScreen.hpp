@@ -10,10 +10,22 @@ class GameState;
 class MTGLifeScreen : public HeaderScreen {
    public:
     explicit MTGLifeScreen(MTGApp* app);
+    ~MTGLifeScreen();
 
     void onEnter() override;
     void onExit() override;
 
+    // Each finger on a player card drives that card, so players can change
+    // their own life at the same time
+    bool handleTouchPoint(const TouchPoint& point) override;
+
+    // Up to six PlayerCards plus the name keyboard
+    MemoryBudget memoryBudget() const override { return {2048, 0}; }
+
+    static Rect getPlayerCardRect(int index, int playerCount);
+
+    static constexpr uint32_t SAVE_INTERVAL_MS = 5000;  // Autosave period
+
    protected:
     void onUpdate() override;
     void onHeaderFullRedraw(M5GFX* gfx) override;
@@ -21,20 +33,23 @@ class MTGLifeScreen : public HeaderScreen {
     bool onTouch(int16_t x, int16_t y, bool pressed, bool released) override;
 
    private:
+    static constexpr int CARD_TAKEN = -2;
+
     MTGApp* _app;
     PlayerCard* _playerCards[6] = {nullptr};  // MAX_PLAYERS = 6
+    int8_t _cardTouch[6] = {-1, -1, -1, -1, -1, -1};  // Point id driving each card
     Keyboard* _keyboard = nullptr;
     int8_t _editingPlayerIndex = -1;
 
     uint32_t _lastSaveTime = 0;
-    static constexpr uint32_t SAVE_INTERVAL_MS = 5000;
 
     GameState& gameState();  // Helper to access via App
 
     void createPlayerCards();
     void destroyPlayerCards();
     void layoutPlayerCards();
-    Rect getPlayerCardRect(int index, int playerCount) const;
+    int cardForTouch(const TouchPoint& point);
+    void releaseCardTouches();
 
     void showKeyboard(int playerIndex);
     void hideKeyboard(bool confirmed);
@@ -3,6 +3,7 @@
 #include <Preferences.h>
 #include "../../app/Navigation.hpp"
 #include "../../ui/Layout.hpp"
+#include "../../utils/Energy.hpp"
 #include "../../utils/Sound.hpp"
 #include "MTGApp.hpp"
 
@@ -37,25 +38,27 @@ GameState& MTGSettingsScreen::gameState() {
 
 void MTGSettingsScreen::onEnter() {
     // State is shared via App, but reload from NVS to be safe
-    Preferences prefs;
-    gameState().load(prefs);
+    _app->loadGameState();
 
     // Set up back button - pops back to the life screen
     setLeftButton("< BACK", []() { Navigation::instance().popScreen(); });
 
-    createButtons();
+    // Created on the first visit and kept, so later visits allocate nothing
+    if (!_resetLifeButton) {
+        createButtons();
+    }
+    updatePlayerButtonStates();
+    updateLifeButtonStates();
     setNeedsFullRedraw(true);
 }
 
 void MTGSettingsScreen::onExit() {
     Preferences prefs;
     gameState().save(prefs);
-    destroyButtons();
+    _showingConfirm = false;
 }
 
 void MTGSettingsScreen::createButtons() {
-    destroyButtons();
-
     // Left column, Section 1: Player count buttons (2-6)
     const int16_t playerSectionY = CONTENT_Y;
     const int16_t playerBtnY = playerSectionY + SECTION_HEADER_H + 12;
@@ -124,9 +127,6 @@ void MTGSettingsScreen::createButtons() {
         Sound::click();
         onConfirmAction();
     });
-
-    updatePlayerButtonStates();
-    updateLifeButtonStates();
 }
 
 void MTGSettingsScreen::destroyButtons() {
@@ -207,6 +207,7 @@ void MTGSettingsScreen::onConfirmAction() {
     if (_confirmIsNewGame) {
         // Reset everything to defaults
         gameState().reset();
+        Energy::startGame();
     } else {
         // Just reset life totals
         gameState().resetLifeTotals();
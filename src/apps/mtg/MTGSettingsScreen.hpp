@@ -12,6 +12,8 @@ class MTGSettingsScreen : public HeaderScreen {
     ~MTGSettingsScreen();
 
     const char* screenId() const override { return "settings"; }
+    // Thirteen Buttons, created on the first visit
+    MemoryBudget memoryBudget() const override { return {2048, 0}; }
 
     void onEnter() override;
     void onExit() override;
@@ -1,22 +1,22 @@
 #include "SettingsApp.hpp"
 #include <Preferences.h>
 #include <cstring>
+#include "../../ui/PlayerCard.hpp"
 #include "../../utils/Sound.hpp"
 
 // Define static constexpr member (required for ODR-use)
-constexpr AppMetadata SettingsApp::_metadata;
+constexpr AppMetadata SettingsApp::METADATA;
 
 SettingsApp::SettingsApp() : _systemScreen(this), _wifiScreen(this) {}
 
 void SettingsApp::onLaunch() {
-    Preferences prefs;
-    _settings.load(prefs);
-    Sound::setEnabled(_settings.soundEnabled);
+    Sound::setEnabled(settings().soundEnabled);
+    PlayerCard::setCommitOnPress(settings().lifeOnTouchDown);
 }
 
 void SettingsApp::onSuspend() {
     Preferences prefs;
-    _settings.save(prefs);
+    settings().save(prefs);
 }
 
 Screen* SettingsApp::getScreen(const char* id) {
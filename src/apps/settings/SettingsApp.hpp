@@ -8,9 +8,14 @@
 
 class SettingsApp : public App {
    public:
+    static constexpr AppMetadata METADATA = {
+        "settings", "Settings", ICON_SETTINGS,
+        true  // Show in launcher
+    };
+
     SettingsApp();
 
-    const AppMetadata& metadata() const override { return _metadata; }
+    const AppMetadata& metadata() const override { return METADATA; }
 
     void onLaunch() override;
     void onSuspend() override;
@@ -18,19 +23,13 @@ class SettingsApp : public App {
     Screen* getMainScreen() override { return &_systemScreen; }
     Screen* getScreen(const char* id) override;
 
-    // State access for screens
-    Settings& settings() { return _settings; }
+    // State access for screens; the live settings the rest of the system runs on
+    Settings& settings() { return globalSettings; }
 
     // Screen access
     WiFiScreen* wifiScreen() { return &_wifiScreen; }
 
    private:
-    static constexpr AppMetadata _metadata = {
-        "settings", "Settings", ICON_SETTINGS,
-        true  // Show in launcher
-    };
-
-    Settings _settings;
     SystemSettingsScreen _systemScreen;
     WiFiScreen _wifiScreen;
 };
@@ -1,13 +1,20 @@
 #include "SystemSettingsScreen.hpp"
 #include <Preferences.h>
+#include "../../app/AppRegistry.hpp"
 #include "../../app/Navigation.hpp"
 #include "../../ui/Layout.hpp"
+#include "../../ui/PlayerCard.hpp"
+#include "../../utils/Energy.hpp"
+#include "../../utils/Power.hpp"
 #include "../../utils/Sound.hpp"
+#include "../diagnostics/DiagnosticsApp.hpp"
 #include "SettingsApp.hpp"
 
 static const char* BOOL_OPTIONS[] = {"OFF", "ON"};
 static const char* SLEEP_OPTIONS[] = {"OFF", "1m", "5m", "10m"};
 static const uint16_t SLEEP_VALUES[] = {0, 60, 300, 600};
+static const char* PROFILE_OPTIONS[] = {"PERF", "BAL", "SAVER"};
+static const char* LIFE_TAP_OPTIONS[] = {"RELEASE", "PRESS"};
 
 SystemSettingsScreen::SystemSettingsScreen(SettingsApp* app)
     : HeaderScreen("SYSTEM SETTINGS"), _app(app) {}
@@ -22,9 +29,6 @@ void SystemSettingsScreen::saveSettings() {
 }
 
 void SystemSettingsScreen::onEnter() {
-    // Load settings from NVS
-    Preferences prefs;
-    settings().load(prefs);
     Sound::setEnabled(settings().soundEnabled);
 
     // Set up navigation buttons
@@ -55,6 +59,18 @@ int SystemSettingsScreen::getAutoConnectIndex() const {
     return _app->settings().wifiAutoConnect ? 1 : 0;
 }
 
+int SystemSettingsScreen::getProfileIndex() const {
+    return static_cast<int>(_app->settings().powerProfile);
+}
+
+int SystemSettingsScreen::getDiagnosticsIndex() const {
+    return _app->settings().showDiagnostics ? 1 : 0;
+}
+
+int SystemSettingsScreen::getLifeTapIndex() const {
+    return _app->settings().lifeOnTouchDown ? 1 : 0;
+}
+
 Rect SystemSettingsScreen::getButtonRect(int row, int buttonIndex) const {
     int16_t y = Toolbar::HEIGHT + HeaderBar::HEIGHT + 40 + row * ROW_HEIGHT;
     int16_t x = BUTTONS_X + buttonIndex * (BUTTON_W + 10);
@@ -121,6 +137,38 @@ void SystemSettingsScreen::onHeaderFullRedraw(M5GFX* gfx) {
 
     // Row 2: Auto-Sleep
     drawRow(gfx, startY + ROW_HEIGHT * 2, "Auto-Sleep:", SLEEP_OPTIONS, 4, getSleepIndex());
+
+    // Row 3: Power profile, with a note while low battery forces Saver
+    drawRow(gfx, startY + ROW_HEIGHT * 3, "Power:", PROFILE_OPTIONS, PowerProfiles::COUNT,
+            getProfileIndex());
+    if (Power::autoSaverActive()) {
+        gfx->setTextColor(TFT_BLACK);
+        gfx->setTextDatum(ML_DATUM);
+        gfx->setTextSize(1);
+        gfx->drawString("Low battery: SAVER active",
+                        BUTTONS_X + PowerProfiles::COUNT * (BUTTON_W + 10) + 10,
+                        startY + ROW_HEIGHT * 3 + BUTTON_H / 2);
+    }
+
+    // Row 4: Diagnostics app on the launcher
+    drawRow(gfx, startY + ROW_HEIGHT * 4, "Diagnostics:", BOOL_OPTIONS, 2, getDiagnosticsIndex());
+
+    // Row 5: When life buttons act
+    drawRow(gfx, startY + ROW_HEIGHT * 5, "Life tap on:", LIFE_TAP_OPTIONS, 2, getLifeTapIndex());
+
+    // Estimated energy use since boot and since the last new game
+    Energy::update();
+    char line[96];
+    char summary[80];
+    gfx->setTextColor(TFT_BLACK);
+    gfx->setTextDatum(ML_DATUM);
+    gfx->setTextSize(1);
+    Energy::format(Energy::ledger().boot(), summary, sizeof(summary));
+    snprintf(line, sizeof(line), "Energy (boot): %s", summary);
+    gfx->drawString(line, LABEL_X, startY + ROW_HEIGHT * 6 + 10);
+    Energy::format(Energy::ledger().game(), summary, sizeof(summary));
+    snprintf(line, sizeof(line), "Energy (game): %s", summary);
+    gfx->drawString(line, LABEL_X, startY + ROW_HEIGHT * 6 + 40);
 }
 
 bool SystemSettingsScreen::onTouch(int16_t x, int16_t y, bool pressed, bool released) {
@@ -181,5 +229,53 @@ bool SystemSettingsScreen::onTouch(int16_t x, int16_t y, bool pressed, bool rele
         }
     }
 
+    // Check power profile buttons (row 3)
+    for (int i = 0; i < PowerProfiles::COUNT; i++) {
+        Rect r = getButtonRect(3, i);
+        if (r.contains(x, y)) {
+            PowerProfile newValue = static_cast<PowerProfile>(i);
+            if (settings().powerProfile != newValue) {
+                settings().powerProfile = newValue;
+                Power::setProfile(newValue);
+                saveSettings();
+                Sound::click();
+                setNeedsFullRedraw(true);
+            }
+            return true;
+        }
+    }
+
+    // Check diagnostics buttons (row 4)
+    for (int i = 0; i < 2; i++) {
+        Rect r = getButtonRect(4, i);
+        if (r.contains(x, y)) {
+            bool newValue = (i == 1);
+            if (settings().showDiagnostics != newValue) {
+                settings().showDiagnostics = newValue;
+                AppRegistry::instance().setHidden(DiagnosticsApp::METADATA.id, !newValue);
+                saveSettings();
+                Sound::click();
+                setNeedsFullRedraw(true);
+            }
+            return true;
+        }
+    }
+
+    // Check life tap buttons (row 5)
+    for (int i = 0; i < 2; i++) {
+        Rect r = getButtonRect(5, i);
+        if (r.contains(x, y)) {
+            bool newValue = (i == 1);
+            if (settings().lifeOnTouchDown != newValue) {
+                settings().lifeOnTouchDown = newValue;
+                PlayerCard::setCommitOnPress(newValue);
+                saveSettings();
+                Sound::click();
+                setNeedsFullRedraw(true);
+            }
+            return true;
+        }
+    }
+
     return false;
 }
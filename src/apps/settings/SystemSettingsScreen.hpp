@@ -38,5 +38,8 @@ class SystemSettingsScreen : public HeaderScreen {
     int getSoundIndex() const;
     int getSleepIndex() const;
     int getAutoConnectIndex() const;
+    int getProfileIndex() const;
+    int getDiagnosticsIndex() const;
+    int getLifeTapIndex() const;
     Rect getButtonRect(int row, int buttonIndex) const;
 };
@@ -3,18 +3,34 @@
 #include <Preferences.h>
 #include <algorithm>
 #include "../../app/Navigation.hpp"
+#include "../../utils/Energy.hpp"
 #include "../../utils/Log.hpp"
+#include "../../utils/Memory.hpp"
+#include "../../utils/Metrics.hpp"
+#include "../../utils/Power.hpp"
 #include "../../utils/Sound.hpp"
+#include "../../utils/Trace.hpp"
 #include "SettingsApp.hpp"
 
 static constexpr const char* WIFI_PREF_NS = "wifi";
 static constexpr const char* PREF_SSID = "ssid";
 static constexpr const char* PREF_PASS = "pass";
 
+// Stands in for the scan results when they could not be allocated
+static const WiFiNetworkList NO_NETWORKS;
+
 WiFiScreen::WiFiScreen(SettingsApp* app) : HeaderScreen("SELECT WIFI NETWORK"), _app(app) {}
 
 void WiFiScreen::onEnter() {
-    _networks.clear();
+    // Scan results are cold (rebuilt per scan, read only on redraw) - keep them in PSRAM
+    if (!_networks) {
+        _networks = Memory::create<WiFiNetworkList>(Memory::Region::Psram);
+    }
+    if (_networks) {
+        _networks->clear();
+    } else {
+        LOG_E("[WiFi] No memory for scan results, scanning disabled");
+    }
     _scrollOffset = 0;
     _selectedIndex = -1;
     _scanning = false;
@@ -39,6 +55,12 @@ void WiFiScreen::onExit() {
         delete _keyboard;
         _keyboard = nullptr;
     }
+    Memory::destroy(_networks);
+    _networks = nullptr;
+}
+
+const WiFiNetworkList& WiFiScreen::networks() const {
+    return _networks ? *_networks : NO_NETWORKS;
 }
 
 void WiFiScreen::startScan(bool showSplash) {
@@ -46,6 +68,10 @@ void WiFiScreen::startScan(bool showSplash) {
         LOG_D("[WiFi] Scan skipped - already busy");
         return;
     }
+    if (!_networks) {
+        LOG_E("[WiFi] Scan skipped - no memory for results");
+        return;
+    }
 
     LOG_D("[WiFi] Starting scan...");
     _scanning = true;
@@ -66,11 +92,15 @@ void WiFiScreen::startScan(bool showSplash) {
     delay(100);
 
     // Use synchronous scan for reliability
-    int16_t result = WiFi.scanNetworks(false, true);  // sync, show hidden
+    int16_t result;
+    {
+        TRACE_SCOPE("wifi.scan");
+        result = WiFi.scanNetworks(false, true);  // sync, show hidden
+    }
     LOG_D("[WiFi] Scan complete, found %d networks", result);
 
     _scanning = false;
-    _networks.clear();
+    _networks->clear();
 
     if (result < 0) {
         LOG_D("[WiFi] Scan failed with error: %d", result);
@@ -78,36 +108,32 @@ void WiFiScreen::startScan(bool showSplash) {
         return;
     }
 
-    String currentSSID = WiFi.SSID();
+    bool isConnected = (WiFi.status() == WL_CONNECTED);
+    WiFiSsid currentSSID;
+    if (isConnected) {
+        currentSSID = WiFi.SSID().c_str();
+    }
     LOG_D("[WiFi] Currently connected to: '%s'", currentSSID.c_str());
 
+    // Results are ranked on insert (connected first, then strongest) and capped at
+    // WIFI_MAX_NETWORKS, so a dense environment cannot grow the list
     for (int i = 0; i < result; i++) {
         WiFiNetwork net;
-        net.ssid = WiFi.SSID(i);
+        net.ssid = WiFi.SSID(i).c_str();
         net.rssi = WiFi.RSSI(i);
         net.secured = (WiFi.encryptionType(i) != WIFI_AUTH_OPEN);
-        net.connected = (net.ssid == currentSSID && WiFi.status() == WL_CONNECTED);
+        net.connected = (isConnected && net.ssid == currentSSID);
 
         LOG_D("[WiFi]   %d: '%s' (%d dBm) %s %s", i, net.ssid.c_str(), net.rssi,
               net.secured ? "[secured]" : "[open]", net.connected ? "[connected]" : "");
 
-        // Skip empty SSIDs
-        if (net.ssid.length() > 0) {
-            _networks.push_back(net);
-        }
+        _networks->insertRanked(net);
     }
 
-    // Sort by signal strength (strongest first), but connected network always first
-    std::sort(_networks.begin(), _networks.end(), [](const WiFiNetwork& a, const WiFiNetwork& b) {
-        if (a.connected != b.connected)
-            return a.connected;
-        return a.rssi > b.rssi;
-    });
-
     WiFi.scanDelete();
     updateDisconnectButton();
     setNeedsFullRedraw(true);
-    LOG_D("[WiFi] Final network count: %d", (int)_networks.size());
+    LOG_D("[WiFi] Final network count: %d", (int)networks().size());
 }
 
 void WiFiScreen::updateScanResults() {
@@ -134,10 +160,12 @@ void WiFiScreen::drawScanningSplash() {
     gfx->setTextSize(2);
     gfx->drawString("SCANNING...", boxX + boxW / 2, boxY + boxH / 2);
 
+    TRACE_SCOPE("display");
     gfx->display();
+    Energy::onRefresh(static_cast<uint32_t>(boxW) * boxH);
 }
 
-void WiFiScreen::drawConnectingSplash(const String& ssid) {
+void WiFiScreen::drawConnectingSplash(const char* ssid) {
     M5GFX* gfx = &M5.Display;
 
     // Modal dimensions
@@ -159,40 +187,55 @@ void WiFiScreen::drawConnectingSplash(const String& ssid) {
 
     // Network name
     gfx->setTextSize(1);
-    gfx->drawString(ssid.c_str(), boxX + boxW / 2, boxY + 75);
+    gfx->drawString(ssid, boxX + boxW / 2, boxY + 75);
 
+    TRACE_SCOPE("display");
     gfx->display();
+    Energy::onRefresh(static_cast<uint32_t>(boxW) * boxH);
 }
 
-void WiFiScreen::connectToNetwork(const String& ssid, const String& password) {
+void WiFiScreen::connectToNetwork(const char* ssid, const char* password) {
     _connecting = true;
 
     // Show connecting splash immediately (before blocking)
     drawConnectingSplash(ssid);
 
-    WiFi.begin(ssid.c_str(), password.c_str());
+    {
+        TRACE_SCOPE("wifi.connect");
+        WiFi.begin(ssid, password);
 
-    // Wait for connection (with timeout)
-    unsigned long start = millis();
-    while (WiFi.status() != WL_CONNECTED && millis() - start < 10000) {
-        delay(100);
+        // Wait for connection (with timeout)
+        unsigned long start = millis();
+        while (WiFi.status() != WL_CONNECTED && millis() - start < 10000) {
+            delay(100);
+        }
     }
 
     if (WiFi.status() == WL_CONNECTED) {
+        Power::applyWifiPowerSave();
+
         // Save credentials
+        TRACE_SCOPE_ARG("nvs.save", WIFI_PREF_NS);
         Preferences prefs;
         prefs.begin(WIFI_PREF_NS, false);
         prefs.putString(PREF_SSID, ssid);
         prefs.putString(PREF_PASS, password);
         prefs.end();
+        Metrics::onNvsWrite();
     }
 
     _connecting = false;
 
     // Update the connected status in our cached network list
-    String connectedSSID = WiFi.SSID();
-    for (auto& net : _networks) {
-        net.connected = (net.ssid == connectedSSID && WiFi.status() == WL_CONNECTED);
+    bool isConnected = (WiFi.status() == WL_CONNECTED);
+    WiFiSsid connectedSSID;
+    if (isConnected) {
+        connectedSSID = WiFi.SSID().c_str();
+    }
+    if (_networks) {
+        for (auto& net : *_networks) {
+            net.connected = (isConnected && net.ssid == connectedSSID);
+        }
     }
 
     updateDisconnectButton();
@@ -209,10 +252,13 @@ void WiFiScreen::disconnectFromNetwork() {
     prefs.remove(PREF_SSID);
     prefs.remove(PREF_PASS);
     prefs.end();
+    Metrics::onNvsWrite();
 
     // Update the connected status in our cached network list
-    for (auto& net : _networks) {
-        net.connected = false;
+    if (_networks) {
+        for (auto& net : *_networks) {
+            net.connected = false;
+        }
     }
 
     updateDisconnectButton();
@@ -237,7 +283,7 @@ void WiFiScreen::onUpdate() {
 void WiFiScreen::onHeaderFullRedraw(M5GFX* gfx) {
     drawNetworkList(gfx);
     if (_keyboard) {
-        _keyboard->setDirty(true);
+        _keyboard->invalidate();
         _keyboard->draw(gfx);
     }
 }
@@ -248,6 +294,7 @@ bool WiFiScreen::onDraw(M5GFX* gfx) {
     // Draw keyboard overlay if active
     if (_keyboard && _keyboard->isDirty()) {
         _keyboard->draw(gfx);
+        markRefreshed(_keyboard->drawnArea());
         needsDisplay = true;
     }
 
@@ -266,19 +313,21 @@ void WiFiScreen::drawNetworkList(M5GFX* gfx) {
         gfx->drawString("-- Scanning for networks... --", Layout::centerX(), y - 25);
     } else if (_connecting) {
         gfx->drawString("-- Connecting... --", Layout::centerX(), y - 25);
-    } else if (_networks.empty()) {
+    } else if (!_networks) {
+        gfx->drawString("-- Out of memory --", Layout::centerX(), y - 25);
+    } else if (networks().empty()) {
         gfx->drawString("-- No networks found --", Layout::centerX(), y - 25);
     } else {
         char header[40];
-        snprintf(header, sizeof(header), "-- Available Networks (%d) --", (int)_networks.size());
+        snprintf(header, sizeof(header), "-- Available Networks (%d) --", (int)networks().size());
         gfx->drawString(header, Layout::centerX(), y - 25);
     }
 
     // Draw visible networks
-    int endIdx = std::min(_scrollOffset + MAX_VISIBLE_NETWORKS, (int)_networks.size());
+    int endIdx = std::min(_scrollOffset + MAX_VISIBLE_NETWORKS, (int)networks().size());
     for (int i = _scrollOffset; i < endIdx; i++) {
         int16_t rowY = y + (i - _scrollOffset) * ROW_HEIGHT;
-        drawNetwork(gfx, rowY, _networks[i], i == _selectedIndex);
+        drawNetwork(gfx, rowY, networks()[i], i == _selectedIndex);
     }
 }
 
@@ -339,16 +388,18 @@ Rect WiFiScreen::getNetworkRect(int index) const {
     return Rect(ROW_PADDING, y, Layout::screenW() - ROW_PADDING * 2, ROW_HEIGHT - 4);
 }
 
-void WiFiScreen::onKeyboardComplete(const char* password, bool confirmed) {
+void WiFiScreen::onKeyboardComplete(const char* result, bool confirmed) {
+    // result points into the keyboard, which is deleted below
+    WiFiPassword password = result;
     if (_keyboard) {
         delete _keyboard;
         _keyboard = nullptr;
     }
 
-    if (confirmed && !_pendingSSID.isEmpty()) {
-        connectToNetwork(_pendingSSID, password);
+    if (confirmed && !_pendingSSID.empty()) {
+        connectToNetwork(_pendingSSID.c_str(), password.c_str());
     }
-    _pendingSSID = "";
+    _pendingSSID.clear();
     setNeedsFullRedraw(true);
 }
 
@@ -371,11 +422,11 @@ bool WiFiScreen::onTouch(int16_t x, int16_t y, bool pressed, bool released) {
 
     // Check network selection
     for (int i = _scrollOffset;
-         i < _scrollOffset + MAX_VISIBLE_NETWORKS && i < (int)_networks.size(); i++) {
+         i < _scrollOffset + MAX_VISIBLE_NETWORKS && i < (int)networks().size(); i++) {
         Rect r = getNetworkRect(i);
         if (r.contains(x, y)) {
             Sound::click();
-            const WiFiNetwork& net = _networks[i];
+            const WiFiNetwork& net = networks()[i];
 
             if (net.connected) {
                 // Tapping connected network disconnects
@@ -390,7 +441,7 @@ bool WiFiScreen::onTouch(int16_t x, int16_t y, bool pressed, bool released) {
                 setNeedsFullRedraw(true);
             } else {
                 // Open network, connect directly
-                connectToNetwork(net.ssid, "");
+                connectToNetwork(net.ssid.c_str(), "");
             }
             return true;
         }
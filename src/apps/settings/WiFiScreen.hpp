@@ -1,29 +1,26 @@
 #pragma once
 
 #include <WiFi.h>
-#include <vector>
+#include "../../models/WiFiNetwork.hpp"
 #include "../../ui/HeaderScreen.hpp"
 #include "../../ui/Keyboard.hpp"
 #include "../../ui/Layout.hpp"
 
 class SettingsApp;
 
-struct WiFiNetwork {
-    String ssid;
-    int32_t rssi;
-    bool secured;
-    bool connected;
-};
-
 class WiFiScreen : public HeaderScreen {
    public:
     explicit WiFiScreen(SettingsApp* app);
 
     const char* screenId() const override { return "wifi"; }
+    MemoryBudget memoryBudget() const override { return {1024, 1024}; }
 
     void onEnter() override;
     void onExit() override;
 
+    // Scan results, or an empty list when they could not be allocated
+    const WiFiNetworkList& networks() const;
+
    protected:
     void onUpdate() override;
     void onHeaderFullRedraw(M5GFX* gfx) override;
@@ -39,25 +36,26 @@ class WiFiScreen : public HeaderScreen {
     SettingsApp* _app;
     Keyboard* _keyboard = nullptr;
 
-    std::vector<WiFiNetwork> _networks;
+    // PSRAM, allocated while the screen is active; null if neither heap had room
+    WiFiNetworkList* _networks = nullptr;
     int _scrollOffset = 0;
     int _selectedIndex = -1;
     bool _scanning = false;
     bool _connecting = false;
     unsigned long _lastScanTime = 0;
-    String _pendingSSID;
+    WiFiSsid _pendingSSID;
 
     void startScan(bool showSplash = true);
     void updateScanResults();
-    void connectToNetwork(const String& ssid, const String& password);
+    void connectToNetwork(const char* ssid, const char* password);
     void disconnectFromNetwork();
     void updateDisconnectButton();
     void drawNetworkList(M5GFX* gfx);
     void drawNetwork(M5GFX* gfx, int16_t y, const WiFiNetwork& network, bool selected);
-    void drawConnectingSplash(const String& ssid);
+    void drawConnectingSplash(const char* ssid);
     void drawScanningSplash();
     const char* getSignalBars(int32_t rssi);
-    void onKeyboardComplete(const char* password, bool confirmed);
+    void onKeyboardComplete(const char* result, bool confirmed);
 
     Rect getNetworkRect(int index) const;
 };
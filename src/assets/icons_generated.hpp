@@ -6,6 +6,42 @@
 
 inline constexpr int16_t GENERATED_ICON_SIZE = 64;
 
+// DIAGNOSTICS icon (64x64, 1-bit)
+inline constexpr uint8_t ICON_DIAGNOSTICS[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x1C, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xFC, 0x7F, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x0F, 0xFC, 0x7F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xFC, 0x7F, 0xFC, 0x00, 0x00,
+    0x00, 0x00, 0x7F, 0xFC, 0x7F, 0xFF, 0x00, 0x00, 0x00, 0x01, 0xFF, 0xFC, 0x7F, 0xFF, 0x80, 0x00,
+    0x00, 0x03, 0xFF, 0xFC, 0x7F, 0xFF, 0xC0, 0x00, 0x00, 0x07, 0xFF, 0xFC, 0x7F, 0xFF, 0xE0, 0x00,
+    0x00, 0x03, 0xFF, 0xFC, 0x7F, 0xFF, 0xC0, 0x00, 0x00, 0x01, 0xFF, 0xF0, 0x07, 0xFF, 0x80, 0x00,
+    0x00, 0x20, 0xFF, 0x00, 0x00, 0xFF, 0x04, 0x00, 0x00, 0x70, 0x7C, 0x00, 0x00, 0x3E, 0x0E, 0x00,
+    0x00, 0xF8, 0x38, 0x00, 0x00, 0x1C, 0x1F, 0x00, 0x00, 0xFC, 0x10, 0x00, 0x02, 0x00, 0x3F, 0x80,
+    0x01, 0xFE, 0x00, 0x00, 0x03, 0x80, 0x7F, 0x80, 0x03, 0xFF, 0x00, 0x00, 0x07, 0xC0, 0xFF, 0xC0,
+    0x03, 0xFF, 0x80, 0x00, 0x0F, 0xC0, 0xFF, 0xC0, 0x07, 0xFF, 0x00, 0x00, 0x0F, 0xC0, 0x7F, 0xE0,
+    0x07, 0xFE, 0x00, 0x00, 0x1F, 0x80, 0x7F, 0xE0, 0x07, 0xFC, 0x00, 0x00, 0x1F, 0x80, 0x3F, 0xF0,
+    0x0F, 0xFC, 0x00, 0x00, 0x3F, 0x00, 0x3F, 0xF0, 0x0F, 0xFC, 0x00, 0x00, 0x3E, 0x00, 0x1F, 0xF0,
+    0x0F, 0xF8, 0x00, 0x00, 0x7E, 0x00, 0x1F, 0xF0, 0x0F, 0xF8, 0x00, 0x03, 0xFC, 0x00, 0x1F, 0xF8,
+    0x1F, 0xF8, 0x00, 0x0F, 0xFC, 0x00, 0x0F, 0xF8, 0x1F, 0xF0, 0x00, 0x1F, 0xF8, 0x00, 0x0F, 0xF8,
+    0x1F, 0xF0, 0x00, 0x1F, 0xFC, 0x00, 0x0F, 0xF8, 0x1F, 0xF0, 0x00, 0x3F, 0xFC, 0x00, 0x0F, 0xF8,
+    0x1F, 0xF0, 0x00, 0x3F, 0xFC, 0x00, 0x0F, 0xF8, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8,
+    0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8,
+    0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8,
+    0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF8,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
 // MTG icon (64x64, 1-bit)
 inline constexpr uint8_t ICON_MTG[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
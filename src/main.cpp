@@ -3,38 +3,48 @@
 #include <WiFi.h>
 #include "app/AppRegistry.hpp"
 #include "app/Navigation.hpp"
-#include "apps/home/HomeApp.hpp"
-#include "apps/mtg/MTGApp.hpp"
-#include "apps/settings/SettingsApp.hpp"
+#include "app/Resume.hpp"
+#include "apps/diagnostics/DiagnosticsApp.hpp"
 #include "models/Settings.hpp"
+#include "models/WiFiNetwork.hpp"
+#include "ui/PlayerCard.hpp"
+#include "utils/Battery.hpp"
+#include "utils/Energy.hpp"
 #include "utils/Log.hpp"
+#include "utils/Memory.hpp"
+#include "utils/Metrics.hpp"
 #include "utils/Power.hpp"
+#include "utils/Profiler.hpp"
 #include "utils/Sound.hpp"
+#include "utils/Stall.hpp"
+#include "utils/TouchRecorder.hpp"
+#include "utils/Trace.hpp"
 
-// Global instances
-Settings globalSettings;
-
-// App instances
-static HomeApp homeApp;
-static MTGApp mtgApp;
-static SettingsApp settingsApp;
+// WiFi auto-connect deferred to the first loop after a warm wake
+static bool wifiAutoConnectPending = false;
 
 void tryWifiAutoConnect() {
-    Preferences prefs;
-    if (!prefs.begin("wifi", true))
-        return;  // read-only
-
-    String ssid = prefs.getString("ssid", "");
-    String pass = prefs.getString("pass", "");
-    prefs.end();
+    WiFiSsid ssid;
+    WiFiPassword pass;
+    {
+        TRACE_SCOPE_ARG("nvs.load", "wifi");
+        Preferences prefs;
+        if (!prefs.begin("wifi", true))
+            return;  // read-only
+
+        prefs.getString("ssid", ssid.data(), ssid.capacity() + 1);
+        prefs.getString("pass", pass.data(), pass.capacity() + 1);
+        prefs.end();
+    }
 
-    if (ssid.isEmpty()) {
+    if (ssid.empty()) {
         LOG_I("WiFi auto-connect: no saved network");
         return;
     }
 
     LOG_I("WiFi auto-connect: connecting to %s", ssid.c_str());
 
+    TRACE_SCOPE("wifi.connect");
     WiFi.mode(WIFI_STA);
     WiFi.begin(ssid.c_str(), pass.c_str());
 
@@ -56,36 +66,61 @@ void setup() {
     auto cfg = M5.config();
     cfg.serial_baudrate = 115200;
     M5.begin(cfg);
+    Log::init();  // Before anything logs
+#ifdef TRACE
+    Trace::init();
+#endif
+
+    // Deep sleep ran out untouched: finish powering off. State was saved to
+    // NVS before sleeping, so the next power-on cold boots into it.
+    if (Power::wokeToPowerOff()) {
+        LOG_I("Deep sleep timed out, powering off");
+        Power::powerOff();
+        return;
+    }
+
+    // A warm wake from deep sleep restores from RTC memory and skips NVS
+    bool warm = Resume::isWarmWake();
 
     M5.Display.setRotation(1);  // Landscape (960x540)
     M5.Display.setEpdMode(epd_fastest);
-    M5.Display.fillScreen(TFT_WHITE);
+    if (!warm) {
+        M5.Display.fillScreen(TFT_WHITE);  // Otherwise the EPD still shows the last screen
+    }
 
     Sound::init();
     Power::init();
-
-    // Load settings for sleep timeout
-    Preferences prefs;
-    globalSettings.load(prefs);
+    Battery::init(warm);
+    Energy::init();
 
     LOG_I("========================================");
     LOG_I("M5Paper S3 App Platform");
     LOG_I("========================================");
-    LOG_I("Sleep timeout: %d seconds", globalSettings.sleepTimeoutSecs);
 
-    // Auto-connect to WiFi if enabled
-    if (globalSettings.wifiAutoConnect) {
-        tryWifiAutoConnect();
-    }
+    // Apps are declared in apps/InstalledApps.cpp and constructed on first launch.
+    if (warm && Resume::restore(globalSettings)) {
+        LOG_I("Warm wake: resumed in %lu ms", millis());
+        // Connect after the restored screen is up, not before (it blocks for seconds)
+        wifiAutoConnectPending = globalSettings.wifiAutoConnect;
+    } else {
+        // Load settings for sleep timeout
+        Preferences prefs;
+        globalSettings.load(prefs);
 
-    // Register apps with the registry
-    auto& registry = AppRegistry::instance();
-    registry.registerApp(&homeApp);
-    registry.registerApp(&mtgApp);
-    registry.registerApp(&settingsApp);
+        // Auto-connect to WiFi if enabled (deferred on warm wake - it blocks for seconds)
+        if (globalSettings.wifiAutoConnect) {
+            tryWifiAutoConnect();
+        }
 
-    // Restore previous navigation state or go home
-    Navigation::instance().restoreState();
+        // Restore previous navigation state or go home
+        Navigation::instance().restoreState();
+        LOG_I("Cold boot: ready in %lu ms", millis());
+    }
+    // CPU clock, tier timeouts and WiFi power save follow the profile
+    Power::setProfile(globalSettings.powerProfile);
+    AppRegistry::instance().setHidden(DiagnosticsApp::METADATA.id, !globalSettings.showDiagnostics);
+    PlayerCard::setCommitOnPress(globalSettings.lifeOnTouchDown);
+    LOG_I("Sleep timeout: %d seconds", globalSettings.sleepTimeoutSecs);
 
     LOG_I("Setup complete. Starting main loop.");
 }
@@ -93,38 +128,119 @@ void setup() {
 void enterSleepMode() {
     LOG_I("Entering sleep mode...");
 
-    // Save navigation state before sleep
+    // NVS keeps a fallback in case RTC memory is lost (battery pulled)
     Navigation::instance().saveState();
+    Resume::capture(globalSettings);
+    Memory::logReport();
+    Power::logReport();
+    Battery::save();
+    Energy::logReport();
+    Stall::logReport();
+
+    Power::deepSleep();
+}
 
-    Power::powerOff();
+#if defined(TRACE) || defined(PROFILE)
+// Single-character commands from the serial monitor
+void handleSerialCommand() {
+    if (Serial.available() <= 0) {
+        return;
+    }
+    switch (Serial.read()) {
+#ifdef TRACE
+        case 't':  // Dump the recent timeline as trace JSON
+            Trace::dump();
+            break;
+        case 'r':  // Start/stop recording touches for host replay
+            if (TouchRecorder::recording()) {
+                TouchRecorder::stop();
+            } else {
+                App* app = Navigation::instance().currentApp();
+                TouchRecorder::start(app ? app->metadata().id : nullptr);
+            }
+            break;
+#endif
+#ifdef PROFILE
+        case 'p':  // Start/stop streaming profiler samples
+            if (Profiler::running()) {
+                Profiler::stop();
+            } else {
+                Profiler::start();
+            }
+            break;
+#endif
+        default:
+            break;
+    }
 }
+#endif
 
 void loop() {
-    M5.update();
+#if defined(TRACE) || defined(PROFILE)
+    handleSerialCommand();
+#endif
+#ifdef PROFILE
+    Profiler::poll();
+#endif
 
     auto& nav = Navigation::instance();
+    Stall::beginLoop();
+    Metrics::onLoop();
+    {
+        TRACE_SCOPE("loop");
+
+        // Handle touch
+        {
+            TRACE_SCOPE("input");
+            M5.update();
+            // Every point the controller reports, each with its own press and
+            // release, so two players can tap their cards at the same time
+            for (size_t i = 0; i < M5.Touch.getCount(); i++) {
+                const auto& touch = M5.Touch.getDetail(i);
+                TouchPoint point;
+                point.id = touch.id;
+                point.x = touch.x;
+                point.y = touch.y;
+                point.pressed = touch.isPressed();
+                point.released = touch.wasReleased();
+
+                if (point.pressed || point.released) {
+                    Power::resetInactivityTimer();
+#ifdef TRACE
+                    TouchRecorder::onTouch(point);
+#endif
+                    nav.handleTouch(point);
+                }
+            }
+        }
 
-    // Handle touch
-    if (M5.Touch.getCount() > 0) {
-        auto touch = M5.Touch.getDetail();
-        bool pressed = touch.isPressed();
-        bool released = touch.wasReleased();
+        // Step the power tiers; Off means the sleep timeout has passed
+        {
+            TRACE_SCOPE("power");
+            if (Power::update(globalSettings.sleepTimeoutSecs) == PowerTier::Off) {
+                enterSleepMode();
+                return;  // Won't reach here: a wake restarts from setup()
+            }
+            Battery::update();
+            Energy::update();
+        }
 
-        if (pressed || released) {
-            Power::resetInactivityTimer();
-            nav.handleTouch(touch.x, touch.y, pressed, released);
+        // Update and draw
+        {
+            TRACE_SCOPE("update");
+            nav.update();
         }
+        nav.draw(&M5.Display);
     }
+    Stall::endLoop();  // The frame wait below is intentional idle, not a stall
 
-    // Check for sleep timeout
-    if (Power::shouldSleep(globalSettings.sleepTimeoutSecs)) {
-        enterSleepMode();
-        return;  // Won't reach here after powerOff
+    // Outside the stall window too: the deferred auto-connect waits on the network
+    if (wifiAutoConnectPending) {
+        wifiAutoConnectPending = false;
+        tryWifiAutoConnect();
     }
 
-    // Update and draw
-    nav.update();
-    nav.draw(&M5.Display);
-
-    delay(20);  // ~50fps update rate
+    // Profile-paced frames while active, light sleep between taps and when idle
+    TRACE_SCOPE("wait");
+    Power::waitForNextFrame();
 }
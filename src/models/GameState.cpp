@@ -1,4 +1,6 @@
 #include "GameState.hpp"
+#include "../utils/Metrics.hpp"
+#include "../utils/Trace.hpp"
 
 static const char* NVS_NAMESPACE = "mtg";
 static const char* KEY_PLAYER_COUNT = "playerCnt";
@@ -31,6 +33,7 @@ void GameState::resetLifeTotals() {
 }
 
 bool GameState::load(Preferences& prefs) {
+    TRACE_SCOPE_ARG("nvs.load", NVS_NAMESPACE);
     if (!prefs.begin(NVS_NAMESPACE, true)) {
         initDefaults();
         return false;
@@ -55,6 +58,7 @@ bool GameState::load(Preferences& prefs) {
 }
 
 bool GameState::save(Preferences& prefs) {
+    TRACE_SCOPE_ARG("nvs.save", NVS_NAMESPACE);
     if (!prefs.begin(NVS_NAMESPACE, false)) {
         return false;
     }
@@ -68,5 +72,6 @@ bool GameState::save(Preferences& prefs) {
     }
 
     prefs.end();
+    Metrics::onNvsWrite();
     return true;
 }
@@ -4,18 +4,24 @@
 #include <cstring>
 
 struct Player {
+    static constexpr int16_t MIN_LIFE = -999;
+    static constexpr int16_t MAX_LIFE = 9999;
+
     char name[16] = "Player";
     int16_t life = 20;
 
     void reset(int16_t startingLife) { life = startingLife; }
 
-    void adjustLife(int16_t delta) {
+    void adjustLife(int16_t delta) { life = lifeAfter(delta); }
+
+    // Life after a change, clamped to the displayable range
+    int16_t lifeAfter(int16_t delta) const {
         int32_t newLife = static_cast<int32_t>(life) + delta;
-        if (newLife < -999)
-            newLife = -999;
-        if (newLife > 9999)
-            newLife = 9999;
-        life = static_cast<int16_t>(newLife);
+        if (newLife < MIN_LIFE)
+            newLife = MIN_LIFE;
+        if (newLife > MAX_LIFE)
+            newLife = MAX_LIFE;
+        return static_cast<int16_t>(newLife);
     }
 
     void setName(const char* newName) {
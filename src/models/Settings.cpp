@@ -1,17 +1,28 @@
 #include "Settings.hpp"
+#include "../utils/Metrics.hpp"
+#include "../utils/Trace.hpp"
 
 static const char* NVS_NAMESPACE = "settings";
 static const char* KEY_SOUND_ON = "soundOn";
 static const char* KEY_SLEEP_SECS = "sleepSecs";
 static const char* KEY_WIFI_AUTO = "wifiAuto";
+static const char* KEY_POWER_PROFILE = "powerProf";
+static const char* KEY_DIAGNOSTICS = "diagApp";
+static const char* KEY_LIFE_TOUCH_DOWN = "lifeDown";
+
+Settings globalSettings;
 
 void Settings::initDefaults() {
     soundEnabled = true;
     sleepTimeoutSecs = DEFAULT_SLEEP_TIMEOUT;
     wifiAutoConnect = false;
+    powerProfile = PowerProfile::Balanced;
+    showDiagnostics = false;
+    lifeOnTouchDown = false;
 }
 
 bool Settings::load(Preferences& prefs) {
+    TRACE_SCOPE_ARG("nvs.load", NVS_NAMESPACE);
     if (!prefs.begin(NVS_NAMESPACE, true)) {
         initDefaults();
         return false;
@@ -20,12 +31,19 @@ bool Settings::load(Preferences& prefs) {
     soundEnabled = prefs.getBool(KEY_SOUND_ON, true);
     sleepTimeoutSecs = prefs.getUShort(KEY_SLEEP_SECS, DEFAULT_SLEEP_TIMEOUT);
     wifiAutoConnect = prefs.getBool(KEY_WIFI_AUTO, false);
+    uint8_t profile =
+        prefs.getUChar(KEY_POWER_PROFILE, static_cast<uint8_t>(PowerProfile::Balanced));
+    powerProfile = profile < PowerProfiles::COUNT ? static_cast<PowerProfile>(profile)
+                                                  : PowerProfile::Balanced;
+    showDiagnostics = prefs.getBool(KEY_DIAGNOSTICS, false);
+    lifeOnTouchDown = prefs.getBool(KEY_LIFE_TOUCH_DOWN, false);
 
     prefs.end();
     return true;
 }
 
 bool Settings::save(Preferences& prefs) {
+    TRACE_SCOPE_ARG("nvs.save", NVS_NAMESPACE);
     if (!prefs.begin(NVS_NAMESPACE, false)) {
         return false;
     }
@@ -33,7 +51,11 @@ bool Settings::save(Preferences& prefs) {
     prefs.putBool(KEY_SOUND_ON, soundEnabled);
     prefs.putUShort(KEY_SLEEP_SECS, sleepTimeoutSecs);
     prefs.putBool(KEY_WIFI_AUTO, wifiAutoConnect);
+    prefs.putUChar(KEY_POWER_PROFILE, static_cast<uint8_t>(powerProfile));
+    prefs.putBool(KEY_DIAGNOSTICS, showDiagnostics);
+    prefs.putBool(KEY_LIFE_TOUCH_DOWN, lifeOnTouchDown);
 
     prefs.end();
+    Metrics::onNvsWrite();
     return true;
 }
@@ -2,6 +2,7 @@
 
 #include <Preferences.h>
 #include <cstdint>
+#include "../utils/PowerProfile.hpp"
 
 struct Settings {
     static constexpr uint16_t DEFAULT_SLEEP_TIMEOUT = 300;  // 5 minutes
@@ -9,8 +10,15 @@ struct Settings {
     bool soundEnabled = true;
     uint16_t sleepTimeoutSecs = DEFAULT_SLEEP_TIMEOUT;  // 0 = disabled
     bool wifiAutoConnect = false;
+    PowerProfile powerProfile = PowerProfile::Balanced;
+    bool showDiagnostics = false;  // Diagnostics app on the launcher
+    bool lifeOnTouchDown = false;  // Life buttons act on touch-down, not release
 
     void initDefaults();
     bool load(Preferences& prefs);
     bool save(Preferences& prefs);
 };
+
+// The live settings: loaded from NVS at boot (or restored from deep sleep),
+// edited in place by the Settings app and snapshotted before deep sleep
+extern Settings globalSettings;
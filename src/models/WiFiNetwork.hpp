@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include "../utils/FixedString.hpp"
+#include "../utils/FixedVector.hpp"
+
+static constexpr size_t WIFI_SSID_MAX_LEN = 32;  // 802.11 limit
+static constexpr size_t WIFI_PASS_MAX_LEN = 64;  // WPA2 passphrase or 64 hex digits
+static constexpr size_t WIFI_MAX_NETWORKS = 16;  // Scan results kept, strongest first
+
+using WiFiSsid = FixedString<WIFI_SSID_MAX_LEN>;
+using WiFiPassword = FixedString<WIFI_PASS_MAX_LEN>;
+
+struct WiFiNetwork {
+    WiFiSsid ssid;
+    int32_t rssi = 0;
+    bool secured = false;
+    bool connected = false;
+};
+
+// Bounded scan result list - memory stays fixed however many networks are visible
+struct WiFiNetworkList : FixedVector<WiFiNetwork, WIFI_MAX_NETWORKS> {
+    // Connected network always ranks first, then strongest signal
+    static bool ranksBefore(const WiFiNetwork& a, const WiFiNetwork& b) {
+        if (a.connected != b.connected)
+            return a.connected;
+        return a.rssi > b.rssi;
+    }
+
+    // Insert keeping rank order. Duplicate SSIDs (mesh/extenders) keep the best entry,
+    // and once full the weakest entry is dropped. Returns false if the network was discarded.
+    bool insertRanked(const WiFiNetwork& net) {
+        if (net.ssid.empty())
+            return false;
+
+        for (size_t i = 0; i < size(); i++) {
+            if ((*this)[i].ssid == net.ssid) {
+                if (!ranksBefore(net, (*this)[i]))
+                    return false;
+                erase(i);
+                break;
+            }
+        }
+
+        size_t pos = 0;
+        while (pos < size() && !ranksBefore(net, (*this)[pos])) {
+            pos++;
+        }
+        if (pos >= capacity())
+            return false;
+        if (full())
+            pop_back();
+        return insert(pos, net);
+    }
+};
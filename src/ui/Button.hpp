@@ -1,11 +1,11 @@
 #pragma once
 
-#include <functional>
+#include "../utils/InlineFunction.hpp"
 #include "Component.hpp"
 
 class Button : public Component {
    public:
-    using Callback = std::function<void()>;
+    using Callback = InlineFunction<void()>;
 
     Button(Rect bounds, const char* label, Callback onClick);
 
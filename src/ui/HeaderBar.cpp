@@ -12,12 +12,12 @@ HeaderBar::HeaderBar() {
              y + (HEIGHT - Layout::BUTTON_H) / 2, Layout::BUTTON_W, Layout::BUTTON_H);
 }
 
-void HeaderBar::setLeftButton(const char* label, std::function<void()> callback) {
+void HeaderBar::setLeftButton(const char* label, Callback callback) {
     _leftLabel = label;
     _leftCallback = callback;
 }
 
-void HeaderBar::setRightButton(const char* label, std::function<void()> callback) {
+void HeaderBar::setRightButton(const char* label, Callback callback) {
     _rightLabel = label;
     _rightCallback = callback;
 }
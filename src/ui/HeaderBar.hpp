@@ -1,7 +1,7 @@
 #pragma once
 
 #include <M5GFX.h>
-#include <functional>
+#include "../utils/InlineFunction.hpp"
 #include "Component.hpp"
 #include "Layout.hpp"
 #include "Toolbar.hpp"
@@ -11,11 +11,13 @@ class HeaderBar : public Component {
     static constexpr int16_t HEIGHT = Layout::HEADER_H;
     // Button sizes come from Layout
 
+    using Callback = InlineFunction<void()>;
+
     HeaderBar();
 
     void setTitle(const char* title) { _title = title; }
-    void setLeftButton(const char* label, std::function<void()> callback);
-    void setRightButton(const char* label, std::function<void()> callback);
+    void setLeftButton(const char* label, Callback callback);
+    void setRightButton(const char* label, Callback callback);
 
     void draw(M5GFX* gfx) override;
     bool handleTouch(int16_t x, int16_t y, bool pressed, bool released) override;
@@ -24,8 +26,8 @@ class HeaderBar : public Component {
     const char* _title = nullptr;
     const char* _leftLabel = nullptr;
     const char* _rightLabel = nullptr;
-    std::function<void()> _leftCallback;
-    std::function<void()> _rightCallback;
+    Callback _leftCallback;
+    Callback _rightCallback;
     Rect _leftButtonRect;
     Rect _rightButtonRect;
 };
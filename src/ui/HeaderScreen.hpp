@@ -1,6 +1,5 @@
 #pragma once
 
-#include <functional>
 #include "HeaderBar.hpp"
 #include "ToolbarScreen.hpp"
 
@@ -18,11 +17,11 @@ class HeaderScreen : public ToolbarScreen {
    protected:
     HeaderBar _headerBar;
 
-    void setLeftButton(const char* label, std::function<void()> cb) {
+    void setLeftButton(const char* label, HeaderBar::Callback cb) {
         _headerBar.setLeftButton(label, cb);
     }
 
-    void setRightButton(const char* label, std::function<void()> cb) {
+    void setRightButton(const char* label, HeaderBar::Callback cb) {
         _headerBar.setRightButton(label, cb);
     }
 
@@ -33,14 +33,17 @@ void Keyboard::appendChar(char c) {
         return;
     _buffer[_cursorPos++] = c;
     _buffer[_cursorPos] = '\0';
-    _shifted = false;  // Auto-unshift after typing
-    setDirty();
+    requestRedraw(REDRAW_PREVIEW);
+    if (_shifted) {
+        _shifted = false;  // Auto-unshift after typing
+        requestRedraw(REDRAW_LABELS);
+    }
 }
 
 void Keyboard::backspace() {
     if (_cursorPos > 0) {
         _buffer[--_cursorPos] = '\0';
-        setDirty();
+        requestRedraw(REDRAW_PREVIEW);
     }
 }
 
@@ -50,6 +53,46 @@ void Keyboard::complete(bool confirmed) {
     }
 }
 
+void Keyboard::requestRedraw(uint8_t parts) {
+    _redraw |= parts;
+    setDirty();
+}
+
+void Keyboard::invalidate() {
+    requestRedraw(REDRAW_ALL);
+}
+
+// Applies one character-grid keystroke (rows 0-2, or SPACE)
+void Keyboard::pressKey(int row, int col) {
+    if (row == 3) {
+        appendChar(' ');
+    } else if (row == 0 && col == 10) {
+        backspace();
+    } else if (row == 2 && col == 0) {
+        _numMode = !_numMode;  // 123/ABC toggle
+        requestRedraw(REDRAW_LABELS);
+    } else if (row == 2 && col == 9 && !_numMode) {
+        _shifted = !_shifted;  // Shift (letter mode only)
+        requestRedraw(REDRAW_LABELS);
+    } else {
+        char c = getKeyChar(row, col);
+        if (c != '\0') {
+            appendChar(c);
+        }
+    }
+}
+
+void Keyboard::applyPendingKeys() {
+    for (uint8_t i = 0; i < _pendingCount; i++) {
+        pressKey(_pendingKeys[i] >> 4, _pendingKeys[i] & 0x0F);
+    }
+    _pendingCount = 0;
+}
+
+int Keyboard::colCount(int row) {
+    return row == 0 ? 11 : row == 3 ? 3 : 10;  // Row 0 has backspace
+}
+
 Rect Keyboard::getKeyRect(int row, int col) const {
     int16_t y = _bounds.y + PREVIEW_HEIGHT + row * (KEY_HEIGHT + KEY_SPACING);
     int16_t x;
@@ -69,7 +112,7 @@ Rect Keyboard::getKeyRect(int row, int col) const {
     }
 
     // Regular rows - center the keyboard
-    int numKeys = (row == 0) ? 11 : (row == 1) ? 10 : 10;  // row 0 has backspace
+    int numKeys = colCount(row);
     int16_t rowWidth = numKeys * KEY_WIDTH + (numKeys - 1) * KEY_SPACING;
     int16_t startX = _bounds.x + (_bounds.w - rowWidth) / 2;
 
@@ -77,9 +120,38 @@ Rect Keyboard::getKeyRect(int row, int col) const {
     return Rect(x, y, KEY_WIDTH, KEY_HEIGHT);
 }
 
+bool Keyboard::keyAt(int16_t x, int16_t y, int& row, int& col) const {
+    const int pitchY = KEY_HEIGHT + KEY_SPACING;
+    int offsetY = y - (_bounds.y + PREVIEW_HEIGHT);
+    if (offsetY < 0 || offsetY % pitchY >= KEY_HEIGHT)
+        return false;
+    row = offsetY / pitchY;
+    if (row > 3)
+        return false;
+
+    if (row == 3) {
+        for (col = 0; col < 3; col++) {
+            if (getKeyRect(3, col).contains(x, y))
+                return true;
+        }
+        return false;
+    }
+
+    const int pitchX = KEY_WIDTH + KEY_SPACING;
+    int offsetX = x - getKeyRect(row, 0).x;
+    if (offsetX < 0 || offsetX % pitchX >= KEY_WIDTH)
+        return false;
+    col = offsetX / pitchX;
+    return col < colCount(row);
+}
+
 char Keyboard::getKeyChar(int row, int col) const {
+    return keyChar(row, col, _numMode, _shifted);
+}
+
+char Keyboard::keyChar(int row, int col, bool numMode, bool shifted) {
     const char* rowStr;
-    if (_numMode) {
+    if (numMode) {
         rowStr = (row == 0) ? NUM_ROW0 : (row == 1) ? NUM_ROW1 : NUM_ROW2;
     } else {
         rowStr = (row == 0) ? LETTER_ROW0 : (row == 1) ? LETTER_ROW1 : LETTER_ROW2;
@@ -94,18 +166,17 @@ char Keyboard::getKeyChar(int row, int col) const {
     if (row == 2 && col == 0)
         return '\0';
     // Row 2 position 9 in letter mode is shift
-    if (!_numMode && row == 2 && col == 9 && c == '^')
+    if (!numMode && row == 2 && col == 9 && c == '^')
         return '\0';
 
-    if (!_numMode && !_shifted && c >= 'A' && c <= 'Z') {
+    if (!numMode && !shifted && c >= 'A' && c <= 'Z') {
         return c + 32;  // lowercase
     }
     return c;
 }
 
-const char* Keyboard::getKeyLabel(int row, int col) const {
-    static char label[2] = {0, 0};
-
+// Label of a key in the given mode; single characters are written to buf
+const char* Keyboard::keyLabel(int row, int col, bool numMode, bool shifted, char* buf) {
     if (row == 0 && col == 10)
         return "<-";  // Backspace
     if (row == 3) {
@@ -118,64 +189,102 @@ const char* Keyboard::getKeyLabel(int row, int col) const {
     }
     // Mode toggle button (first key on row 2)
     if (row == 2 && col == 0) {
-        return _numMode ? "ABC" : "123";
+        return numMode ? "ABC" : "123";
     }
     // Shift button (last key on row 2) - only in letter mode
     if (row == 2 && col == 9) {
-        if (_numMode) {
+        if (numMode) {
             return "#+=";  // More symbols indicator
         }
-        return _shifted ? "^" : "v";  // Shift indicator
+        return shifted ? "^" : "v";  // Shift indicator
     }
 
-    char c = getKeyChar(row, col);
+    char c = keyChar(row, col, numMode, shifted);
     if (c == '\0')
         return "";
-    label[0] = c;
-    return label;
+    buf[0] = c;
+    buf[1] = '\0';
+    return buf;
 }
 
-void Keyboard::draw(M5GFX* gfx) {
-    if (!isDirty())
-        return;
+void Keyboard::drawKey(M5GFX* gfx, int row, int col, bool clear) {
+    char buf[2];
+    Rect r = getKeyRect(row, col);
+    if (clear) {
+        gfx->fillRect(r.x + 1, r.y + 1, r.w - 2, r.h - 2, TFT_WHITE);
+    } else {
+        gfx->drawRect(r.x, r.y, r.w, r.h, TFT_BLACK);
+    }
+    gfx->setTextColor(TFT_BLACK);
+    gfx->setTextDatum(MC_DATUM);
+    gfx->setTextSize(2);
+    gfx->drawString(keyLabel(row, col, _numMode, _shifted, buf), r.x + r.w / 2, r.y + r.h / 2);
+}
 
+// Text line above the keys, inside the border and the separator
+void Keyboard::drawPreview(M5GFX* gfx) {
+    gfx->fillRect(_bounds.x + 2, _bounds.y + 2, _bounds.w - 4, PREVIEW_HEIGHT - 2, TFT_WHITE);
+    gfx->setTextColor(TFT_BLACK);
+    gfx->setTextDatum(MC_DATUM);
+    gfx->setTextSize(3);
+    gfx->drawString(_buffer, _bounds.x + _bounds.w / 2, _bounds.y + PREVIEW_HEIGHT / 2);
+}
+
+void Keyboard::drawAll(M5GFX* gfx) {
     // Background - solid white to cover any ghosting
     gfx->fillRect(_bounds.x, _bounds.y, _bounds.w, _bounds.h, TFT_WHITE);
     gfx->drawRect(_bounds.x, _bounds.y, _bounds.w, _bounds.h, TFT_BLACK);
     gfx->drawRect(_bounds.x + 1, _bounds.y + 1, _bounds.w - 2, _bounds.h - 2, TFT_BLACK);
 
-    gfx->setTextColor(TFT_BLACK);
-
-    // Text preview - large
-    gfx->setTextDatum(MC_DATUM);
-    gfx->setTextSize(3);
-    gfx->drawString(_buffer, _bounds.x + _bounds.w / 2, _bounds.y + PREVIEW_HEIGHT / 2);
+    drawPreview(gfx);
     gfx->drawLine(_bounds.x, _bounds.y + PREVIEW_HEIGHT, _bounds.x + _bounds.w,
                   _bounds.y + PREVIEW_HEIGHT, TFT_BLACK);
 
-    // Draw rows 0-2 (letter keys)
-    gfx->setTextSize(2);  // Larger text for keys
-    for (int row = 0; row < 3; row++) {
-        int numCols = (row == 0) ? 11 : 10;
-        for (int col = 0; col < numCols; col++) {
-            Rect r = getKeyRect(row, col);
-            const char* label = getKeyLabel(row, col);
-            gfx->drawRect(r.x, r.y, r.w, r.h, TFT_BLACK);
-            gfx->setTextDatum(MC_DATUM);
-            gfx->drawString(label, r.x + r.w / 2, r.y + r.h / 2);
+    // Rows 0-2 and row 3 (SPACE, DONE, CANCEL)
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < colCount(row); col++) {
+            drawKey(gfx, row, col, false);
         }
     }
+}
 
-    // Draw row 3 (SPACE, DONE, CANCEL) - slightly smaller text to fit labels
-    gfx->setTextSize(2);
-    for (int col = 0; col < 3; col++) {
-        Rect r = getKeyRect(3, col);
-        const char* label = getKeyLabel(3, col);
-        gfx->drawRect(r.x, r.y, r.w, r.h, TFT_BLACK);
-        gfx->setTextDatum(MC_DATUM);
-        gfx->drawString(label, r.x + r.w / 2, r.y + r.h / 2);
+// Repaints only what changed since the last draw: the preview on a
+// keystroke, and on a shift or 123 toggle just the keys whose label differs
+// from the one on the panel. The first draw (and one after invalidate())
+// paints everything.
+void Keyboard::draw(M5GFX* gfx) {
+    if (!isDirty())
+        return;
+
+    applyPendingKeys();
+
+    if (_redraw & REDRAW_ALL) {
+        drawAll(gfx);
+        _drawnArea = _bounds;
+    } else {
+        _drawnArea = Rect();
+        if (_redraw & REDRAW_PREVIEW) {
+            drawPreview(gfx);
+            _drawnArea = Rect(_bounds.x, _bounds.y, _bounds.w, PREVIEW_HEIGHT);
+        }
+        if (_redraw & REDRAW_LABELS) {
+            char was[2];
+            char now[2];
+            for (int row = 0; row < 3; row++) {
+                for (int col = 0; col < colCount(row); col++) {
+                    const char* old = keyLabel(row, col, _drawnNumMode, _drawnShifted, was);
+                    if (strcmp(old, keyLabel(row, col, _numMode, _shifted, now)) == 0)
+                        continue;
+                    drawKey(gfx, row, col, true);
+                    _drawnArea = _drawnArea.unite(getKeyRect(row, col));
+                }
+            }
+        }
     }
 
+    _drawnShifted = _shifted;
+    _drawnNumMode = _numMode;
+    _redraw = 0;
     setDirty(false);
 }
 
@@ -187,48 +296,21 @@ bool Keyboard::handleTouch(int16_t x, int16_t y, bool pressed, bool released) {
 
     Sound::click();
 
-    // Check rows 0-2
-    for (int row = 0; row < 3; row++) {
-        int numCols = (row == 0) ? 11 : 10;
-        for (int col = 0; col < numCols; col++) {
-            Rect r = getKeyRect(row, col);
-            if (r.contains(x, y)) {
-                if (row == 0 && col == 10) {
-                    // Backspace
-                    backspace();
-                } else if (row == 2 && col == 0) {
-                    // 123/ABC toggle
-                    _numMode = !_numMode;
-                    setDirty();
-                } else if (row == 2 && col == 9 && !_numMode) {
-                    // Shift (letter mode only)
-                    _shifted = !_shifted;
-                    setDirty();
-                } else {
-                    char c = getKeyChar(row, col);
-                    if (c != '\0') {
-                        appendChar(c);
-                    }
-                }
-                return true;
-            }
-        }
-    }
+    int row;
+    int col;
+    if (!keyAt(x, y, row, col))
+        return true;  // Between keys
 
-    // Check row 3
-    for (int col = 0; col < 3; col++) {
-        Rect r = getKeyRect(3, col);
-        if (r.contains(x, y)) {
-            if (col == 0) {
-                appendChar(' ');
-            } else if (col == 1) {
-                complete(true);  // DONE
-            } else {
-                complete(false);  // CANCEL
-            }
-            return true;
-        }
+    if (row == 3 && col > 0) {
+        // Keys typed in this loop land in the text before it is handed over
+        applyPendingKeys();
+        complete(col == 1);  // DONE or CANCEL
+        return true;
     }
 
+    if (_pendingCount == MAX_PENDING_KEYS)
+        applyPendingKeys();
+    _pendingKeys[_pendingCount++] = static_cast<uint8_t>(row << 4 | col);
+    setDirty();
     return true;
 }
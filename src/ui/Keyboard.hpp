@@ -1,23 +1,43 @@
 #pragma once
 
-#include <functional>
+#include "../utils/InlineFunction.hpp"
 #include "Component.hpp"
 
 class Keyboard : public Component {
    public:
-    using Callback = std::function<void(const char* result, bool confirmed)>;
+    using Callback = InlineFunction<void(const char* result, bool confirmed)>;
 
     Keyboard(const char* initialText, Callback onComplete);
 
     void draw(M5GFX* gfx) override;
     bool handleTouch(int16_t x, int16_t y, bool pressed, bool released) override;
 
+    // Key geometry and mapping; rows 0-2 are character keys, row 3 SPACE/DONE/CANCEL
+    Rect getKeyRect(int row, int col) const;
+    char getKeyChar(int row, int col) const;
+
+    // Key under a point, computed from the grid; false between keys
+    bool keyAt(int16_t x, int16_t y, int& row, int& col) const;
+
+    // The next draw repaints the whole keyboard (after the screen was cleared)
+    void invalidate();
+
+    // Area the last draw() painted: the preview line and changed keys, or
+    // the whole keyboard
+    Rect drawnArea() const { return _drawnArea; }
+
    private:
     static constexpr int16_t KEY_WIDTH = 75;
     static constexpr int16_t KEY_HEIGHT = 50;
     static constexpr int16_t KEY_SPACING = 6;
     static constexpr int16_t PREVIEW_HEIGHT = 44;
     static constexpr uint8_t MAX_TEXT_LEN = 32;
+    static constexpr uint8_t MAX_PENDING_KEYS = 16;
+
+    // What the next draw repaints
+    static constexpr uint8_t REDRAW_ALL = 0x01;
+    static constexpr uint8_t REDRAW_PREVIEW = 0x02;
+    static constexpr uint8_t REDRAW_LABELS = 0x04;  // Keys whose label changed
 
     char _buffer[MAX_TEXT_LEN + 1] = "";
     char _originalText[MAX_TEXT_LEN + 1] = "";
@@ -26,11 +46,30 @@ class Keyboard : public Component {
     bool _numMode = false;  // Number/symbol mode
     Callback _onComplete;
 
+    // Keystrokes (row << 4 | col) taken on touch and applied in order at the
+    // next draw. This keeps every key from fingers landing in the same loop;
+    // it is not a buffer across panel refreshes (display() does not block
+    // the loop, so keys typed during a refresh are polled as usual)
+    uint8_t _pendingKeys[MAX_PENDING_KEYS];
+    uint8_t _pendingCount = 0;
+
+    uint8_t _redraw = REDRAW_ALL;
+    bool _drawnShifted = true;  // Mode the key labels on the panel were drawn in
+    bool _drawnNumMode = false;
+    Rect _drawnArea;
+
     void appendChar(char c);
     void backspace();
     void complete(bool confirmed);
+    void pressKey(int row, int col);
+    void applyPendingKeys();
+    void requestRedraw(uint8_t parts);
 
-    Rect getKeyRect(int row, int col) const;
-    char getKeyChar(int row, int col) const;
-    const char* getKeyLabel(int row, int col) const;
+    void drawAll(M5GFX* gfx);
+    void drawPreview(M5GFX* gfx);
+    void drawKey(M5GFX* gfx, int row, int col, bool clear);
+
+    static int colCount(int row);
+    static char keyChar(int row, int col, bool numMode, bool shifted);
+    static const char* keyLabel(int row, int col, bool numMode, bool shifted, char* buf);
 };
@@ -1,7 +1,11 @@
 #include "PlayerCard.hpp"
 #include <Arduino.h>
+#include "../utils/Power.hpp"
 #include "../utils/Sound.hpp"
 
+static const int16_t LIFE_DELTAS[] = {-5, -1, 1, 5};
+static bool s_commitOnPress = false;
+
 PlayerCard::PlayerCard(Player* player, NameTapCallback onNameTap)
     : _player(player), _onNameTap(onNameTap) {
     if (_player) {
@@ -11,12 +15,34 @@ PlayerCard::PlayerCard(Player* player, NameTapCallback onNameTap)
 
 void PlayerCard::setPlayer(Player* player) {
     _player = player;
+    cancelTouch();
     if (_player) {
         _lastLife = _player->life;
     }
     setDirty();
 }
 
+void PlayerCard::setCommitOnPress(bool enabled) {
+    s_commitOnPress = enabled;
+}
+
+bool PlayerCard::commitOnPress() {
+    return s_commitOnPress;
+}
+
+void PlayerCard::cancelTouch() {
+    _drag.end();
+    _repeat.cancel();
+    _holdButton = -1;
+    _applied = false;
+    _down = false;
+    _dragDelta = 0;
+    if (_previewDelta != 0) {
+        _previewDelta = 0;
+        setDirty();
+    }
+}
+
 Rect PlayerCard::getNameRect() const {
     return Rect(_bounds.x, _bounds.y, _bounds.w, NAME_HEIGHT);
 }
@@ -72,6 +98,15 @@ Rect PlayerCard::getButtonRect(int index) const {
     }
 }
 
+int PlayerCard::buttonAt(int16_t x, int16_t y) const {
+    for (int i = 0; i < 4; i++) {
+        if (getButtonRect(i).contains(x, y)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 void PlayerCard::drawButton(M5GFX* gfx, Rect r, const char* label) {
     // Draw button with 2px border for better visibility
     gfx->drawRect(r.x, r.y, r.w, r.h, TFT_BLACK);
@@ -107,13 +142,19 @@ void PlayerCard::draw(M5GFX* gfx) {
     gfx->drawString(_player->name, nameR.x + nameR.w / 2, nameR.y + nameR.h / 2);
     gfx->drawLine(nameR.x, nameR.y + nameR.h, nameR.x + nameR.w, nameR.y + nameR.h, TFT_BLACK);
 
-    // Life total - LARGE
+    // Life total - LARGE. During a drag, the life it would commit and the
+    // change underneath.
     Rect lifeR = getLifeRect();
     char lifeStr[8];
-    snprintf(lifeStr, sizeof(lifeStr), "%d", _player->life);
+    snprintf(lifeStr, sizeof(lifeStr), "%d", _player->lifeAfter(_previewDelta));
     gfx->setTextDatum(MC_DATUM);
     gfx->setTextSize(4);  // Large text for life
     gfx->drawString(lifeStr, lifeR.x + lifeR.w / 2, lifeR.y + lifeR.h / 2);
+    if (_previewDelta != 0) {
+        snprintf(lifeStr, sizeof(lifeStr), "%+d", _previewDelta);
+        gfx->setTextSize(2);
+        gfx->drawString(lifeStr, lifeR.x + lifeR.w / 2, lifeR.y + lifeR.h / 2 + 36);
+    }
 
     // Buttons
     gfx->setTextColor(TFT_BLACK);
@@ -126,16 +167,48 @@ void PlayerCard::draw(M5GFX* gfx) {
 }
 
 bool PlayerCard::handleTouch(int16_t x, int16_t y, bool pressed, bool released) {
-    if (!_player || !contains(x, y))
+    if (!_player)
         return false;
-    if (!released)
+    if (_drag.active())
+        return handleDrag(x, y, released);
+    if (!contains(x, y)) {
+        if (released)
+            _down = false;
+        if (!_repeat.active() && !_applied)
+            return false;
+        // A held touch that leaves the card stops repeating
+        _repeat.cancel();
+        _holdButton = -1;
+        if (released)
+            _applied = false;
+        return true;
+    }
+    if (!released) {
+        bool touchDown = pressed && !_down;
+        _down = pressed;
+        if (pressed && getLifeRect().contains(x, y)) {
+            _drag.press(x, y);
+        } else if (pressed) {
+            handleHold(x, y, touchDown);
+        }
         return pressed;
+    }
+
+    // The release ends a hold; after a repeat or a touch-down commit it is
+    // not also a tap
+    bool applied = _applied;
+    _repeat.cancel();
+    _holdButton = -1;
+    _applied = false;
+    _down = false;
 
     // Debounce
     uint32_t now = millis();
     if (now - _lastTouchTime < DEBOUNCE_MS)
         return true;
     _lastTouchTime = now;
+    if (applied)
+        return true;
 
     // Check name tap
     Rect nameR = getNameRect();
@@ -148,20 +221,95 @@ bool PlayerCard::handleTouch(int16_t x, int16_t y, bool pressed, bool released)
     }
 
     // Check buttons
-    static const int16_t deltas[] = {-5, -1, 1, 5};
-    for (int i = 0; i < 4; i++) {
-        Rect btnR = getButtonRect(i);
-        if (btnR.contains(x, y)) {
-            _player->adjustLife(deltas[i]);
-            if (deltas[i] > 0) {
-                Sound::lifeUp();
-            } else {
-                Sound::lifeDown();
+    int button = buttonAt(x, y);
+    if (button >= 0) {
+        applyLife(LIFE_DELTAS[button]);
+    }
+
+    return true;
+}
+
+void PlayerCard::applyLife(int16_t delta) {
+    _player->adjustLife(delta);
+    if (delta > 0) {
+        Sound::lifeUp();
+    } else {
+        Sound::lifeDown();
+    }
+    setDirty();
+}
+
+// Press-and-hold on a life button repeats it, growing to 5 and then 10
+// points a step (a +/-5 button never steps less than 5). Steps are at
+// least one refresh interval apart, so each one costs a single frame.
+// Sliding off the button stops the repeat. In touch-down mode the tap
+// itself lands here, on the first event of the touch.
+void PlayerCard::handleHold(int16_t x, int16_t y, bool touchDown) {
+    uint32_t now = millis();
+    int button = buttonAt(x, y);
+    if (button != _holdButton) {
+        _holdButton = button;
+        if (button >= 0) {
+            _repeat.press(now);
+            if (touchDown && s_commitOnPress) {
+                if (now - _lastTouchTime >= DEBOUNCE_MS) {
+                    _lastTouchTime = now;
+                    applyLife(LIFE_DELTAS[button]);
+                }
+                _applied = true;  // A bounce too, so its release does not commit it
             }
+        } else {
+            _repeat.cancel();
+        }
+        return;
+    }
+    if (button < 0)
+        return;
+
+    uint32_t intervalMs = AutoRepeat::INTERVAL_MS;
+    if (Power::profileConfig().minRefreshMs > intervalMs) {
+        intervalMs = Power::profileConfig().minRefreshMs;
+    }
+    int16_t step = _repeat.update(now, intervalMs);
+    if (step == 0)
+        return;
+    int16_t delta = LIFE_DELTAS[button];
+    int16_t size = delta < 0 ? -delta : delta;
+    if (step > size) {
+        size = step;
+    }
+    applyLife(delta < 0 ? -size : size);
+    _applied = true;
+}
+
+// Follows a touch that started on the life area. The change is previewed
+// while the finger moves, throttled to PREVIEW_MS, and applied once on
+// release with a single sound and redraw. A touch that never passed the
+// drag slop is a tap on the life total, which does nothing.
+bool PlayerCard::handleDrag(int16_t x, int16_t y, bool released) {
+    _drag.move(x, y);
+    _dragDelta = _drag.steps(DRAG_PX_PER_POINT);
+
+    if (released) {
+        _drag.end();
+        _down = false;
+        if (_dragDelta != 0) {
+            applyLife(_dragDelta);
+        }
+        if (_previewDelta != 0) {
             setDirty();
-            return true;
         }
+        _dragDelta = 0;
+        _previewDelta = 0;
+        _lastTouchTime = millis();
+        return true;
     }
 
+    uint32_t now = millis();
+    if (_dragDelta != _previewDelta && now - _lastPreviewMs >= PREVIEW_MS) {
+        _previewDelta = _dragDelta;
+        _lastPreviewMs = now;
+        setDirty();
+    }
     return true;
 }
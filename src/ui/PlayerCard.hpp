@@ -1,12 +1,14 @@
 #pragma once
 
-#include <functional>
 #include "../models/Player.hpp"
+#include "../utils/AutoRepeat.hpp"
+#include "../utils/DragGesture.hpp"
+#include "../utils/InlineFunction.hpp"
 #include "Component.hpp"
 
 class PlayerCard : public Component {
    public:
-    using NameTapCallback = std::function<void()>;
+    using NameTapCallback = InlineFunction<void()>;
 
     PlayerCard(Player* player, NameTapCallback onNameTap = nullptr);
 
@@ -16,6 +18,14 @@ class PlayerCard : public Component {
     void setPlayer(Player* player);
     Player* getPlayer() { return _player; }
 
+    // Abandons a drag or hold in progress, without applying it
+    void cancelTouch();
+
+    // Life buttons act on touch-down instead of release (Settings::lifeOnTouchDown).
+    // The new total is then the only refresh a tap costs, one tap-length sooner.
+    static void setCommitOnPress(bool enabled);
+    static bool commitOnPress();
+
    private:
     // Horizontal layout (wider cards)
     static constexpr int16_t BUTTON_HEIGHT = 48;
@@ -29,17 +39,33 @@ class PlayerCard : public Component {
 
     static constexpr int16_t NAME_HEIGHT = 56;
     static constexpr uint32_t DEBOUNCE_MS = 100;
+    // Swipe on the life area: one point per step of drag, up to gain life
+    static constexpr int16_t DRAG_PX_PER_POINT = 12;
+    // The preview redraws at most this often; the release always redraws
+    static constexpr uint32_t PREVIEW_MS = 200;
 
     Player* _player;
     NameTapCallback _onNameTap;
     int16_t _lastLife = 0;
     uint32_t _lastTouchTime = 0;
+    DragGesture _drag;
+    int16_t _dragDelta = 0;     // Change the drag would commit now
+    int16_t _previewDelta = 0;  // Change shown on the card
+    uint32_t _lastPreviewMs = 0;
+    AutoRepeat _repeat;
+    int _holdButton = -1;   // Life button under a held touch
+    bool _applied = false;   // The current touch changed life already; its release is not a tap
+    bool _down = false;      // A touch is down on the card
 
     bool useStackedLayout() const { return _bounds.w < NARROW_THRESHOLD; }
 
     Rect getNameRect() const;
     Rect getLifeRect() const;
     Rect getButtonRect(int index) const;  // 0=-5, 1=-1, 2=+1, 3=+5
+    int buttonAt(int16_t x, int16_t y) const;  // -1 when none
 
     void drawButton(M5GFX* gfx, Rect r, const char* label);
+    bool handleDrag(int16_t x, int16_t y, bool released);
+    void handleHold(int16_t x, int16_t y, bool touchDown);
+    void applyLife(int16_t delta);
 };
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <M5GFX.h>
+#include "../utils/MemoryLedger.hpp"
+#include "../utils/TouchPoint.hpp"
 
 class Screen {
    public:
@@ -9,6 +11,9 @@ class Screen {
     // Screen identification for save/restore
     virtual const char* screenId() const { return "main"; }
 
+    // Heap this screen may allocate while active (checked by Memory::sampleScope)
+    virtual MemoryBudget memoryBudget() const { return {DEFAULT_INTERNAL_BUDGET, 0}; }
+
     // Lifecycle
     virtual void onEnter() {}
     virtual void onExit() {}
@@ -28,9 +33,26 @@ class Screen {
         return false;
     }
 
+    // Every touch point from Navigation. Screens are single-touch unless they
+    // override this: only the primary point reaches handleTouch().
+    virtual bool handleTouchPoint(const TouchPoint& point) {
+        if (!point.primary) {
+            return false;
+        }
+        return handleTouch(point.x, point.y, point.pressed, point.released);
+    }
+
     void setNeedsFullRedraw(bool needs = true) { _needsFullRedraw = needs; }
     bool needsFullRedraw() const { return _needsFullRedraw; }
 
+    // Set after a warm wake: the EPD still shows this screen, so the next full
+    // redraw repaints the framebuffer without clearing the panel first
+    void setPanelRetained(bool retained) { _panelRetained = retained; }
+    bool panelRetained() const { return _panelRetained; }
+
    protected:
+    static constexpr uint32_t DEFAULT_INTERNAL_BUDGET = 1024;
+
     bool _needsFullRedraw = true;
+    bool _panelRetained = false;
 };
@@ -1,47 +1,31 @@
 #include "Toolbar.hpp"
 #include <M5Unified.h>
 #include <WiFi.h>
+#include "../utils/Battery.hpp"
 #include "Layout.hpp"
 
 Toolbar::Toolbar() : Component(Rect(0, 0, Layout::screenW(), HEIGHT)) {}
 
 void Toolbar::update() {
-    int8_t rawBattery = M5.Power.getBatteryLevel();
-
-    // Apply moving average to smooth battery readings
-    int8_t smoothedBattery = _batteryLevel;
-    if (rawBattery >= 0) {
-        _batterySamples[_batterySampleIndex] = rawBattery;
-        _batterySampleIndex = (_batterySampleIndex + 1) % BATTERY_SAMPLE_COUNT;
-
-        if (!_batterySamplesInitialized) {
-            // Fill all samples with first reading
-            for (int i = 0; i < BATTERY_SAMPLE_COUNT; i++) {
-                _batterySamples[i] = rawBattery;
-            }
-            _batterySamplesInitialized = true;
-            smoothedBattery = rawBattery;
-        } else {
-            // Calculate average
-            int32_t sum = 0;
-            for (int i = 0; i < BATTERY_SAMPLE_COUNT; i++) {
-                sum += _batterySamples[i];
-            }
-            smoothedBattery = (sum + BATTERY_SAMPLE_COUNT / 2) / BATTERY_SAMPLE_COUNT;
-        }
-    }
-
-    // Apply hysteresis - only update if change exceeds threshold
+    // Battery filters and predicts; hysteresis here only limits redraws
+    int8_t level = Battery::percent();
     bool batteryChanged = false;
-    if (_batteryLevel < 0 && smoothedBattery >= 0) {
+    if (_batteryLevel < 0 && level >= 0) {
         batteryChanged = true;  // First valid reading
-    } else if (smoothedBattery >= 0) {
-        int diff = smoothedBattery - _batteryLevel;
+    } else if (level >= 0) {
+        int diff = level - _batteryLevel;
         if (diff < 0)
             diff = -diff;
         batteryChanged = (diff >= BATTERY_HYSTERESIS);
     }
 
+    // Estimate shown to 10 minutes, so it changes rarely
+    int32_t minutes = Battery::minutesRemaining();
+    if (minutes > MAX_REMAINING_MINUTES) {
+        minutes = MAX_REMAINING_MINUTES;
+    }
+    int16_t newRemaining = minutes < 0 ? -1 : static_cast<int16_t>((minutes + 5) / 10 * 10);
+
     auto dt = M5.Rtc.getDateTime();
     uint8_t newHour = dt.time.hours;
     uint8_t newMinute = dt.time.minutes;
@@ -63,11 +47,13 @@ void Toolbar::update() {
             newWifiStrength = 1;  // Very weak but connected
     }
 
-    if (batteryChanged || newHour != _hour || newMinute != _minute ||
-        newWifiConnected != _wifiConnected || newWifiStrength != _wifiStrength) {
+    if (batteryChanged || newRemaining != _minutesRemaining || newHour != _hour ||
+        newMinute != _minute || newWifiConnected != _wifiConnected ||
+        newWifiStrength != _wifiStrength) {
         if (batteryChanged) {
-            _batteryLevel = smoothedBattery;
+            _batteryLevel = level;
         }
+        _minutesRemaining = newRemaining;
         _hour = newHour;
         _minute = newMinute;
         _wifiConnected = newWifiConnected;
@@ -127,11 +113,17 @@ void Toolbar::draw(M5GFX* gfx) {
     gfx->setTextDatum(MC_DATUM);
     gfx->drawString(wifiStr, x + w / 2 + 120, y + h / 2);
 
-    // Right: Battery bar + percentage (right-aligned)
-    // Format: [####--] 67%
+    // Right: time remaining + battery bar + percentage (right-aligned)
+    // Format: ~3h20m [####--] 67%
     gfx->setTextDatum(MR_DATUM);
 
-    char battStr[24];
+    char remainingStr[12] = "";
+    if (_minutesRemaining >= 0 && _batteryLevel >= 0) {
+        snprintf(remainingStr, sizeof(remainingStr), "~%dh%02dm ", _minutesRemaining / 60,
+                 _minutesRemaining % 60);
+    }
+
+    char battStr[36];
     if (_batteryLevel >= 0) {
         // Build 6-character bar: # for filled, - for empty
         int filled = (_batteryLevel * 6 + 50) / 100;  // Round to nearest
@@ -145,7 +137,7 @@ void Toolbar::draw(M5GFX* gfx) {
             bar[i] = (i < filled) ? '#' : '-';
         }
         bar[6] = '\0';
-        snprintf(battStr, sizeof(battStr), "[%s] %d%%", bar, _batteryLevel);
+        snprintf(battStr, sizeof(battStr), "%s[%s] %d%%", remainingStr, bar, _batteryLevel);
     } else {
         snprintf(battStr, sizeof(battStr), "[------] --%%");
     }
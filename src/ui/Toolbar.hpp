@@ -14,13 +14,11 @@ class Toolbar : public Component {
     void update();  // Call to refresh battery/time readings
 
    private:
-    static constexpr int BATTERY_SAMPLE_COUNT = 8;
     static constexpr int BATTERY_HYSTERESIS = 2;  // Only update display if change >= 2%
+    static constexpr int16_t MAX_REMAINING_MINUTES = 99 * 60 + 50;
 
-    int8_t _batteryLevel = -1;  // Displayed battery level
-    int16_t _batterySamples[BATTERY_SAMPLE_COUNT] = {0};
-    uint8_t _batterySampleIndex = 0;
-    bool _batterySamplesInitialized = false;
+    int8_t _batteryLevel = -1;        // Displayed battery level
+    int16_t _minutesRemaining = -1;  // Displayed estimate, rounded to 10 minutes
 
     uint8_t _hour = 0;
     uint8_t _minute = 0;
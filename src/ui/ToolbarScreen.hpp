@@ -1,47 +1,107 @@
 #pragma once
 
+#include "../utils/Energy.hpp"
+#include "../utils/Metrics.hpp"
+#include "../utils/Power.hpp"
+#include "../utils/Trace.hpp"
+#include "Layout.hpp"
 #include "Screen.hpp"
 #include "Toolbar.hpp"
 
 class ToolbarScreen : public Screen {
    public:
     void update() override {
-        _toolbar.update();
+        if (Power::pollingEnabled() && toolbarPollDue()) {
+            _toolbar.update();
+        }
         onUpdate();
     }
 
     void draw(M5GFX* gfx) override {
+        uint32_t startUs = micros();
         bool needsDisplay = false;
 
         if (needsFullRedraw()) {
-            gfx->fillScreen(TFT_WHITE);
+            // Content matching the retained image leaves those EPD pixels untouched
+            if (!panelRetained()) {
+                gfx->fillScreen(TFT_WHITE);
+            }
+            setPanelRetained(false);
             setNeedsFullRedraw(false);
             _toolbar.setDirty(true);
             onFullRedraw(gfx);
+            markRefreshed(Rect(0, 0, Layout::screenW(), Layout::screenH()));
             needsDisplay = true;
         }
 
         if (_toolbar.isDirty()) {
             _toolbar.draw(gfx);
+            markRefreshed(_toolbar.getBounds());
             needsDisplay = true;
         }
 
+        uint16_t marks = _refreshMarks;
         if (onDraw(gfx)) {
+            // Screens that do not report what they drew are charged the full panel
+            if (_refreshMarks == marks) {
+                markRefreshed(Rect(0, 0, Layout::screenW(), Layout::screenH()));
+            }
             needsDisplay = true;
         }
 
+        // Saver defers refreshes that follow too closely; the drawn content
+        // stays in the framebuffer and goes out with the next allowed one
         if (needsDisplay) {
+            _displayPending = true;
+            _pendingRenderUs += micros() - startUs;
+        }
+        if (_displayPending && Power::refreshAllowed()) {
+            TRACE_SCOPE("display");
+            bool fullScreen =
+                _refreshArea.w >= Layout::screenW() && _refreshArea.h >= Layout::screenH();
+            uint32_t presentStartUs = micros();
             gfx->display();
+            uint32_t presentUs = micros() - presentStartUs;
+            Power::onRefresh();
+            Energy::onRefresh(static_cast<uint32_t>(_refreshArea.w) * _refreshArea.h);
+            Metrics::onFrame(_pendingRenderUs, presentUs, fullScreen);
+            _refreshArea = Rect();
+            _pendingRenderUs = 0;
+            _displayPending = false;
         }
     }
 
    protected:
     Toolbar _toolbar;
 
+    // Record an area drawn for the next refresh, for energy accounting
+    void markRefreshed(const Rect& area) {
+        _refreshArea = _refreshArea.unite(area);
+        _refreshMarks++;
+    }
+
     virtual void onUpdate() {}
     virtual void onFullRedraw(M5GFX* gfx) { (void)gfx; }
     virtual bool onDraw(M5GFX* gfx) {
         (void)gfx;
         return false;
     }
+
+   private:
+    bool _displayPending = false;
+    uint32_t _pendingRenderUs = 0;  // Drawing time of the frames in the pending refresh
+    Rect _refreshArea;  // Bounding box, as the EPD refreshes it
+    uint16_t _refreshMarks = 0;
+    bool _toolbarPolled = false;
+    uint32_t _lastToolbarPollMs = 0;
+
+    bool toolbarPollDue() {
+        uint32_t now = millis();
+        if (_toolbarPolled && now - _lastToolbarPollMs < Power::profileConfig().toolbarPollMs) {
+            return false;
+        }
+        _toolbarPolled = true;
+        _lastToolbarPollMs = now;
+        return true;
+    }
 };
@@ -0,0 +1,81 @@
+#include "AllocTracker.hpp"
+
+namespace AllocTracker {
+
+// Relaxed atomics: WiFi and the log drain allocate from other tasks
+static uint32_t allocCount = 0;
+static uint32_t freeCount = 0;
+static uint64_t allocBytes = 0;
+
+bool enabled() {
+#if defined(ALLOC_TRACK) || defined(NATIVE_TEST)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void onAlloc(size_t bytes) {
+    __atomic_fetch_add(&allocCount, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&allocBytes, static_cast<uint64_t>(bytes), __ATOMIC_RELAXED);
+}
+
+void onFree() {
+    __atomic_fetch_add(&freeCount, 1, __ATOMIC_RELAXED);
+}
+
+Counts total() {
+    Counts c;
+    c.allocs = __atomic_load_n(&allocCount, __ATOMIC_RELAXED);
+    c.frees = __atomic_load_n(&freeCount, __ATOMIC_RELAXED);
+    c.bytes = __atomic_load_n(&allocBytes, __ATOMIC_RELAXED);
+    return c;
+}
+
+}  // namespace AllocTracker
+
+#if defined(ALLOC_TRACK) && !defined(NATIVE_TEST)
+// Link-time wrappers (-Wl,--wrap=malloc,...): every reference to malloc,
+// including libstdc++'s operator new and the Arduino String, lands here
+extern "C" {
+void* __real_malloc(size_t size);
+void __real_free(void* ptr);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    void* ptr = __real_malloc(size);
+    if (ptr) {
+        AllocTracker::onAlloc(size);
+    }
+    return ptr;
+}
+
+void __wrap_free(void* ptr) {
+    if (ptr) {
+        AllocTracker::onFree();
+    }
+    __real_free(ptr);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    void* ptr = __real_calloc(count, size);
+    if (ptr) {
+        AllocTracker::onAlloc(count * size);
+    }
+    return ptr;
+}
+
+// A resize counts as a new allocation (and a free when it had a block)
+void* __wrap_realloc(void* ptr, size_t size) {
+    void* out = __real_realloc(ptr, size);
+    if (out && size > 0) {
+        AllocTracker::onAlloc(size);
+    }
+    if (ptr && (out || size == 0)) {
+        AllocTracker::onFree();
+    }
+    return out;
+}
+}
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocation counting. The hooks that feed it:
+// - ALLOC_TRACK device builds wrap the malloc family at link time
+//   (-Wl,--wrap, see platformio.ini), which also catches operator new,
+//   String and library allocations
+// - the native test binaries call it from their global operator new/delete
+// - Memory::allocate()/release() count their heap_caps calls directly
+// Navigation attributes the counts to the screen on top (MemoryLedger);
+// AllocScope counts a block of code.
+namespace AllocTracker {
+
+struct Counts {
+    uint32_t allocs;
+    uint32_t frees;
+    uint64_t bytes;  // Requested, not live
+};
+
+// True when this build has allocation hooks
+bool enabled();
+
+void onAlloc(size_t bytes);
+void onFree();
+
+Counts total();
+
+}  // namespace AllocTracker
+
+// Allocations made since construction
+class AllocScope {
+   public:
+    AllocScope() : _start(AllocTracker::total()) {}
+
+    AllocTracker::Counts counts() const {
+        AllocTracker::Counts now = AllocTracker::total();
+        return {now.allocs - _start.allocs, now.frees - _start.frees, now.bytes - _start.bytes};
+    }
+
+    uint32_t allocs() const { return AllocTracker::total().allocs - _start.allocs; }
+
+   private:
+    AllocTracker::Counts _start;
+};
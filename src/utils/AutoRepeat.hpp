@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+
+// Press-and-hold repeat with acceleration. press() when the hold starts,
+// then update() on every held touch event: after DELAY_MS the first step is
+// due, then one every interval. Steps grow 1 -> 5 -> 10, STEPS_PER_STAGE
+// repeats each. The next step is scheduled from when the last one fired, so
+// a slow loop never fires a burst. Pure logic on a caller-supplied clock.
+class AutoRepeat {
+   public:
+    static constexpr uint32_t DELAY_MS = 500;
+    static constexpr uint32_t INTERVAL_MS = 250;
+    static constexpr uint8_t STEPS_PER_STAGE = 4;
+
+    bool active() const { return _active; }
+    uint16_t repeats() const { return _repeats; }
+
+    void press(uint32_t now) {
+        _active = true;
+        _repeats = 0;
+        _nextMs = now + DELAY_MS;
+    }
+
+    void cancel() { _active = false; }
+
+    // Step due at now, or 0. At most one step per call.
+    int16_t update(uint32_t now, uint32_t intervalMs = INTERVAL_MS) {
+        if (!_active || static_cast<int32_t>(now - _nextMs) < 0) {
+            return 0;
+        }
+        int16_t step = stepFor(_repeats);
+        if (_repeats < UINT16_MAX) {
+            _repeats++;
+        }
+        _nextMs = now + intervalMs;
+        return step;
+    }
+
+    static int16_t stepFor(uint16_t repeat) {
+        if (repeat < STEPS_PER_STAGE) {
+            return 1;
+        }
+        return repeat < 2 * STEPS_PER_STAGE ? 5 : 10;
+    }
+
+   private:
+    bool _active = false;
+    uint16_t _repeats = 0;
+    uint32_t _nextMs = 0;
+};
@@ -0,0 +1,128 @@
+#include "Battery.hpp"
+#include <M5Unified.h>
+#include <Preferences.h>
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include "Power.hpp"
+#include "Trace.hpp"
+
+namespace Battery {
+
+static const char* NVS_NAMESPACE = "battery";
+static const char* KEY_COEFFICIENTS = "coef";
+
+// Learning is slow, so a lost half hour costs little; this bounds NVS wear
+static constexpr uint32_t SAVE_INTERVAL_MS = 30 * 60 * 1000;
+
+static BatteryEstimator estimatorInstance;
+static uint32_t lastSaveMs = 0;
+static bool unsaved = false;
+
+static int8_t historyLevels[HISTORY_POINTS];
+static int historyCount = 0;
+static int historyNext = 0;
+static uint32_t lastHistoryMs = 0;
+
+// Plain data: survives deep sleep without a constructor wiping it
+RTC_DATA_ATTR static BatteryCoefficients rtcCoefficients;
+
+static void saveToNvs() {
+    TRACE_SCOPE_ARG("nvs.save", NVS_NAMESPACE);
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        LOG_W("Battery: NVS open failed");
+        return;
+    }
+    prefs.putBytes(KEY_COEFFICIENTS, &estimatorInstance.coefficients(),
+                   sizeof(BatteryCoefficients));
+    prefs.end();
+    Metrics::onNvsWrite();
+    lastSaveMs = millis();
+    unsaved = false;
+}
+
+void init(bool warmWake) {
+    estimatorInstance.reset();
+    lastSaveMs = millis();
+    unsaved = false;
+    historyCount = 0;
+    historyNext = 0;
+
+    if (warmWake && estimatorInstance.setCoefficients(rtcCoefficients)) {
+        return;
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, true)) {
+        return;  // First boot: priors until a window is learned
+    }
+    BatteryCoefficients stored;
+    if (prefs.getBytes(KEY_COEFFICIENTS, &stored, sizeof(stored)) == sizeof(stored) &&
+        estimatorInstance.setCoefficients(stored)) {
+        LOG_D("Battery: loaded coefficients %u/%u/%u",
+              stored.drainCentiPercentPerHour[0], stored.drainCentiPercentPerHour[1],
+              stored.drainCentiPercentPerHour[2]);
+    }
+    prefs.end();
+}
+
+void update() {
+    uint32_t now = millis();
+    if (!estimatorInstance.sampleDue(now)) {
+        return;
+    }
+
+    int8_t level = M5.Power.getBatteryLevel();
+    int16_t millivolts = M5.Power.getBatteryVoltage();
+    if (estimatorInstance.addSample(now, level, millivolts, Power::activeProfile())) {
+        PowerProfile profile = Power::activeProfile();
+        LOG_D("Battery: %s drain %u.%02u%%/h", PowerProfiles::config(profile).name,
+              estimatorInstance.drainCentiPercentPerHour(profile) / 100,
+              estimatorInstance.drainCentiPercentPerHour(profile) % 100);
+        unsaved = true;
+    }
+
+    if (percent() >= 0 && (historyCount == 0 || now - lastHistoryMs >= HISTORY_INTERVAL_MS)) {
+        historyLevels[historyNext] = percent();
+        historyNext = (historyNext + 1) % HISTORY_POINTS;
+        if (historyCount < HISTORY_POINTS) {
+            historyCount++;
+        }
+        lastHistoryMs = now;
+    }
+
+    if (unsaved && now - lastSaveMs >= SAVE_INTERVAL_MS) {
+        saveToNvs();
+    }
+}
+
+void save() {
+    rtcCoefficients = estimatorInstance.coefficients();
+    if (unsaved) {
+        saveToNvs();
+    }
+}
+
+int8_t percent() {
+    float level = estimatorInstance.level();
+    return level < 0 ? -1 : static_cast<int8_t>(level + 0.5f);
+}
+
+int32_t minutesRemaining() {
+    return estimatorInstance.minutesRemaining(Power::activeProfile());
+}
+
+const BatteryEstimator& estimator() {
+    return estimatorInstance;
+}
+
+int history(int8_t* out, int maxPoints) {
+    int count = historyCount < maxPoints ? historyCount : maxPoints;
+    int first = (historyNext - count + HISTORY_POINTS) % HISTORY_POINTS;
+    for (int i = 0; i < count; i++) {
+        out[i] = historyLevels[(first + i) % HISTORY_POINTS];
+    }
+    return count;
+}
+
+}  // namespace Battery
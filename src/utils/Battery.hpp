@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include "BatteryEstimator.hpp"
+
+namespace Battery {
+
+// Load learned coefficients: from RTC memory on a warm wake, otherwise NVS
+void init(bool warmWake);
+
+// Sample the PMIC when the estimator asks for it; call once per loop
+void update();
+
+// Persist coefficients to RTC memory and NVS (before sleep)
+void save();
+
+// Filtered level, -1 before the first reading
+int8_t percent();
+
+// Prediction for the active power profile, -1 when unknown or charging
+int32_t minutesRemaining();
+
+const BatteryEstimator& estimator();
+
+// Filtered level every HISTORY_INTERVAL_MS since boot, oldest first, for
+// the Diagnostics trend. Returns the number of points copied.
+static constexpr uint32_t HISTORY_INTERVAL_MS = 5 * 60 * 1000;
+static constexpr int HISTORY_POINTS = 24;  // Two hours
+int history(int8_t* out, int maxPoints);
+
+}  // namespace Battery
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstdint>
+#include "PowerProfile.hpp"
+
+// Learned discharge rates, persisted across boots. Plain data so it can be
+// stored with putBytes and kept in RTC memory.
+struct BatteryCoefficients {
+    uint32_t magic;
+    uint16_t drainCentiPercentPerHour[PowerProfiles::COUNT];  // 0 = not learned yet
+    uint16_t windows[PowerProfiles::COUNT];                   // Windows learned from
+};
+
+// Filters battery readings, learns the discharge rate of each power profile
+// and predicts the time remaining. Pure logic - fed readings by Battery on
+// device and by recorded traces in native tests.
+class BatteryEstimator {
+   public:
+    static constexpr uint32_t MAGIC = 0x42415431;  // "BAT1"
+
+    // Sample quickly while the filter settles or the battery is low, then slowly
+    static constexpr uint32_t SAMPLE_FAST_MS = 10 * 1000;
+    static constexpr uint32_t SAMPLE_SLOW_MS = 60 * 1000;
+    static constexpr int SETTLE_SAMPLES = 6;
+    static constexpr int LOW_PERCENT = 20;
+
+    // Exponential filter weight of a new reading
+    static constexpr float FILTER_ALPHA = 0.15f;
+
+    // A learning window closes after this drop and at least this long in one profile
+    static constexpr float WINDOW_DROP_PERCENT = 2.0f;
+    static constexpr uint32_t MIN_WINDOW_MS = 10 * 60 * 1000;
+
+    // Rise of the filtered level that means the charger is connected
+    static constexpr float CHARGE_RISE_PERCENT = 1.0f;
+
+    BatteryEstimator() { reset(); }
+
+    void reset() {
+        _coefficients.magic = MAGIC;
+        for (int i = 0; i < PowerProfiles::COUNT; i++) {
+            _coefficients.drainCentiPercentPerHour[i] = 0;
+            _coefficients.windows[i] = 0;
+        }
+        _samples = 0;
+        _level = -1.0f;
+        _millivolts = 0.0f;
+        _charging = false;
+        _lastSampleMs = 0;
+    }
+
+    // Ignored unless the magic matches
+    bool setCoefficients(const BatteryCoefficients& coefficients) {
+        if (coefficients.magic != MAGIC) {
+            return false;
+        }
+        _coefficients = coefficients;
+        return true;
+    }
+
+    const BatteryCoefficients& coefficients() const { return _coefficients; }
+
+    uint32_t sampleIntervalMs() const {
+        bool fast = _samples < SETTLE_SAMPLES || _charging || _level <= LOW_PERCENT;
+        return fast ? SAMPLE_FAST_MS : SAMPLE_SLOW_MS;
+    }
+
+    bool sampleDue(uint32_t nowMs) const {
+        return _samples == 0 || nowMs - _lastSampleMs >= sampleIntervalMs();
+    }
+
+    // Feed one reading; percent < 0 means unavailable. Returns true when a
+    // learning window closed and the coefficients changed.
+    bool addSample(uint32_t nowMs, int8_t percent, int16_t millivolts, PowerProfile profile) {
+        _lastSampleMs = nowMs;
+        if (percent < 0) {
+            return false;
+        }
+
+        if (_samples == 0) {
+            _level = percent;
+            _millivolts = millivolts;
+            startWindow(nowMs, profile);
+        } else {
+            _level += FILTER_ALPHA * (percent - _level);
+            _millivolts += FILTER_ALPHA * (millivolts - _millivolts);
+        }
+        if (_samples < UINT16_MAX) {
+            _samples++;
+        }
+
+        // A window only measures one profile
+        if (profile != _windowProfile) {
+            startWindow(nowMs, profile);
+            return false;
+        }
+
+        if (_level - _windowLevel >= CHARGE_RISE_PERCENT) {
+            _charging = true;
+            startWindow(nowMs, profile);
+            return false;
+        }
+        if (_charging) {
+            // Follow the peak; a clear drop means the charger was unplugged
+            if (_level > _windowLevel) {
+                startWindow(nowMs, profile);
+            } else if (_windowLevel - _level >= CHARGE_RISE_PERCENT) {
+                _charging = false;
+                startWindow(nowMs, profile);
+            }
+            return false;
+        }
+
+        float drop = _windowLevel - _level;
+        uint32_t elapsed = nowMs - _windowStartMs;
+        if (drop < WINDOW_DROP_PERCENT || elapsed < MIN_WINDOW_MS) {
+            return false;
+        }
+        learn(profile, drop * 100.0f * 3600000.0f / elapsed);
+        startWindow(nowMs, profile);
+        return true;
+    }
+
+    // Filtered level in percent, -1 before the first reading
+    float level() const { return _level; }
+    int16_t millivolts() const { return static_cast<int16_t>(_millivolts + 0.5f); }
+    bool charging() const { return _charging; }
+
+    bool learned(PowerProfile profile) const {
+        return _coefficients.drainCentiPercentPerHour[index(profile)] != 0;
+    }
+
+    // Learned rate, or a conservative prior until the first window closes
+    uint16_t drainCentiPercentPerHour(PowerProfile profile) const {
+        uint16_t rate = _coefficients.drainCentiPercentPerHour[index(profile)];
+        return rate != 0 ? rate : priorCentiPercentPerHour(profile);
+    }
+
+    // -1 when unknown (no reading yet, or charging)
+    int32_t minutesRemaining(PowerProfile profile) const {
+        if (_level < 0 || _charging) {
+            return -1;
+        }
+        return static_cast<int32_t>(_level * 100.0f * 60.0f / drainCentiPercentPerHour(profile));
+    }
+
+   private:
+    BatteryCoefficients _coefficients;
+    uint16_t _samples;
+    float _level;
+    float _millivolts;
+    bool _charging;
+    uint32_t _lastSampleMs;
+
+    PowerProfile _windowProfile = PowerProfile::Balanced;
+    float _windowLevel = 0.0f;
+    uint32_t _windowStartMs = 0;
+
+    static int index(PowerProfile profile) { return static_cast<int>(profile); }
+
+    static uint16_t priorCentiPercentPerHour(PowerProfile profile) {
+        switch (profile) {
+            case PowerProfile::Performance:
+                return 1500;
+            case PowerProfile::Saver:
+                return 500;
+            default:
+                return 1000;
+        }
+    }
+
+    void startWindow(uint32_t nowMs, PowerProfile profile) {
+        _windowProfile = profile;
+        _windowLevel = _level;
+        _windowStartMs = nowMs;
+    }
+
+    // Running mean over the first windows, then an exponential average that
+    // follows battery ageing
+    void learn(PowerProfile profile, float centiPercentPerHour) {
+        int i = index(profile);
+        uint16_t& rate = _coefficients.drainCentiPercentPerHour[i];
+        uint16_t& windows = _coefficients.windows[i];
+        float weight = windows < 4 ? 1.0f / (windows + 1) : 0.25f;
+        float updated = rate == 0 ? centiPercentPerHour
+                                  : rate + weight * (centiPercentPerHour - rate);
+        if (updated < 1.0f) {
+            updated = 1.0f;
+        } else if (updated > UINT16_MAX) {
+            updated = UINT16_MAX;
+        }
+        rate = static_cast<uint16_t>(updated + 0.5f);
+        if (windows < UINT16_MAX) {
+            windows++;
+        }
+    }
+};
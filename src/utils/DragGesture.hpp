@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+// Tells a vertical drag from a tap in the touch stream a component sees:
+// press() on touch-down, move() for every held or released event after it,
+// end() on release. The touch becomes a drag once it has travelled SLOP_PX
+// vertically (more than horizontally), so finger jitter on a tap is ignored.
+// Pure logic, no timing: the component owning it decides when to redraw.
+class DragGesture {
+   public:
+    static constexpr int16_t SLOP_PX = 16;
+
+    bool active() const { return _state != State::Idle; }
+    bool dragging() const { return _state == State::Dragging; }
+
+    void press(int16_t x, int16_t y) {
+        _state = State::Pressed;
+        _startX = x;
+        _startY = y;
+        _dy = 0;
+    }
+
+    void move(int16_t x, int16_t y) {
+        if (_state == State::Idle) {
+            return;
+        }
+        _dy = static_cast<int16_t>(y - _startY);
+        if (_state == State::Pressed) {
+            int16_t ady = _dy < 0 ? -_dy : _dy;
+            int16_t dx = static_cast<int16_t>(x - _startX);
+            int16_t adx = dx < 0 ? -dx : dx;
+            if (ady >= SLOP_PX && ady > adx) {
+                _state = State::Dragging;
+            }
+        }
+    }
+
+    void end() { _state = State::Idle; }
+
+    // Vertical travel since press(), positive downwards
+    int16_t dy() const { return _dy; }
+
+    // Whole steps of pxPerStep travelled while dragging, positive upwards
+    int16_t steps(int16_t pxPerStep) const {
+        if (!dragging() || pxPerStep <= 0) {
+            return 0;
+        }
+        return static_cast<int16_t>(-_dy / pxPerStep);
+    }
+
+   private:
+    enum class State : uint8_t { Idle, Pressed, Dragging };
+
+    State _state = State::Idle;
+    int16_t _startX = 0;
+    int16_t _startY = 0;
+    int16_t _dy = 0;
+};
@@ -0,0 +1,92 @@
+#include "Energy.hpp"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <cstdio>
+#include "Log.hpp"
+
+namespace Energy {
+
+static EnergyLedger ledgerInstance;
+static uint32_t lastUpdateMs = 0;
+static uint32_t sleptMs = 0;
+
+static const char* SUBSYSTEM_NAMES[EnergyLedgerConfig::SUBSYSTEM_COUNT] = {"EPD", "WiFi", "SPK",
+                                                                          "CPU", "SLP"};
+
+void init() {
+    lastUpdateMs = millis();
+    sleptMs = 0;
+}
+
+void update() {
+    uint32_t now = millis();
+    uint32_t elapsed = now - lastUpdateMs;
+    lastUpdateMs = now;
+
+    uint32_t slept = sleptMs < elapsed ? sleptMs : elapsed;
+    sleptMs = 0;
+    ledgerInstance.recordSleep(slept);
+    ledgerInstance.recordAwake(elapsed - slept, getCpuFrequencyMhz());
+    if (WiFi.getMode() != WIFI_OFF) {
+        ledgerInstance.recordWifi(elapsed);
+    }
+}
+
+void onRefresh(uint32_t pixels) {
+    ledgerInstance.recordRefresh(pixels);
+}
+
+void onSpeaker(uint32_t ms) {
+    ledgerInstance.recordSpeaker(ms);
+}
+
+void onSleep(uint32_t ms) {
+    sleptMs += ms;
+}
+
+EnergyLedger& ledger() {
+    return ledgerInstance;
+}
+
+void format(const EnergyTotals& totals, char* buf, size_t len) {
+    uint64_t total = totals.totalUc();
+    int written = snprintf(buf, len, "%lu.%01lumAh",
+                           static_cast<unsigned long>(total / EnergyLedger::UC_PER_MAH),
+                           static_cast<unsigned long>(total * 10 / EnergyLedger::UC_PER_MAH % 10));
+    for (int i = 0; i < EnergyLedgerConfig::SUBSYSTEM_COUNT && written > 0 &&
+                    static_cast<size_t>(written) < len;
+         i++) {
+        unsigned percent =
+            total ? static_cast<unsigned>((totals.chargeUc[i] * 100 + total / 2) / total) : 0;
+        written += snprintf(buf + written, len - written, " %s %u%%", SUBSYSTEM_NAMES[i], percent);
+    }
+}
+
+static void logTotals(const char* label, const EnergyTotals& totals) {
+    char summary[80];
+    format(totals, summary, sizeof(summary));
+    LOG_I("Energy %s: %s", label, summary);
+    LOG_I("  EPD %lu refreshes, %lu Mpx; WiFi %lus; SPK %lums",
+          static_cast<unsigned long>(totals.refreshes),
+          static_cast<unsigned long>(totals.refreshedPixels / 1000000),
+          static_cast<unsigned long>(totals.wifiMs / 1000),
+          static_cast<unsigned long>(totals.speakerMs));
+    LOG_I("  CPU awake 240MHz %lus, 160MHz %lus, 80MHz %lus; light sleep %lus",
+          static_cast<unsigned long>(totals.cpuMs[0] / 1000),
+          static_cast<unsigned long>(totals.cpuMs[1] / 1000),
+          static_cast<unsigned long>(totals.cpuMs[2] / 1000),
+          static_cast<unsigned long>(totals.sleepMs / 1000));
+}
+
+void startGame() {
+    logTotals("last game", ledgerInstance.game());
+    ledgerInstance.resetGame();
+}
+
+void logReport() {
+    update();
+    logTotals("this boot", ledgerInstance.boot());
+    logTotals("this game", ledgerInstance.game());
+}
+
+}  // namespace Energy
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "EnergyLedger.hpp"
+
+// Per-subsystem energy accounting; see EnergyLedger for the cost model
+namespace Energy {
+
+void init();
+
+// Charge the time since the last call to CPU, sleep and WiFi; call once per loop
+void update();
+
+// Event hooks
+void onRefresh(uint32_t pixels);
+void onSpeaker(uint32_t ms);
+void onSleep(uint32_t ms);  // Part of the time since the last update() spent in light sleep
+
+EnergyLedger& ledger();
+
+// Log the finished game's totals and start a new one
+void startGame();
+
+// One-line summary, e.g. "12.3mAh EPD 41% WiFi 0% SPK 2% CPU 52% SLP 5%"
+void format(const EnergyTotals& totals, char* buf, size_t len);
+
+// Dump per-boot and per-game totals over serial
+void logReport();
+
+}  // namespace Energy
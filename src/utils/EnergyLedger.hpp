@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+// Where the charge goes. Charge is kept in microcoulombs (mA x ms).
+enum class EnergySubsystem : uint8_t {
+    Display,  // EPD refreshes
+    Wifi,     // Radio on
+    Speaker,  // Tones
+    Cpu,      // Awake, by clock
+    Sleep,    // Light sleep floor
+};
+
+namespace EnergyLedgerConfig {
+static constexpr int SUBSYSTEM_COUNT = 5;
+static constexpr int CPU_CLOCKS = 3;  // 240, 160 and 80 MHz buckets
+}  // namespace EnergyLedgerConfig
+
+// Cost model. The defaults are estimates for the Paper S3, meant to be
+// replaced with figures from a USB power meter.
+struct EnergyCoefficients {
+    uint32_t refreshUc;    // Fixed cost of one EPD refresh
+    uint32_t megapixelUc;  // Extra cost per megapixel refreshed
+    uint16_t wifiMa;
+    uint16_t speakerMa;
+    uint16_t cpuMa[EnergyLedgerConfig::CPU_CLOCKS];  // Awake at 240/160/80 MHz
+    uint16_t sleepUa;                                // Board current in light sleep
+};
+
+struct EnergyTotals {
+    uint64_t chargeUc[EnergyLedgerConfig::SUBSYSTEM_COUNT];
+    uint32_t refreshes;
+    uint64_t refreshedPixels;
+    uint32_t wifiMs;
+    uint32_t speakerMs;
+    uint32_t cpuMs[EnergyLedgerConfig::CPU_CLOCKS];
+    uint32_t sleepMs;
+
+    uint64_t charge(EnergySubsystem subsystem) const {
+        return chargeUc[static_cast<int>(subsystem)];
+    }
+
+    uint64_t totalUc() const {
+        uint64_t total = 0;
+        for (int i = 0; i < EnergyLedgerConfig::SUBSYSTEM_COUNT; i++) {
+            total += chargeUc[i];
+        }
+        return total;
+    }
+};
+
+// Attributes estimated charge to each subsystem, per boot and per game.
+// Pure logic - fed events by Energy on device and directly in native tests.
+class EnergyLedger {
+   public:
+    static constexpr uint32_t UC_PER_MAH = 3600 * 1000;
+
+    static EnergyCoefficients defaultCoefficients() {
+        EnergyCoefficients c;
+        c.refreshUc = 15 * 1000;    // ~100mA for the ~150ms of a fast waveform
+        c.megapixelUc = 30 * 1000;  // Source drivers scale with the area
+        c.wifiMa = 60;              // Associated, modem sleep averaged in
+        c.speakerMa = 100;
+        c.cpuMa[0] = 45;
+        c.cpuMa[1] = 35;
+        c.cpuMa[2] = 25;
+        c.sleepUa = 2000;
+        return c;
+    }
+
+    EnergyLedger() : _coefficients(defaultCoefficients()) {
+        clear(_boot);
+        clear(_game);
+    }
+
+    void setCoefficients(const EnergyCoefficients& coefficients) { _coefficients = coefficients; }
+    const EnergyCoefficients& coefficients() const { return _coefficients; }
+
+    static int cpuClockIndex(uint32_t mhz) { return mhz >= 240 ? 0 : mhz >= 160 ? 1 : 2; }
+
+    void recordRefresh(uint32_t pixels) {
+        uint64_t uc = _coefficients.refreshUc +
+                      static_cast<uint64_t>(_coefficients.megapixelUc) * pixels / 1000000;
+        for (EnergyTotals* t : {&_boot, &_game}) {
+            t->refreshes++;
+            t->refreshedPixels += pixels;
+            t->chargeUc[static_cast<int>(EnergySubsystem::Display)] += uc;
+        }
+    }
+
+    void recordWifi(uint32_t ms) {
+        uint64_t uc = static_cast<uint64_t>(_coefficients.wifiMa) * ms;
+        for (EnergyTotals* t : {&_boot, &_game}) {
+            t->wifiMs += ms;
+            t->chargeUc[static_cast<int>(EnergySubsystem::Wifi)] += uc;
+        }
+    }
+
+    void recordSpeaker(uint32_t ms) {
+        uint64_t uc = static_cast<uint64_t>(_coefficients.speakerMa) * ms;
+        for (EnergyTotals* t : {&_boot, &_game}) {
+            t->speakerMs += ms;
+            t->chargeUc[static_cast<int>(EnergySubsystem::Speaker)] += uc;
+        }
+    }
+
+    void recordAwake(uint32_t ms, uint32_t cpuMhz) {
+        int clock = cpuClockIndex(cpuMhz);
+        uint64_t uc = static_cast<uint64_t>(_coefficients.cpuMa[clock]) * ms;
+        for (EnergyTotals* t : {&_boot, &_game}) {
+            t->cpuMs[clock] += ms;
+            t->chargeUc[static_cast<int>(EnergySubsystem::Cpu)] += uc;
+        }
+    }
+
+    void recordSleep(uint32_t ms) {
+        uint64_t uc = static_cast<uint64_t>(_coefficients.sleepUa) * ms / 1000;
+        for (EnergyTotals* t : {&_boot, &_game}) {
+            t->sleepMs += ms;
+            t->chargeUc[static_cast<int>(EnergySubsystem::Sleep)] += uc;
+        }
+    }
+
+    const EnergyTotals& boot() const { return _boot; }
+    const EnergyTotals& game() const { return _game; }
+    void resetGame() { clear(_game); }
+
+   private:
+    EnergyCoefficients _coefficients;
+    EnergyTotals _boot;
+    EnergyTotals _game;
+
+    static void clear(EnergyTotals& totals) { totals = EnergyTotals(); }
+};
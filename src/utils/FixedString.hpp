@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+// Inline, null-terminated string of at most MaxLen characters.
+// Longer input is truncated, never heap-allocated.
+template <size_t MaxLen>
+class FixedString {
+   public:
+    FixedString() = default;
+    FixedString(const char* str) { assign(str); }
+
+    void assign(const char* str) {
+        if (!str)
+            str = "";
+        strncpy(_data, str, MaxLen);
+        _data[MaxLen] = '\0';
+    }
+
+    FixedString& operator=(const char* str) {
+        assign(str);
+        return *this;
+    }
+
+    void clear() { _data[0] = '\0'; }
+
+    const char* c_str() const { return _data; }
+    // Writable buffer of capacity() + 1 bytes, e.g. for Preferences::getString()
+    char* data() { return _data; }
+
+    size_t length() const { return strlen(_data); }
+    bool empty() const { return _data[0] == '\0'; }
+    static constexpr size_t capacity() { return MaxLen; }
+
+    bool operator==(const char* other) const { return other && strcmp(_data, other) == 0; }
+    bool operator!=(const char* other) const { return !(*this == other); }
+    template <size_t N>
+    bool operator==(const FixedString<N>& other) const {
+        return strcmp(_data, other.c_str()) == 0;
+    }
+    template <size_t N>
+    bool operator!=(const FixedString<N>& other) const {
+        return !(*this == other);
+    }
+
+   private:
+    char _data[MaxLen + 1] = "";
+};
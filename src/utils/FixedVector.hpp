@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+
+// Inline array with a runtime size and a compile-time capacity.
+// Insertions beyond Capacity are rejected (return false), never heap-allocated.
+template <typename T, size_t Capacity>
+class FixedVector {
+   public:
+    size_t size() const { return _size; }
+    static constexpr size_t capacity() { return Capacity; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size >= Capacity; }
+    void clear() { _size = 0; }
+
+    bool push_back(const T& item) {
+        if (full())
+            return false;
+        _items[_size++] = item;
+        return true;
+    }
+
+    // Insert before index, shifting later items up
+    bool insert(size_t index, const T& item) {
+        if (full() || index > _size)
+            return false;
+        for (size_t i = _size; i > index; i--) {
+            _items[i] = _items[i - 1];
+        }
+        _items[index] = item;
+        _size++;
+        return true;
+    }
+
+    void erase(size_t index) {
+        if (index >= _size)
+            return;
+        for (size_t i = index; i + 1 < _size; i++) {
+            _items[i] = _items[i + 1];
+        }
+        _size--;
+    }
+
+    void pop_back() {
+        if (_size > 0)
+            _size--;
+    }
+
+    T& operator[](size_t index) { return _items[index]; }
+    const T& operator[](size_t index) const { return _items[index]; }
+    T& back() { return _items[_size - 1]; }
+    const T& back() const { return _items[_size - 1]; }
+
+    T* begin() { return _items; }
+    T* end() { return _items + _size; }
+    const T* begin() const { return _items; }
+    const T* end() const { return _items + _size; }
+
+   private:
+    T _items[Capacity] = {};
+    size_t _size = 0;
+};
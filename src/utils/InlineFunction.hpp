@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Fixed-capacity replacement for std::function used by UI callbacks.
+// The target is stored inline and never heap-allocated. Targets must be
+// trivially copyable (lambdas capturing pointers and integers), so copying
+// an InlineFunction is a plain byte copy and there is nothing to destroy.
+template <typename Signature, size_t Capacity = 2 * sizeof(void*)>
+class InlineFunction;
+
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+    template <typename F>
+    using Decayed = typename std::decay<F>::type;
+    template <typename F>
+    using IsTarget =
+        std::integral_constant<bool, !std::is_same<Decayed<F>, InlineFunction>::value &&
+                                         !std::is_same<Decayed<F>, std::nullptr_t>::value>;
+
+   public:
+    static constexpr size_t CAPACITY = Capacity;
+
+    InlineFunction() = default;
+    InlineFunction(std::nullptr_t) {}
+
+    template <typename F, typename = typename std::enable_if<IsTarget<F>::value>::type>
+    InlineFunction(F f) {
+        static_assert(sizeof(F) <= Capacity,
+                      "InlineFunction: capture does not fit - raise Capacity or capture less");
+        static_assert(alignof(F) <= alignof(void*), "InlineFunction: capture over-aligned");
+        static_assert(std::is_trivially_copyable<F>::value,
+                      "InlineFunction: capture must be trivially copyable (no String/std::string)");
+        ::new (static_cast<void*>(_storage)) F(f);
+        _invoke = &invokeTarget<F>;
+    }
+
+    InlineFunction& operator=(std::nullptr_t) {
+        _invoke = nullptr;
+        return *this;
+    }
+
+    explicit operator bool() const { return _invoke != nullptr; }
+
+    // Precondition: non-empty (callers check with operator bool, as with std::function)
+    R operator()(Args... args) const { return _invoke(_storage, std::forward<Args>(args)...); }
+
+   private:
+    using Invoker = R (*)(void*, Args...);
+
+    template <typename F>
+    static R invokeTarget(void* storage, Args... args) {
+        return (*static_cast<F*>(storage))(std::forward<Args>(args)...);
+    }
+
+    alignas(void*) mutable unsigned char _storage[Capacity] = {};
+    Invoker _invoke = nullptr;
+};
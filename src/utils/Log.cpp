@@ -0,0 +1,171 @@
+#include "Log.hpp"
+#include "LogRing.hpp"
+#include "Memory.hpp"
+
+#ifndef NATIVE_TEST
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#endif
+
+namespace Log {
+
+static constexpr size_t RING_BYTES = 8 * 1024;
+static constexpr uint32_t DRAIN_INTERVAL_MS = 20;
+static constexpr uint32_t DRAIN_TASK_STACK = 4096;
+static constexpr uint32_t DRAIN_TASK_PRIORITY = 1;  // Below the loop task on the other core
+
+#ifdef LOG_BINARY
+static constexpr bool BINARY = true;
+#else
+static constexpr bool BINARY = false;
+#endif
+
+// Wire frame: SYNC, type, u16 payload length, payload, u8 sum of type..payload
+static constexpr uint8_t FRAME_SYNC = 0xA5;
+static constexpr uint8_t FRAME_DEFINE = 'D';   // u16 id, format string
+static constexpr uint8_t FRAME_MESSAGE = 'M';  // u16 id, level, argc, u32 us, tagged args
+static constexpr uint8_t FRAME_RESET = 'R';    // Forget all ids
+static constexpr uint8_t FRAME_DROPPED = 'X';  // u32 records lost to a full ring
+
+static LogRing ring;
+
+#ifdef NATIVE_TEST
+static uint8_t hostStorage[RING_BYTES];
+#else
+static portMUX_TYPE producerLock = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t consumerLock = nullptr;
+#endif
+
+// Format strings already sent in binary mode; ids are indices
+static constexpr int DICTIONARY_SIZE = 128;
+static const char* dictionary[DICTIONARY_SIZE];
+static int dictionaryCount = 0;
+
+static void writeFrame(uint8_t type, const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen) {
+    uint16_t len = static_cast<uint16_t>(aLen + bLen);
+    uint8_t head[4] = {FRAME_SYNC, type, static_cast<uint8_t>(len), static_cast<uint8_t>(len >> 8)};
+    uint8_t sum = type + head[2] + head[3];
+    for (size_t i = 0; i < aLen; i++) {
+        sum += a[i];
+    }
+    for (size_t i = 0; i < bLen; i++) {
+        sum += b[i];
+    }
+    Serial.write(head, sizeof(head));
+    Serial.write(a, aLen);
+    if (bLen) {
+        Serial.write(b, bLen);
+    }
+    Serial.write(&sum, 1);
+}
+
+static uint16_t formatId(const char* format) {
+    for (int i = 0; i < dictionaryCount; i++) {
+        if (dictionary[i] == format) {
+            return static_cast<uint16_t>(i);
+        }
+    }
+    if (dictionaryCount == DICTIONARY_SIZE) {
+        writeFrame(FRAME_RESET, nullptr, 0, nullptr, 0);
+        dictionaryCount = 0;
+    }
+    uint16_t id = static_cast<uint16_t>(dictionaryCount);
+    dictionary[dictionaryCount++] = format;
+    uint8_t idBytes[2] = {static_cast<uint8_t>(id), static_cast<uint8_t>(id >> 8)};
+    writeFrame(FRAME_DEFINE, idBytes, sizeof(idBytes), reinterpret_cast<const uint8_t*>(format),
+               strlen(format));
+    return id;
+}
+
+static void emit(const uint8_t* rec, size_t len) {
+    LogRecord::Header h = LogRecord::readHeader(rec);
+    if (BINARY) {
+        uint16_t id = formatId(h.format);
+        uint8_t head[8] = {static_cast<uint8_t>(id), static_cast<uint8_t>(id >> 8), rec[0], rec[1]};
+        memcpy(head + 4, &h.timestampUs, sizeof(h.timestampUs));
+        writeFrame(FRAME_MESSAGE, head, sizeof(head), rec + LogRecord::HEADER_BYTES,
+                   len - LogRecord::HEADER_BYTES);
+        return;
+    }
+    char line[256];
+    LogRecord::format(rec, len, line, sizeof(line));
+    M5.Log.printf("[%c] %s\n", LogRecord::levelChar(h.level), line);
+}
+
+static void drain() {
+    uint32_t lost = ring.takeDropped();
+    if (lost) {
+        if (BINARY) {
+            writeFrame(FRAME_DROPPED, reinterpret_cast<const uint8_t*>(&lost), sizeof(lost),
+                       nullptr, 0);
+        } else {
+            M5.Log.printf("[W] Log: dropped %lu records\n", static_cast<unsigned long>(lost));
+        }
+    }
+
+    uint8_t rec[LogRecord::MAX_RECORD];
+    uint16_t len;
+    while ((len = ring.pop(rec, sizeof(rec))) > 0) {
+        if (len >= LogRecord::HEADER_BYTES) {
+            emit(rec, len);
+        }
+    }
+}
+
+#ifndef NATIVE_TEST
+static void drainTask(void*) {
+    for (;;) {
+        flush();
+        vTaskDelay(pdMS_TO_TICKS(DRAIN_INTERVAL_MS));
+    }
+}
+#endif
+
+void init() {
+    if (ring.attached()) {
+        return;
+    }
+#ifdef NATIVE_TEST
+    ring.attach(hostStorage, RING_BYTES);
+#else
+    uint8_t* storage = static_cast<uint8_t*>(Memory::allocate(RING_BYTES, Memory::Region::Psram));
+    if (!storage) {
+        return;  // Logging stays off; records are counted as dropped
+    }
+    consumerLock = xSemaphoreCreateMutex();
+    ring.attach(storage, RING_BYTES);
+    xTaskCreatePinnedToCore(drainTask, "log", DRAIN_TASK_STACK, nullptr, DRAIN_TASK_PRIORITY,
+                            nullptr, 0);
+#endif
+}
+
+void flush() {
+#ifdef NATIVE_TEST
+    drain();
+#else
+    if (!consumerLock) {
+        return;
+    }
+    xSemaphoreTake(consumerLock, portMAX_DELAY);
+    drain();
+    xSemaphoreGive(consumerLock);
+#endif
+}
+
+bool push(const uint8_t* record, size_t len) {
+#ifdef NATIVE_TEST
+    // No drain task on the host: attach on first use and write through
+    init();
+    bool ok = ring.push(record, static_cast<uint16_t>(len));
+    drain();
+    return ok;
+#else
+    portENTER_CRITICAL(&producerLock);
+    bool ok = ring.push(record, static_cast<uint16_t>(len));
+    portEXIT_CRITICAL(&producerLock);
+    return ok;
+#endif
+}
+
+}  // namespace Log
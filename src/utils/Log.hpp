@@ -1,15 +1,46 @@
 #pragma once
 
 #include <M5Unified.h>
+#include "LogRecord.hpp"
+
+// Logging is deferred: LOG_* encode the format string's address and the raw
+// arguments into a ring buffer, and a low-priority task formats and writes
+// them. Build with -DLOG_BINARY to stream binary frames instead and decode
+// them on the host with tools/logdecode/decode_log.py.
+namespace Log {
+
+// Allocate the ring and start the drain task; records made earlier are dropped
+void init();
+
+// Drain everything now - before sleep, or where output must not lag
+void flush();
+
+bool push(const uint8_t* record, size_t len);
+
+template <typename... Args>
+inline void write(LogRecord::Level level, const char* format, const Args&... args) {
+    uint8_t record[LogRecord::MAX_RECORD];
+    size_t len = LogRecord::encode(record, sizeof(record), level, micros(), format, args...);
+    push(record, len);
+}
+
+}  // namespace Log
+
+#define LOG_E(fmt, ...) Log::write(LogRecord::Level::Error, fmt, ##__VA_ARGS__)
 
 #ifdef DEBUG
-#define LOG_E(fmt, ...) M5.Log.printf("[E] " fmt "\n", ##__VA_ARGS__)
-#define LOG_W(fmt, ...) M5.Log.printf("[W] " fmt "\n", ##__VA_ARGS__)
-#define LOG_I(fmt, ...) M5.Log.printf("[I] " fmt "\n", ##__VA_ARGS__)
-#define LOG_D(fmt, ...) M5.Log.printf("[D] " fmt "\n", ##__VA_ARGS__)
+#define LOG_W(fmt, ...) Log::write(LogRecord::Level::Warn, fmt, ##__VA_ARGS__)
+#define LOG_I(fmt, ...) Log::write(LogRecord::Level::Info, fmt, ##__VA_ARGS__)
+#define LOG_D(fmt, ...) Log::write(LogRecord::Level::Debug, fmt, ##__VA_ARGS__)
 #else
-#define LOG_E(fmt, ...) M5.Log.printf("[E] " fmt "\n", ##__VA_ARGS__)
-#define LOG_W(fmt, ...) ((void)0)
-#define LOG_I(fmt, ...) ((void)0)
-#define LOG_D(fmt, ...) ((void)0)
+// Disabled levels compile to nothing but still reference their arguments,
+// so release builds don't warn about values that are only logged
+#define LOG_DISABLED(fmt, ...)                                      \
+    do {                                                            \
+        if (false)                                                  \
+            Log::write(LogRecord::Level::Debug, fmt, ##__VA_ARGS__); \
+    } while (0)
+#define LOG_W(fmt, ...) LOG_DISABLED(fmt, ##__VA_ARGS__)
+#define LOG_I(fmt, ...) LOG_DISABLED(fmt, ##__VA_ARGS__)
+#define LOG_D(fmt, ...) LOG_DISABLED(fmt, ##__VA_ARGS__)
 #endif
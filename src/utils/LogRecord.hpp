@@ -0,0 +1,311 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+// Binary log records: the format string's address plus raw, type-tagged
+// arguments. Encoding is a few small memcpys on the logging thread; the text
+// is produced later by the drain task (format()) or on the host from the
+// wire frames (tools/logdecode/decode_log.py).
+//
+// Record: level u8, argc u8, timestamp u32 (us), format pointer, then per
+// argument a tag byte and its payload (little-endian).
+namespace LogRecord {
+
+enum class Level : uint8_t { Error, Warn, Info, Debug };
+
+inline char levelChar(Level level) {
+    switch (level) {
+        case Level::Error:
+            return 'E';
+        case Level::Warn:
+            return 'W';
+        case Level::Info:
+            return 'I';
+        default:
+            return 'D';
+    }
+}
+
+enum ArgTag : uint8_t {
+    ARG_I32 = 1,  // Integers up to 32 bits, bool, enums
+    ARG_I64 = 2,
+    ARG_F64 = 3,  // float and double
+    ARG_STR = 4,  // Copied: u8 length + bytes, no terminator
+    ARG_PTR = 5,  // Other pointers, widened to 64 bits
+};
+
+static constexpr size_t MAX_RECORD = 192;
+static constexpr size_t MAX_STRING = 48;  // Longer strings are truncated
+static constexpr size_t HEADER_BYTES = 6 + sizeof(const char*);
+
+struct Header {
+    Level level;
+    uint8_t argc;
+    uint32_t timestampUs;
+    const char* format;
+};
+
+class Writer {
+   public:
+    Writer(uint8_t* buf, size_t cap) : _buf(buf), _cap(cap) {}
+
+    void put(const void* data, size_t len) {
+        if (_len + len > _cap) {
+            _truncated = true;
+            return;
+        }
+        memcpy(_buf + _len, data, len);
+        _len += len;
+    }
+
+    void putTagged(uint8_t tag, const void* data, size_t len) {
+        if (_len + 1 + len > _cap) {
+            _truncated = true;
+            return;
+        }
+        _buf[_len++] = tag;
+        memcpy(_buf + _len, data, len);
+        _len += len;
+    }
+
+    size_t length() const { return _len; }
+    bool truncated() const { return _truncated; }
+
+   private:
+    uint8_t* _buf;
+    size_t _cap;
+    size_t _len = 0;
+    bool _truncated = false;
+};
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type encodeArg(
+    Writer& w, T value) {
+    if (sizeof(T) <= 4) {
+        uint32_t raw = static_cast<uint32_t>(value);
+        w.putTagged(ARG_I32, &raw, sizeof(raw));
+    } else {
+        uint64_t raw = static_cast<uint64_t>(value);
+        w.putTagged(ARG_I64, &raw, sizeof(raw));
+    }
+}
+
+inline void encodeArg(Writer& w, double value) {
+    w.putTagged(ARG_F64, &value, sizeof(value));
+}
+
+inline void encodeArg(Writer& w, const char* str) {
+    if (!str) {
+        str = "(null)";
+    }
+    uint8_t buf[1 + MAX_STRING];
+    size_t len = 0;
+    while (len < MAX_STRING && str[len]) {
+        buf[1 + len] = static_cast<uint8_t>(str[len]);
+        len++;
+    }
+    buf[0] = static_cast<uint8_t>(len);
+    w.putTagged(ARG_STR, buf, 1 + len);
+}
+
+template <typename T>
+void encodeArg(Writer& w, const T* ptr) {
+    uint64_t raw = reinterpret_cast<uintptr_t>(ptr);
+    w.putTagged(ARG_PTR, &raw, sizeof(raw));
+}
+
+inline void encodeArgs(Writer& w) {
+    (void)w;
+}
+
+template <typename T, typename... Rest>
+void encodeArgs(Writer& w, const T& first, const Rest&... rest) {
+    encodeArg(w, first);
+    encodeArgs(w, rest...);
+}
+
+// Returns the record length (at most cap); arguments that do not fit are dropped
+template <typename... Args>
+size_t encode(uint8_t* buf, size_t cap, Level level, uint32_t timestampUs, const char* format,
+              const Args&... args) {
+    Writer w(buf, cap);
+    uint8_t head[2] = {static_cast<uint8_t>(level), static_cast<uint8_t>(sizeof...(Args))};
+    w.put(head, sizeof(head));
+    w.put(&timestampUs, sizeof(timestampUs));
+    w.put(&format, sizeof(format));
+    encodeArgs(w, args...);
+    return w.length();
+}
+
+inline Header readHeader(const uint8_t* rec) {
+    Header h;
+    h.level = static_cast<Level>(rec[0]);
+    h.argc = rec[1];
+    memcpy(&h.timestampUs, rec + 2, sizeof(h.timestampUs));
+    memcpy(&h.format, rec + 6, sizeof(h.format));
+    return h;
+}
+
+// Walks the tagged arguments after the header
+class Reader {
+   public:
+    Reader(const uint8_t* args, size_t len) : _p(args), _end(args + len) {}
+
+    // Tag of the next argument, 0 when exhausted or malformed
+    uint8_t next() {
+        if (_p >= _end) {
+            return 0;
+        }
+        _tag = *_p++;
+        size_t size = _tag == ARG_I32 ? 4 : _tag == ARG_STR ? (_p < _end ? 1 + *_p : 1) : 8;
+        if (_p + size > _end) {
+            _p = _end;
+            return 0;
+        }
+        _data = _p;
+        _p += size;
+        return _tag;
+    }
+
+    uint32_t u32() const {
+        uint32_t v;
+        memcpy(&v, _data, sizeof(v));
+        return v;
+    }
+    uint64_t u64() const {
+        uint64_t v;
+        memcpy(&v, _data, sizeof(v));
+        return v;
+    }
+    double f64() const {
+        double v;
+        memcpy(&v, _data, sizeof(v));
+        return v;
+    }
+    // Copies the string argument, NUL-terminated
+    void str(char* out, size_t outLen) const {
+        size_t len = _data[0] < outLen - 1 ? _data[0] : outLen - 1;
+        memcpy(out, _data + 1, len);
+        out[len] = '\0';
+    }
+
+   private:
+    const uint8_t* _p;
+    const uint8_t* _end;
+    const uint8_t* _data = nullptr;
+    uint8_t _tag = 0;
+};
+
+// Expand one conversion (spec without length modifiers, e.g. "%-6") with
+// the argument the reader is positioned on. Returns characters written.
+inline int formatArg(char* out, size_t outLen, char* spec, size_t specLen, char conv,
+                     const Reader& r, uint8_t tag) {
+    switch (conv) {
+        case 'd':
+        case 'i':
+            if (tag == ARG_I64) {
+                memcpy(spec + specLen, "lld", 4);
+                return snprintf(out, outLen, spec, static_cast<long long>(r.u64()));
+            }
+            if (tag == ARG_I32) {
+                memcpy(spec + specLen, "d", 2);
+                return snprintf(out, outLen, spec, static_cast<int>(static_cast<int32_t>(r.u32())));
+            }
+            break;
+        case 'u':
+        case 'x':
+        case 'X':
+        case 'o':
+        case 'c':
+            if (tag == ARG_I64 && conv != 'c') {
+                char ll[4] = {'l', 'l', conv, '\0'};
+                memcpy(spec + specLen, ll, 4);
+                return snprintf(out, outLen, spec, static_cast<unsigned long long>(r.u64()));
+            }
+            if (tag == ARG_I32) {
+                char c[2] = {conv, '\0'};
+                memcpy(spec + specLen, c, 2);
+                return snprintf(out, outLen, spec, static_cast<unsigned>(r.u32()));
+            }
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+            if (tag == ARG_F64) {
+                char c[2] = {conv, '\0'};
+                memcpy(spec + specLen, c, 2);
+                return snprintf(out, outLen, spec, r.f64());
+            }
+            break;
+        case 's':
+            if (tag == ARG_STR) {
+                char str[MAX_STRING + 1];
+                r.str(str, sizeof(str));
+                memcpy(spec + specLen, "s", 2);
+                return snprintf(out, outLen, spec, str);
+            }
+            break;
+        case 'p':
+            if (tag == ARG_PTR) {
+                return snprintf(out, outLen, "0x%llx", static_cast<unsigned long long>(r.u64()));
+            }
+            break;
+    }
+    return snprintf(out, outLen, "<?>");
+}
+
+// Render the message text of a record (without level prefix or newline)
+inline size_t format(const uint8_t* rec, size_t len, char* out, size_t outLen) {
+    if (outLen == 0) {
+        return 0;
+    }
+    out[0] = '\0';
+    if (len < HEADER_BYTES) {
+        return 0;
+    }
+    Header h = readHeader(rec);
+    Reader r(rec + HEADER_BYTES, len - HEADER_BYTES);
+    size_t o = 0;
+
+    for (const char* p = h.format; *p && o + 1 < outLen;) {
+        if (*p != '%') {
+            out[o++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[o++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion
+        char spec[24];
+        size_t specLen = 0;
+        spec[specLen++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && specLen < sizeof(spec) - 4) {
+            spec[specLen++] = *p++;
+        }
+        while (*p && strchr("hlzjtL", *p)) {
+            p++;  // Replaced by the length matching the recorded type
+        }
+        if (!*p) {
+            break;
+        }
+        char conv = *p++;
+        int n = formatArg(out + o, outLen - o, spec, specLen, conv, r, r.next());
+        if (n > 0) {
+            o += static_cast<size_t>(n) < outLen - o ? n : outLen - o - 1;
+        }
+    }
+    out[o] = '\0';
+    return o;
+}
+
+}  // namespace LogRecord
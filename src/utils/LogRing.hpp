@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Byte ring of length-prefixed records with one consumer. Producers must be
+// serialized by the caller (Log holds a spinlock on device); the consumer
+// runs concurrently on another task, so the indices are atomics. A record
+// that does not fit is dropped and counted - logging never blocks.
+class LogRing {
+   public:
+    static constexpr size_t LENGTH_BYTES = 2;
+
+    LogRing() = default;
+
+    // capacity must be a power of two
+    void attach(uint8_t* storage, size_t capacity) {
+        _storage = storage;
+        _mask = capacity - 1;
+        _head.store(0, std::memory_order_relaxed);
+        _tail.store(0, std::memory_order_relaxed);
+    }
+
+    bool attached() const { return _storage != nullptr; }
+    size_t capacity() const { return _storage ? _mask + 1 : 0; }
+
+    bool push(const uint8_t* record, uint16_t len) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        if (!_storage || capacity() - (head - tail) < len + LENGTH_BYTES) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        uint8_t prefix[LENGTH_BYTES] = {static_cast<uint8_t>(len), static_cast<uint8_t>(len >> 8)};
+        copyIn(head, prefix, LENGTH_BYTES);
+        copyIn(head + LENGTH_BYTES, record, len);
+        _head.store(head + LENGTH_BYTES + len, std::memory_order_release);
+        return true;
+    }
+
+    // Length of the record copied to out, 0 when empty. Records longer than
+    // maxLen are skipped.
+    uint16_t pop(uint8_t* out, size_t maxLen) {
+        for (;;) {
+            uint32_t tail = _tail.load(std::memory_order_relaxed);
+            uint32_t head = _head.load(std::memory_order_acquire);
+            if (head == tail) {
+                return 0;
+            }
+            uint8_t prefix[LENGTH_BYTES];
+            copyOut(tail, prefix, LENGTH_BYTES);
+            uint16_t len = static_cast<uint16_t>(prefix[0] | (prefix[1] << 8));
+            if (len <= maxLen) {
+                copyOut(tail + LENGTH_BYTES, out, len);
+            }
+            _tail.store(tail + LENGTH_BYTES + len, std::memory_order_release);
+            if (len <= maxLen) {
+                return len;
+            }
+        }
+    }
+
+    bool empty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+
+    // Records dropped since the last call
+    uint32_t takeDropped() { return _dropped.exchange(0, std::memory_order_relaxed); }
+
+   private:
+    uint8_t* _storage = nullptr;
+    size_t _mask = 0;
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _tail{0};
+    std::atomic<uint32_t> _dropped{0};
+
+    // At most two memcpys: up to the end of the buffer, then from the start
+    void copyIn(uint32_t pos, const uint8_t* data, size_t len) {
+        size_t offset = pos & _mask;
+        size_t first = len < capacity() - offset ? len : capacity() - offset;
+        memcpy(_storage + offset, data, first);
+        memcpy(_storage, data + first, len - first);
+    }
+
+    void copyOut(uint32_t pos, uint8_t* data, size_t len) const {
+        size_t offset = pos & _mask;
+        size_t first = len < capacity() - offset ? len : capacity() - offset;
+        memcpy(data, _storage + offset, first);
+        memcpy(data + first, _storage, len - first);
+    }
+};
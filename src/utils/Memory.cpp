@@ -0,0 +1,89 @@
+#include "Memory.hpp"
+#include <esp_heap_caps.h>
+#include <cstdio>
+#include "AllocTracker.hpp"
+#include "Log.hpp"
+
+namespace Memory {
+
+static constexpr uint32_t CAPS_INTERNAL = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+static constexpr uint32_t CAPS_PSRAM = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+
+void* allocate(size_t bytes, Region region) {
+    void* ptr = nullptr;
+    if (region == Region::Psram) {
+        ptr = heap_caps_malloc(bytes, CAPS_PSRAM);
+    }
+    if (!ptr) {
+        ptr = heap_caps_malloc(bytes, CAPS_INTERNAL);
+    }
+    if (!ptr) {
+        LOG_E("Memory: failed to allocate %u bytes", static_cast<unsigned>(bytes));
+    } else {
+        AllocTracker::onAlloc(bytes);  // heap_caps is not behind the malloc hooks
+    }
+    return ptr;
+}
+
+void release(void* ptr) {
+    if (ptr) {
+        AllocTracker::onFree();
+    }
+    heap_caps_free(ptr);
+}
+
+Usage usage() {
+    Usage u;
+    u.internalFree = heap_caps_get_free_size(CAPS_INTERNAL);
+    u.internalTotal = heap_caps_get_total_size(CAPS_INTERNAL);
+    u.internalMinFree = heap_caps_get_minimum_free_size(CAPS_INTERNAL);
+    u.psramFree = heap_caps_get_free_size(CAPS_PSRAM);
+    u.psramTotal = heap_caps_get_total_size(CAPS_PSRAM);
+    u.psramMinFree = heap_caps_get_minimum_free_size(CAPS_PSRAM);
+    return u;
+}
+
+MemoryLedger& ledger() {
+    static MemoryLedger instance;
+    return instance;
+}
+
+void enterScope(const char* appId, const char* screenId, MemoryBudget budget) {
+    char name[24];
+    snprintf(name, sizeof(name), "%s/%s", appId, screenId);
+    ledger().enter(name, budget, heap_caps_get_free_size(CAPS_INTERNAL),
+                   heap_caps_get_free_size(CAPS_PSRAM), AllocTracker::total().allocs);
+}
+
+void sampleScope() {
+    auto& l = ledger();
+    if (l.sample(heap_caps_get_free_size(CAPS_INTERNAL), heap_caps_get_free_size(CAPS_PSRAM),
+                 AllocTracker::total().allocs)) {
+        const MemoryScopeStats* s = l.active();
+        LOG_W("Memory: '%s' over budget (internal %u/%u, psram %u/%u)", s->name.c_str(),
+              static_cast<unsigned>(s->internalPeak),
+              static_cast<unsigned>(s->budget.internalBytes), static_cast<unsigned>(s->psramPeak),
+              static_cast<unsigned>(s->budget.psramBytes));
+    }
+}
+
+void logReport() {
+    Usage u = usage();
+    LOG_I("Memory: internal %u/%u free (min %u), psram %u/%u free (min %u)",
+          static_cast<unsigned>(u.internalFree), static_cast<unsigned>(u.internalTotal),
+          static_cast<unsigned>(u.internalMinFree), static_cast<unsigned>(u.psramFree),
+          static_cast<unsigned>(u.psramTotal), static_cast<unsigned>(u.psramMinFree));
+
+    auto& l = ledger();
+    for (size_t i = 0; i < l.count(); i++) {
+        const MemoryScopeStats& s = l.at(i);
+        LOG_I("Memory:   %-20s int %6u peak %6u / %6u  psram %6u peak %6u / %6u  allocs %6u%s",
+              s.name.c_str(), static_cast<unsigned>(s.internalUsed),
+              static_cast<unsigned>(s.internalPeak), static_cast<unsigned>(s.budget.internalBytes),
+              static_cast<unsigned>(s.psramUsed), static_cast<unsigned>(s.psramPeak),
+              static_cast<unsigned>(s.budget.psramBytes), static_cast<unsigned>(s.allocs),
+              s.overBudget() ? "  OVER" : "");
+    }
+}
+
+}  // namespace Memory
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include "MemoryLedger.hpp"
+
+// Allocation policy for the ESP32-S3's two heaps.
+//
+// Internal SRAM is fast and scarce: keep per-frame state there (game state,
+// player cards, keyboard, input). OPI PSRAM is large but slower and shares
+// the bus with flash: put big or rarely-touched buffers there (canvases,
+// logs, the trace ring, history pages, WiFi scan results). Falls back to internal SRAM if
+// PSRAM is unavailable or exhausted.
+namespace Memory {
+
+enum class Region : uint8_t {
+    Internal,  // Hot data touched every frame
+    Psram,     // Large or cold buffers
+};
+
+void* allocate(size_t bytes, Region region);
+void release(void* ptr);
+
+template <typename T, typename... Args>
+T* create(Region region, Args&&... args) {
+    void* mem = allocate(sizeof(T), region);
+    return mem ? new (mem) T(std::forward<Args>(args)...) : nullptr;
+}
+
+template <typename T>
+void destroy(T* obj) {
+    if (obj) {
+        obj->~T();
+        release(obj);
+    }
+}
+
+struct Usage {
+    size_t internalFree;
+    size_t internalTotal;
+    size_t internalMinFree;  // Lowest free internal heap since boot
+    size_t psramFree;
+    size_t psramTotal;
+    size_t psramMinFree;
+};
+
+Usage usage();
+
+// Per-screen accounting (driven by Navigation)
+MemoryLedger& ledger();
+void enterScope(const char* appId, const char* screenId, MemoryBudget budget);
+void sampleScope();
+
+// Dump per-screen usage, high-water marks and budgets over serial
+void logReport();
+
+}  // namespace Memory
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "FixedString.hpp"
+
+// Declared heap budget for a screen, split by memory region
+struct MemoryBudget {
+    uint32_t internalBytes;
+    uint32_t psramBytes;
+};
+
+struct MemoryScopeStats {
+    FixedString<23> name;  // "appId/screenId"
+    MemoryBudget budget = {0, 0};
+    uint32_t internalUsed = 0;
+    uint32_t psramUsed = 0;
+    uint32_t internalPeak = 0;  // High-water marks across all visits
+    uint32_t psramPeak = 0;
+    uint32_t allocs = 0;  // Heap allocations while on top, all visits (AllocTracker)
+
+    bool overBudget() const {
+        return internalPeak > budget.internalBytes || psramPeak > budget.psramBytes;
+    }
+};
+
+// Per-screen heap accounting. Usage is the drop in free heap since the scope
+// was entered, so it covers every allocation the screen makes (new, String,
+// containers) without instrumenting them. Pure logic - fed free-heap figures
+// by Memory on device and by the host heap in native tests.
+class MemoryLedger {
+   public:
+    static constexpr size_t MAX_SCOPES = 12;
+
+    // Start attributing usage to a scope. Call before the screen's onEnter().
+    // allocCount is the running allocation total, when the build counts them.
+    void enter(const char* name, MemoryBudget budget, size_t internalFree, size_t psramFree,
+               uint32_t allocCount = 0) {
+        countAllocs(allocCount);  // Settle the outgoing scope
+        _active = findOrAdd(name);
+        if (!_active)
+            return;
+        _active->budget = budget;
+        _active->internalUsed = 0;
+        _active->psramUsed = 0;
+        _internalBaseline = internalFree;
+        _psramBaseline = psramFree;
+        _allocBaseline = allocCount;
+        _allocsBefore = _active->allocs;
+    }
+
+    // Update the active scope. Returns true when it first exceeds its budget.
+    bool sample(size_t internalFree, size_t psramFree, uint32_t allocCount = 0) {
+        if (!_active)
+            return false;
+        countAllocs(allocCount);
+        bool wasOver = _active->overBudget();
+        _active->internalUsed = used(_internalBaseline, internalFree);
+        _active->psramUsed = used(_psramBaseline, psramFree);
+        if (_active->internalUsed > _active->internalPeak)
+            _active->internalPeak = _active->internalUsed;
+        if (_active->psramUsed > _active->psramPeak)
+            _active->psramPeak = _active->psramUsed;
+        return !wasOver && _active->overBudget();
+    }
+
+    const MemoryScopeStats* active() const { return _active; }
+
+    const MemoryScopeStats* find(const char* name) const {
+        for (size_t i = 0; i < _count; i++) {
+            if (_scopes[i].name == name)
+                return &_scopes[i];
+        }
+        return nullptr;
+    }
+
+    size_t count() const { return _count; }
+    const MemoryScopeStats& at(size_t index) const { return _scopes[index]; }
+
+    bool anyOverBudget() const {
+        for (size_t i = 0; i < _count; i++) {
+            if (_scopes[i].overBudget())
+                return true;
+        }
+        return false;
+    }
+
+    void reset() {
+        _count = 0;
+        _active = nullptr;
+    }
+
+   private:
+    MemoryScopeStats _scopes[MAX_SCOPES];
+    size_t _count = 0;
+    MemoryScopeStats* _active = nullptr;
+    size_t _internalBaseline = 0;
+    size_t _psramBaseline = 0;
+    uint32_t _allocBaseline = 0;
+    uint32_t _allocsBefore = 0;  // Active scope's count from earlier visits
+
+    void countAllocs(uint32_t allocCount) {
+        if (_active)
+            _active->allocs = _allocsBefore + (allocCount - _allocBaseline);
+    }
+
+    static uint32_t used(size_t baseline, size_t nowFree) {
+        return nowFree < baseline ? static_cast<uint32_t>(baseline - nowFree) : 0;
+    }
+
+    MemoryScopeStats* findOrAdd(const char* name) {
+        for (size_t i = 0; i < _count; i++) {
+            if (_scopes[i].name == name)
+                return &_scopes[i];
+        }
+        if (_count >= MAX_SCOPES)
+            return nullptr;
+        MemoryScopeStats& scope = _scopes[_count++];
+        scope = MemoryScopeStats();
+        scope.name = name;
+        return &scope;
+    }
+};
@@ -0,0 +1,24 @@
+#include "Metrics.hpp"
+#include <Arduino.h>
+
+namespace Metrics {
+
+static PerfCounters countersInstance;
+
+PerfCounters& counters() {
+    return countersInstance;
+}
+
+void onLoop() {
+    countersInstance.onLoop(millis());
+}
+
+void onFrame(uint32_t renderUs, uint32_t presentUs, bool fullScreen) {
+    countersInstance.onFrame(renderUs, presentUs, fullScreen);
+}
+
+void onNvsWrite() {
+    countersInstance.onNvsWrite();
+}
+
+}  // namespace Metrics
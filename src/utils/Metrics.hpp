@@ -0,0 +1,15 @@
+#pragma once
+
+#include "PerfCounters.hpp"
+
+// Live performance counters shown by the Diagnostics app; see PerfCounters
+namespace Metrics {
+
+PerfCounters& counters();
+
+// Event hooks
+void onLoop();
+void onFrame(uint32_t renderUs, uint32_t presentUs, bool fullScreen);
+void onNvsWrite();  // One namespace commit (Preferences::end after puts)
+
+}  // namespace Metrics
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+
+// Loop rate, frame timing, refresh and NVS write counters for the
+// Diagnostics app. Rates and timings cover the last completed one-second
+// window; counts are since boot. Pure logic - fed by Metrics on device and
+// directly in native tests.
+class PerfCounters {
+   public:
+    static constexpr uint32_t WINDOW_MS = 1000;
+
+    PerfCounters() { clear(); }
+
+    void clear() {
+        _windowStartMs = 0;
+        _windowStarted = false;
+        _loops = 0;
+        _frames = 0;
+        _renderSumUs = 0;
+        _renderMaxUs = 0;
+        _presentSumUs = 0;
+        _presentMaxUs = 0;
+        _loopCentiHz = 0;
+        _renderAvgUs = 0;
+        _lastRenderMaxUs = 0;
+        _presentAvgUs = 0;
+        _lastPresentMaxUs = 0;
+        _fullRefreshes = 0;
+        _partialRefreshes = 0;
+        _nvsWrites = 0;
+    }
+
+    // Once per loop iteration; closes the window when a second has passed
+    void onLoop(uint32_t nowMs) {
+        if (!_windowStarted) {
+            _windowStarted = true;
+            _windowStartMs = nowMs;
+        }
+        _loops++;
+        uint32_t elapsed = nowMs - _windowStartMs;
+        if (elapsed < WINDOW_MS) {
+            return;
+        }
+        _loopCentiHz = static_cast<uint32_t>(static_cast<uint64_t>(_loops) * 100000 / elapsed);
+        _renderAvgUs = _frames ? static_cast<uint32_t>(_renderSumUs / _frames) : 0;
+        _presentAvgUs = _frames ? static_cast<uint32_t>(_presentSumUs / _frames) : 0;
+        _lastRenderMaxUs = _renderMaxUs;
+        _lastPresentMaxUs = _presentMaxUs;
+        _windowStartMs = nowMs;
+        _loops = 0;
+        _frames = 0;
+        _renderSumUs = 0;
+        _renderMaxUs = 0;
+        _presentSumUs = 0;
+        _presentMaxUs = 0;
+    }
+
+    // A frame went to the panel: time spent drawing into the framebuffer,
+    // then in display()
+    void onFrame(uint32_t renderUs, uint32_t presentUs, bool fullScreen) {
+        _frames++;
+        _renderSumUs += renderUs;
+        _presentSumUs += presentUs;
+        if (renderUs > _renderMaxUs) {
+            _renderMaxUs = renderUs;
+        }
+        if (presentUs > _presentMaxUs) {
+            _presentMaxUs = presentUs;
+        }
+        if (fullScreen) {
+            _fullRefreshes++;
+        } else {
+            _partialRefreshes++;
+        }
+    }
+
+    void onNvsWrite() { _nvsWrites++; }
+
+    uint32_t loopCentiHz() const { return _loopCentiHz; }
+    uint32_t renderAvgUs() const { return _renderAvgUs; }
+    uint32_t renderMaxUs() const { return _lastRenderMaxUs; }
+    uint32_t presentAvgUs() const { return _presentAvgUs; }
+    uint32_t presentMaxUs() const { return _lastPresentMaxUs; }
+    uint32_t fullRefreshes() const { return _fullRefreshes; }
+    uint32_t partialRefreshes() const { return _partialRefreshes; }
+    uint32_t nvsWrites() const { return _nvsWrites; }
+
+   private:
+    uint32_t _windowStartMs;
+    bool _windowStarted;
+    uint32_t _loops;
+    uint32_t _frames;
+    uint64_t _renderSumUs;
+    uint32_t _renderMaxUs;
+    uint64_t _presentSumUs;
+    uint32_t _presentMaxUs;
+
+    // Last completed window
+    uint32_t _loopCentiHz;
+    uint32_t _renderAvgUs;
+    uint32_t _lastRenderMaxUs;
+    uint32_t _presentAvgUs;
+    uint32_t _lastPresentMaxUs;
+
+    uint32_t _fullRefreshes;
+    uint32_t _partialRefreshes;
+    uint32_t _nvsWrites;
+};
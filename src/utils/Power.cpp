@@ -1,14 +1,67 @@
 #include "Power.hpp"
 #include <M5Unified.h>
+#include <WiFi.h>
+#include <esp_sleep.h>
+#include "Energy.hpp"
 #include "Log.hpp"
 
 namespace Power {
 
-static uint32_t lastActivityMs = 0;
+static constexpr uint32_t LIGHT_SLEEP_WAKE_MS = 1000;     // Keeps the toolbar clock current
+static constexpr uint32_t IDLE_WAKE_MS = 60 * 1000;       // Upper bound when no deadline is near
+static constexpr uint32_t BATTERY_CHECK_MS = 60 * 1000;  // Auto-saver sampling interval
+
+static PowerStateMachine stateMachineInstance;
 static bool imuInitialized = false;
 
+static PowerProfile selectedProfile = PowerProfile::Balanced;
+static bool autoSaver = false;
+static uint32_t profileMs[PowerProfiles::COUNT] = {0};
+static uint32_t lastProfileUpdateMs = 0;
+static uint32_t lastBatteryCheckMs = 0;
+static bool batteryChecked = false;
+static uint32_t lastRefreshMs = 0;
+
+// Charge elapsed time to the profile that was active
+static void accrueProfileTime(uint32_t now) {
+    profileMs[static_cast<int>(activeProfile())] += now - lastProfileUpdateMs;
+    lastProfileUpdateMs = now;
+}
+
+static void applyProfile() {
+    const PowerProfileConfig& cfg = profileConfig();
+    setCpuFrequencyMhz(cfg.cpuMhz);
+    stateMachineInstance.setSleepTimeouts(cfg.lightSleepAfterMs, cfg.idleAfterMs);
+    applyWifiPowerSave();
+    LOG_I("Power: profile %s%s (%d MHz)", cfg.name, autoSaver ? " (auto)" : "", cfg.cpuMhz);
+}
+
+static void checkBattery(uint32_t now) {
+    if (batteryChecked && now - lastBatteryCheckMs < BATTERY_CHECK_MS) {
+        return;
+    }
+    batteryChecked = true;
+    lastBatteryCheckMs = now;
+
+    int8_t level = M5.Power.getBatteryLevel();
+    bool engaged = PowerProfiles::autoSaverActive(autoSaver, level);
+    if (engaged != autoSaver) {
+        accrueProfileTime(now);
+        autoSaver = engaged;
+        LOG_I("Power: battery %d%%, auto-saver %s", level, engaged ? "on" : "off");
+        applyProfile();
+    }
+}
+
 void init() {
-    lastActivityMs = millis();
+    uint32_t now = millis();
+    stateMachineInstance.reset(now);
+    for (int i = 0; i < PowerProfiles::COUNT; i++) {
+        profileMs[i] = 0;
+    }
+    lastProfileUpdateMs = now;
+    batteryChecked = false;
+    autoSaver = false;
 
     // Check if IMU is available
     if (M5.Imu.isEnabled()) {
@@ -21,24 +74,146 @@ void init() {
 }
 
 void resetInactivityTimer() {
-    lastActivityMs = millis();
+    stateMachineInstance.onActivity(millis());
+}
+
+void setProfile(PowerProfile profile) {
+    accrueProfileTime(millis());
+    selectedProfile = profile;
+    applyProfile();
+}
+
+PowerProfile profile() {
+    return selectedProfile;
+}
+
+PowerProfile activeProfile() {
+    return autoSaver ? PowerProfile::Saver : selectedProfile;
+}
+
+bool autoSaverActive() {
+    return autoSaver;
+}
+
+const PowerProfileConfig& profileConfig() {
+    return PowerProfiles::config(activeProfile());
+}
+
+void applyWifiPowerSave() {
+    if (WiFi.getMode() == WIFI_OFF) {
+        return;  // Power save can only be set on a started radio
+    }
+    switch (profileConfig().wifiPowerSave) {
+        case WifiPowerSave::Off:
+            WiFi.setSleep(WIFI_PS_NONE);
+            break;
+        case WifiPowerSave::Min:
+            WiFi.setSleep(WIFI_PS_MIN_MODEM);
+            break;
+        case WifiPowerSave::Max:
+            WiFi.setSleep(WIFI_PS_MAX_MODEM);
+            break;
+    }
+}
+
+uint32_t timeInProfile(PowerProfile profile) {
+    return profileMs[static_cast<int>(profile)];
+}
+
+void logReport() {
+    accrueProfileTime(millis());
+    LOG_I("Power: profile time PERF %lus, BAL %lus, SAVER %lus",
+          static_cast<unsigned long>(profileMs[0] / 1000),
+          static_cast<unsigned long>(profileMs[1] / 1000),
+          static_cast<unsigned long>(profileMs[2] / 1000));
+}
+
+bool refreshAllowed() {
+    uint16_t minMs = profileConfig().minRefreshMs;
+    return minMs == 0 || millis() - lastRefreshMs >= minMs;
+}
+
+void onRefresh() {
+    lastRefreshMs = millis();
 }
 
-bool shouldSleep(uint16_t timeoutSecs) {
-    if (timeoutSecs == 0) {
-        return false;  // Auto-sleep disabled
+PowerTier update(uint16_t timeoutSecs) {
+    uint32_t now = millis();
+    stateMachineInstance.setOffTimeout(static_cast<uint32_t>(timeoutSecs) * 1000);
+    checkBattery(now);
+    accrueProfileTime(now);
+
+    PowerTier previous = stateMachineInstance.tier();
+    PowerTier current = stateMachineInstance.update(now);
+    if (current != previous) {
+        LOG_D("Power: tier %d -> %d", static_cast<int>(previous), static_cast<int>(current));
     }
+    return current;
+}
+
+PowerTier tier() {
+    return stateMachineInstance.tier();
+}
 
-    uint32_t elapsedMs = millis() - lastActivityMs;
-    uint32_t timeoutMs = static_cast<uint32_t>(timeoutSecs) * 1000;
+const PowerStateMachine& stateMachine() {
+    return stateMachineInstance;
+}
+
+static void lightSleep(uint32_t maxMs) {
+    uint32_t start = millis();
+#ifdef NATIVE_TEST
+    delay(maxMs);  // Advances the virtual clock
+#else
+    // The EPD refresh and serial output must finish before clocks stop
+    M5.Display.waitDisplay();
+    Log::flush();
+    Serial.flush();
+
+    // M5Unified arms the board's touch interrupt as a wake source
+    M5.Power.lightSleep(static_cast<uint64_t>(maxMs) * 1000, true);
+#endif
+    Energy::onSleep(millis() - start);  // A touch can end it early
+}
+
+void waitForNextFrame() {
+    PowerTier current = stateMachineInstance.tier();
+
+    // Light sleep would drop the WiFi association, so stay awake while it is on
+    if (current == PowerTier::Active || WiFi.getMode() != WIFI_OFF) {
+        delay(profileConfig().frameMs);
+        return;
+    }
+
+    uint32_t sleepMs = stateMachineInstance.msUntilNextTier(millis());
+    uint32_t maxMs = current == PowerTier::LightSleep ? LIGHT_SLEEP_WAKE_MS : IDLE_WAKE_MS;
+    if (sleepMs > maxMs) {
+        sleepMs = maxMs;
+    }
+    if (sleepMs < profileConfig().frameMs) {
+        sleepMs = profileConfig().frameMs;
+    }
+    lightSleep(sleepMs);
+}
+
+void deepSleep() {
+    LOG_I("Power: Entering deep sleep");
+
+    M5.Display.waitDisplay();
+    Log::flush();
+    Serial.flush();
+    // Touch resumes; the timer running out powers off (see wokeToPowerOff())
+    M5.Power.deepSleep(static_cast<uint64_t>(DEEP_SLEEP_MAX_SECS) * 1000 * 1000, true);
+}
 
-    return elapsedMs >= timeoutMs;
+bool wokeToPowerOff() {
+    return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
 }
 
 void powerOff() {
     LOG_I("Power: Entering power-off mode");
 
     // Flush serial to ensure debug output completes before shutdown
+    Log::flush();
     Serial.flush();
     delay(50);
 
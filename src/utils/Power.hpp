@@ -1,12 +1,58 @@
 #pragma once
 
 #include <cstdint>
+#include "PowerProfile.hpp"
+#include "PowerStateMachine.hpp"
 
 namespace Power {
 
 void init();
 void resetInactivityTimer();
-bool shouldSleep(uint16_t timeoutSecs);
+
+// Advance the tier state machine; PowerTier::Off means the sleep timeout
+// has passed (timeoutSecs = 0 disables it) and the device should deep sleep
+PowerTier update(uint16_t timeoutSecs);
+PowerTier tier();
+const PowerStateMachine& stateMachine();
+
+// Select the user's profile and apply CPU clock, tier timeouts and WiFi
+// power save. A low battery overrides it with Saver until recharged.
+void setProfile(PowerProfile profile);
+PowerProfile profile();        // User's choice
+PowerProfile activeProfile();  // Saver while auto-saver is engaged
+bool autoSaverActive();
+const PowerProfileConfig& profileConfig();
+
+// Apply the active profile's WiFi power save; call after bringing WiFi up
+void applyWifiPowerSave();
+
+// Time spent in each profile since init(), for battery-life analysis
+uint32_t timeInProfile(PowerProfile profile);
+void logReport();
+
+// Coalesces EPD refreshes closer than the profile's minRefreshMs
+bool refreshAllowed();
+void onRefresh();
+
+// Toolbar battery/clock/WiFi polling is stopped in the Idle tier
+inline bool pollingEnabled() {
+    return tier() < PowerTier::Idle;
+}
+
+// End-of-loop wait: a profile-paced delay while active, otherwise light sleep until
+// touch or the next tier change
+void waitForNextFrame();
+
+// How long deep sleep waits for a touch before the device powers off
+static constexpr uint32_t DEEP_SLEEP_MAX_SECS = 60 * 60;
+
 void powerOff();
 
+// Deep sleep with touch wake; RTC memory survives for Resume. A timer ends it
+// after DEEP_SLEEP_MAX_SECS so an untouched device still powers off.
+void deepSleep();
+
+// True when this boot is that timer: setup() powers off instead of resuming
+bool wokeToPowerOff();
+
 }  // namespace Power
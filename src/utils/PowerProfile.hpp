@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include "PowerStateMachine.hpp"
+
+// User-selectable trade-off between responsiveness and battery life
+enum class PowerProfile : uint8_t {
+    Performance,
+    Balanced,
+    Saver,
+};
+
+enum class WifiPowerSave : uint8_t {
+    Off,    // Radio always listening
+    Min,    // Wake every DTIM beacon (ESP-IDF default)
+    Max,    // Wake every listen interval
+};
+
+// Everything a profile controls, applied together by Power::setProfile()
+struct PowerProfileConfig {
+    const char* name;
+    uint16_t cpuMhz;             // CPU clock while awake
+    uint16_t frameMs;            // Loop cadence in the Active tier
+    uint16_t toolbarPollMs;      // Battery/clock/WiFi polling interval
+    uint16_t minRefreshMs;       // EPD refreshes closer than this are coalesced
+    uint32_t lightSleepAfterMs;  // Inactivity before the LightSleep tier
+    uint32_t idleAfterMs;        // Inactivity before the Idle tier
+    WifiPowerSave wifiPowerSave;
+};
+
+namespace PowerProfiles {
+
+static constexpr int COUNT = 3;
+
+// Auto-saver engages at or below LOW and releases at or above RECOVER
+static constexpr int8_t LOW_BATTERY_PERCENT = 15;
+static constexpr int8_t RECOVER_BATTERY_PERCENT = 25;
+
+inline const PowerProfileConfig& config(PowerProfile profile) {
+    static const PowerProfileConfig CONFIGS[COUNT] = {
+        {"PERF", 240, 20, 1000, 0, 10 * 1000, 5 * 60 * 1000, WifiPowerSave::Off},
+        {"BAL", 160, 20, 5000, 0, PowerStateMachine::DEFAULT_LIGHT_SLEEP_MS,
+         PowerStateMachine::DEFAULT_IDLE_MS, WifiPowerSave::Min},
+        {"SAVER", 80, 40, 30 * 1000, 250, 2 * 1000, 60 * 1000, WifiPowerSave::Max},
+    };
+    int index = static_cast<int>(profile);
+    return CONFIGS[index < COUNT ? index : static_cast<int>(PowerProfile::Balanced)];
+}
+
+// Low-battery override with hysteresis so the profile does not flap around
+// the threshold. batteryPercent < 0 means unknown and keeps the current state.
+inline bool autoSaverActive(bool wasActive, int8_t batteryPercent) {
+    if (batteryPercent < 0) {
+        return wasActive;
+    }
+    if (wasActive) {
+        return batteryPercent < RECOVER_BATTERY_PERCENT;
+    }
+    return batteryPercent <= LOW_BATTERY_PERCENT;
+}
+
+}  // namespace PowerProfiles
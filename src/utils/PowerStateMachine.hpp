@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+
+// Power tiers, in order of increasing inactivity
+enum class PowerTier : uint8_t {
+    Active,      // Recent touch: full-rate loop
+    LightSleep,  // Between taps: light sleep, woken by touch or a short timer
+    Idle,        // Nobody playing: light sleep until touch, toolbar polling stopped
+    Off,         // Sleep timeout reached: deep sleep, then power off
+};
+
+// Inactivity-driven tier selection. Pure logic - fed timestamps by Power on
+// device and by the virtual clock in native tests.
+class PowerStateMachine {
+   public:
+    static constexpr int TIER_COUNT = 4;
+    static constexpr uint32_t NEVER = UINT32_MAX;
+
+    static constexpr uint32_t DEFAULT_LIGHT_SLEEP_MS = 5 * 1000;
+    static constexpr uint32_t DEFAULT_IDLE_MS = 2 * 60 * 1000;
+
+    void reset(uint32_t nowMs) {
+        _lastActivityMs = nowMs;
+        _lastUpdateMs = nowMs;
+        _tier = PowerTier::Active;
+        for (int i = 0; i < TIER_COUNT; i++) {
+            _tierMs[i] = 0;
+        }
+    }
+
+    // Inactivity before each tier; offMs = 0 disables power-off
+    void setTimeouts(uint32_t lightSleepMs, uint32_t idleMs, uint32_t offMs) {
+        _lightSleepMs = lightSleepMs;
+        _idleMs = idleMs < lightSleepMs ? lightSleepMs : idleMs;
+        _offMs = offMs == 0 ? NEVER : offMs;
+    }
+
+    void setOffTimeout(uint32_t offMs) { setTimeouts(_lightSleepMs, _idleMs, offMs); }
+
+    // Change the sleep tiers and keep the power-off timeout
+    void setSleepTimeouts(uint32_t lightSleepMs, uint32_t idleMs) {
+        setTimeouts(lightSleepMs, idleMs, _offMs == NEVER ? 0 : _offMs);
+    }
+
+    void onActivity(uint32_t nowMs) {
+        _lastActivityMs = nowMs;
+        update(nowMs);
+    }
+
+    // Recompute the tier and charge the elapsed time to the previous one
+    PowerTier update(uint32_t nowMs) {
+        _tierMs[static_cast<int>(_tier)] += nowMs - _lastUpdateMs;
+        _lastUpdateMs = nowMs;
+
+        uint32_t idle = nowMs - _lastActivityMs;
+        if (idle >= _offMs) {
+            _tier = PowerTier::Off;
+        } else if (idle >= _idleMs) {
+            _tier = PowerTier::Idle;
+        } else if (idle >= _lightSleepMs) {
+            _tier = PowerTier::LightSleep;
+        } else {
+            _tier = PowerTier::Active;
+        }
+        return _tier;
+    }
+
+    PowerTier tier() const { return _tier; }
+
+    // Longest sleep that does not overshoot the next tier change; NEVER if none
+    uint32_t msUntilNextTier(uint32_t nowMs) const {
+        uint32_t idle = nowMs - _lastActivityMs;
+        uint32_t next = _tier == PowerTier::Active       ? _lightSleepMs
+                        : _tier == PowerTier::LightSleep ? _idleMs
+                        : _tier == PowerTier::Idle       ? _offMs
+                                                         : NEVER;
+        if (next == NEVER)
+            return NEVER;
+        return next > idle ? next - idle : 0;
+    }
+
+    // Time spent in a tier since reset(), for battery-life analysis
+    uint32_t timeInTier(PowerTier tier) const { return _tierMs[static_cast<int>(tier)]; }
+
+   private:
+    uint32_t _lightSleepMs = DEFAULT_LIGHT_SLEEP_MS;
+    uint32_t _idleMs = DEFAULT_IDLE_MS;
+    uint32_t _offMs = NEVER;
+    uint32_t _lastActivityMs = 0;
+    uint32_t _lastUpdateMs = 0;
+    PowerTier _tier = PowerTier::Active;
+    uint32_t _tierMs[TIER_COUNT] = {0};
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// One sample of the sampling profiler: where the loop core was interrupted
+// and the return address of that function (one level of call graph).
+struct ProfileSample {
+    uint32_t pc;
+    uint32_t caller;  // 0 if unknown
+};
+
+// Sample ring filled from the timer interrupt and emptied by the loop. Both
+// run on the same core, so the volatile indices are enough. Full = dropped.
+class ProfileSampleRing {
+   public:
+    // capacity must be a power of two
+    void attach(ProfileSample* storage, size_t capacity) {
+        _samples = storage;
+        _mask = capacity - 1;
+        _head = 0;
+        _tail = 0;
+        _dropped = 0;
+    }
+
+    bool attached() const { return _samples != nullptr; }
+
+    void push(uint32_t pc, uint32_t caller) {
+        uint32_t head = _head;
+        if (head - _tail > _mask) {
+            _dropped++;
+            return;
+        }
+        _samples[head & _mask].pc = pc;
+        _samples[head & _mask].caller = caller;
+        _head = head + 1;
+    }
+
+    bool pop(ProfileSample& out) {
+        uint32_t tail = _tail;
+        if (tail == _head) {
+            return false;
+        }
+        out = _samples[tail & _mask];
+        _tail = tail + 1;
+        return true;
+    }
+
+    uint32_t takeDropped() {
+        uint32_t dropped = _dropped;
+        _dropped -= dropped;
+        return dropped;
+    }
+
+   private:
+    ProfileSample* _samples = nullptr;
+    size_t _mask = 0;
+    volatile uint32_t _head = 0;
+    volatile uint32_t _tail = 0;
+    volatile uint32_t _dropped = 0;
+};
+
+namespace ProfileSamples {
+
+// Xtensa windowed calls keep the caller's window increment in the top two
+// bits of a0; the real return address takes them from the current region
+inline uint32_t returnAddress(uint32_t a0, uint32_t pc) {
+    if (a0 == 0) {
+        return 0;
+    }
+    return (a0 & 0x3FFFFFFF) | (pc & 0xC0000000);
+}
+
+// Wire line read by tools/profile/profile.py: "~P <pc> <caller>" in hex
+static constexpr size_t LINE_CHARS = 21;
+
+inline int formatLine(char* out, size_t outLen, const ProfileSample& sample) {
+    return snprintf(out, outLen, "~P %08lx %08lx\n", static_cast<unsigned long>(sample.pc),
+                    static_cast<unsigned long>(sample.caller));
+}
+
+}  // namespace ProfileSamples
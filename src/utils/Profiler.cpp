@@ -0,0 +1,127 @@
+#include "Profiler.hpp"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "Log.hpp"
+#include "ProfileSamples.hpp"
+
+#ifndef NATIVE_TEST
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/xtensa_context.h>
+#endif
+
+namespace Profiler {
+
+static constexpr size_t RING_SAMPLES = 1024;   // 1s at the default rate
+static constexpr size_t SAMPLES_PER_WRITE = 24;  // One serial write per batch
+static constexpr uint32_t TIMER_TICK_HZ = 1000000;  // 80MHz APB / 80
+
+static ProfileSampleRing ring;
+static bool isRunning = false;
+
+#ifndef NATIVE_TEST
+static hw_timer_t* timer = nullptr;
+
+// Interrupt depth per core, kept by the Xtensa FreeRTOS port (port.c);
+// 1 inside an interrupt taken over a running task
+extern "C" unsigned port_interruptNesting[];
+
+// The timer interrupt is level 1, so the port's entry code has already
+// counted it: depth 1 means it interrupted a task. On entry to that outermost
+// interrupt the port saves the task's exception frame and stores its address
+// in pxTopOfStack, the first member of the task control block. Deeper
+// nesting (this tick landed in another ISR) records pc 0 ("[interrupt]").
+// xPortInterruptedFromISRContext() cannot tell the two apart here: it is
+// true in any ISR, this one included.
+static void IRAM_ATTR onTimer() {
+    uint32_t pc = 0;
+    uint32_t caller = 0;
+    if (port_interruptNesting[xPortGetCoreID()] == 1) {
+        const XtExcFrame* frame =
+            *reinterpret_cast<XtExcFrame* const*>(xTaskGetCurrentTaskHandle());
+        pc = static_cast<uint32_t>(frame->pc);
+        caller = ProfileSamples::returnAddress(static_cast<uint32_t>(frame->a0), pc);
+    }
+    ring.push(pc, caller);
+}
+#endif
+
+bool start(uint32_t hz) {
+#ifdef NATIVE_TEST
+    (void)hz;
+    return false;
+#else
+    if (isRunning || hz == 0) {
+        return isRunning;
+    }
+    if (!ring.attached()) {
+        // Internal RAM: the interrupt must not touch PSRAM through the cache
+        void* storage = heap_caps_malloc(RING_SAMPLES * sizeof(ProfileSample), MALLOC_CAP_INTERNAL);
+        if (!storage) {
+            LOG_E("Profiler: no memory for %u samples", static_cast<unsigned>(RING_SAMPLES));
+            return false;
+        }
+        ring.attach(static_cast<ProfileSample*>(storage), RING_SAMPLES);
+    }
+    ring.takeDropped();
+
+    // The interrupt is allocated on, and samples, the calling (loop) core.
+    // Arduino-ESP32 2.x timer API (timerBegin(num, divider, up) and
+    // timerAlarmWrite), as shipped by the espressif32 PlatformIO platform;
+    // core 3.x replaced it with timerBegin(frequency)/timerAlarm().
+    timer = timerBegin(0, 80, true);
+    timerAttachInterrupt(timer, &onTimer, true);
+    timerAlarmWrite(timer, TIMER_TICK_HZ / hz, true);
+    timerAlarmEnable(timer);
+    isRunning = true;
+
+    Log::flush();
+    Serial.printf("~S %lu\n", static_cast<unsigned long>(hz));
+    return true;
+#endif
+}
+
+void stop() {
+    if (!isRunning) {
+        return;
+    }
+#ifndef NATIVE_TEST
+    timerAlarmDisable(timer);
+    timerDetachInterrupt(timer);
+    timerEnd(timer);
+    timer = nullptr;
+#endif
+    isRunning = false;
+    poll();
+    Serial.print("~E\n");
+}
+
+bool running() {
+    return isRunning;
+}
+
+void poll() {
+    if (!ring.attached()) {
+        return;
+    }
+    char buf[SAMPLES_PER_WRITE * ProfileSamples::LINE_CHARS + 1];
+    size_t len = 0;
+    ProfileSample sample;
+    while (ring.pop(sample)) {
+        len += ProfileSamples::formatLine(buf + len, sizeof(buf) - len, sample);
+        if (len + ProfileSamples::LINE_CHARS >= sizeof(buf)) {
+            Serial.write(reinterpret_cast<const uint8_t*>(buf), len);
+            len = 0;
+        }
+    }
+    if (len) {
+        Serial.write(reinterpret_cast<const uint8_t*>(buf), len);
+    }
+
+    uint32_t dropped = ring.takeDropped();
+    if (dropped) {
+        Serial.printf("~X %lu\n", static_cast<unsigned long>(dropped));
+    }
+}
+
+}  // namespace Profiler
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+// Sampling CPU profiler. A hardware timer interrupts the loop core and
+// records the interrupted program counter and its caller; poll() streams the
+// samples over serial as "~P" lines for tools/profile/profile.py to
+// symbolize against the firmware ELF. Wired up in main only with -DPROFILE.
+namespace Profiler {
+
+static constexpr uint32_t DEFAULT_HZ = 1000;
+
+// Start sampling the calling core. Returns false if unavailable (native, or
+// no memory for the ring).
+bool start(uint32_t hz = DEFAULT_HZ);
+void stop();
+bool running();
+
+// Write buffered samples to serial; call once per loop
+void poll();
+
+}  // namespace Profiler
@@ -14,4 +14,19 @@ struct Rect {
     bool contains(int16_t px, int16_t py) const {
         return px >= x && px < x + w && py >= y && py < y + h;
     }
+
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+
+    // Bounding box of both; an empty rect contributes nothing
+    Rect unite(const Rect& other) const {
+        if (other.isEmpty())
+            return *this;
+        if (isEmpty())
+            return other;
+        int16_t left = x < other.x ? x : other.x;
+        int16_t top = y < other.y ? y : other.y;
+        int16_t right = x + w > other.x + other.w ? x + w : other.x + other.w;
+        int16_t bottom = y + h > other.y + other.h ? y + h : other.y + other.h;
+        return Rect(left, top, right - left, bottom - top);
+    }
 };
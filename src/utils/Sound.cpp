@@ -1,10 +1,18 @@
 #include "Sound.hpp"
 #include <M5Unified.h>
+#include "Energy.hpp"
+#include "Trace.hpp"
 
 namespace Sound {
 
 static bool s_enabled = true;
 
+static void tone(float frequency, uint32_t ms) {
+    TRACE_SCOPE("sound");
+    M5.Speaker.tone(frequency, ms);
+    Energy::onSpeaker(ms);
+}
+
 void init() {
     M5.Speaker.begin();
 }
@@ -20,31 +28,31 @@ bool isEnabled() {
 void click() {
     if (!s_enabled)
         return;
-    M5.Speaker.tone(1000, 20);
+    tone(1000, 20);
 }
 
 void lifeUp() {
     if (!s_enabled)
         return;
     // Ascending tone: two quick notes
-    M5.Speaker.tone(800, 25);
+    tone(800, 25);
     delay(30);
-    M5.Speaker.tone(1200, 25);
+    tone(1200, 25);
 }
 
 void lifeDown() {
     if (!s_enabled)
         return;
     // Descending tone: two quick notes
-    M5.Speaker.tone(1200, 25);
+    tone(1200, 25);
     delay(30);
-    M5.Speaker.tone(800, 25);
+    tone(800, 25);
 }
 
 void alert() {
     if (!s_enabled)
         return;
-    M5.Speaker.tone(500, 200);
+    tone(500, 200);
 }
 
 }  // namespace Sound
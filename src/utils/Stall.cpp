@@ -0,0 +1,68 @@
+#include "Stall.hpp"
+#include <cstdio>
+#include "Log.hpp"
+
+namespace Stall {
+
+static StallMonitor monitorInstance;
+
+StallMonitor& monitor() {
+    return monitorInstance;
+}
+
+static void logStall(const StallRecord& stall) {
+    LOG_W("Stall: %s on %s blocked input for %lu ms", stallPhaseName(stall.phase), stall.screenId,
+          static_cast<unsigned long>(stall.durationMs));
+}
+
+void beginLoop() {
+    monitorInstance.beginLoop(millis());
+}
+
+void endLoop() {
+    uint32_t now = millis();
+    if (monitorInstance.endLoop(now)) {
+        StallRecord stall = {monitorInstance.lastLoopMs(), now, StallPhase::Loop, "-"};
+        logStall(stall);
+    }
+}
+
+void Watch::end(StallPhase phase, const char* screenId, uint32_t startMs, uint32_t token) {
+    uint32_t now = millis();
+    if (monitorInstance.endPhase(phase, screenId, startMs, now, token)) {
+        StallRecord stall = {now - startMs, now, phase, screenId};
+        logStall(stall);
+    }
+}
+
+void format(char* buf, size_t len) {
+    uint32_t count = monitorInstance.count();
+    if (count == 0) {
+        snprintf(buf, len, "none over %lums, longest loop %lums",
+                 static_cast<unsigned long>(monitorInstance.thresholdMs()),
+                 static_cast<unsigned long>(monitorInstance.longestLoopMs()));
+        return;
+    }
+    const StallRecord& worst = monitorInstance.worst(0);
+    snprintf(buf, len, "%lu over %lums, worst %lu.%01lus %s on %s",
+             static_cast<unsigned long>(count),
+             static_cast<unsigned long>(monitorInstance.thresholdMs()),
+             static_cast<unsigned long>(worst.durationMs / 1000),
+             static_cast<unsigned long>(worst.durationMs / 100 % 10), stallPhaseName(worst.phase),
+             worst.screenId);
+}
+
+void logReport() {
+    LOG_I("Stalls: %lu over %lu ms, longest loop %lu ms",
+          static_cast<unsigned long>(monitorInstance.count()),
+          static_cast<unsigned long>(monitorInstance.thresholdMs()),
+          static_cast<unsigned long>(monitorInstance.longestLoopMs()));
+    for (int i = 0; i < monitorInstance.worstCount(); i++) {
+        const StallRecord& stall = monitorInstance.worst(i);
+        LOG_I("  %6lu ms %-6s %-10s at %lus", static_cast<unsigned long>(stall.durationMs),
+              stallPhaseName(stall.phase), stall.screenId,
+              static_cast<unsigned long>(stall.atMs / 1000));
+    }
+}
+
+}  // namespace Stall
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstddef>
+#include "StallMonitor.hpp"
+
+// Loop stall detection; see StallMonitor. Navigation times the screen
+// callbacks and main times each loop iteration (excluding the frame wait).
+namespace Stall {
+
+StallMonitor& monitor();
+
+void beginLoop();
+void endLoop();
+
+// Time one screen callback for the duration of the scope
+class Watch {
+   public:
+    Watch(StallPhase phase, const char* screenId)
+        : _phase(phase), _screenId(screenId), _startMs(millis()), _token(monitor().beginPhase()) {}
+    ~Watch() { end(_phase, _screenId, _startMs, _token); }
+
+    Watch(const Watch&) = delete;
+    Watch& operator=(const Watch&) = delete;
+
+   private:
+    StallPhase _phase;
+    const char* _screenId;
+    uint32_t _startMs;
+    uint32_t _token;
+
+    static void end(StallPhase phase, const char* screenId, uint32_t startMs, uint32_t token);
+};
+
+// One-line summary, e.g. "3 over 250ms, worst 10.2s touch on wifi"
+void format(char* buf, size_t len);
+
+// Dump the worst stalls over serial
+void logReport();
+
+}  // namespace Stall
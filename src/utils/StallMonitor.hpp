@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+
+#ifndef STALL_THRESHOLD_MS
+#define STALL_THRESHOLD_MS 250  // Override in build_flags
+#endif
+
+// What the loop was doing when it stalled
+enum class StallPhase : uint8_t {
+    Loop,    // The iteration as a whole (no single callback over the threshold)
+    Enter,   // Screen::onEnter
+    Touch,   // Screen::handleTouch, including button callbacks
+    Update,  // Screen::update
+    Draw,    // Screen::draw, including display()
+};
+
+inline const char* stallPhaseName(StallPhase phase) {
+    switch (phase) {
+        case StallPhase::Enter:
+            return "enter";
+        case StallPhase::Touch:
+            return "touch";
+        case StallPhase::Update:
+            return "update";
+        case StallPhase::Draw:
+            return "draw";
+        default:
+            return "loop";
+    }
+}
+
+struct StallRecord {
+    uint32_t durationMs;
+    uint32_t atMs;         // When it ended
+    StallPhase phase;
+    const char* screenId;  // Static id from Screen::screenId(), "-" for the loop
+};
+
+// Keeps the longest loop iterations and screen callbacks that blocked input
+// for longer than the threshold. Pure logic - timed by Stall on device and
+// driven directly in native tests.
+class StallMonitor {
+   public:
+    static constexpr uint32_t DEFAULT_THRESHOLD_MS = STALL_THRESHOLD_MS;
+    static constexpr int WORST_COUNT = 4;
+
+    StallMonitor() { clear(); }
+
+    void clear() {
+        _count = 0;
+        _worstCount = 0;
+        _longestLoopMs = 0;
+        _lastLoopMs = 0;
+        _loopStartMs = 0;
+        _reportedInLoop = false;
+    }
+
+    void setThresholdMs(uint32_t ms) { _thresholdMs = ms; }
+    uint32_t thresholdMs() const { return _thresholdMs; }
+
+    void beginLoop(uint32_t nowMs) {
+        _loopStartMs = nowMs;
+        _reportedInLoop = false;
+    }
+
+    // Token for endPhase(); callbacks can nest (a touch that pushes a screen)
+    uint32_t beginPhase() const { return _count; }
+
+    // A callback that started at startMs returned. True if it was a stall;
+    // a stall already blamed on a nested callback is not counted again.
+    bool endPhase(StallPhase phase, const char* screenId, uint32_t startMs, uint32_t nowMs,
+                  uint32_t token) {
+        if (_count != token || !record(phase, screenId, nowMs - startMs, nowMs)) {
+            return false;
+        }
+        _reportedInLoop = true;
+        return true;
+    }
+
+    // True if the iteration stalled without a callback to blame
+    bool endLoop(uint32_t nowMs) {
+        _lastLoopMs = nowMs - _loopStartMs;
+        if (_lastLoopMs > _longestLoopMs) {
+            _longestLoopMs = _lastLoopMs;
+        }
+        return !_reportedInLoop && record(StallPhase::Loop, "-", _lastLoopMs, nowMs);
+    }
+
+    uint32_t count() const { return _count; }
+    uint32_t lastLoopMs() const { return _lastLoopMs; }
+    uint32_t longestLoopMs() const { return _longestLoopMs; }
+
+    // Longest first
+    int worstCount() const { return _worstCount; }
+    const StallRecord& worst(int i) const { return _worst[i]; }
+
+   private:
+    uint32_t _thresholdMs = DEFAULT_THRESHOLD_MS;
+    uint32_t _count;
+    uint32_t _longestLoopMs;
+    uint32_t _lastLoopMs;
+    uint32_t _loopStartMs;
+    bool _reportedInLoop;
+    StallRecord _worst[WORST_COUNT];
+    int _worstCount;
+
+    bool record(StallPhase phase, const char* screenId, uint32_t durationMs, uint32_t nowMs) {
+        if (durationMs < _thresholdMs) {
+            return false;
+        }
+        _count++;
+
+        // Insertion into the short sorted list; the shortest falls off
+        int i;
+        if (_worstCount < WORST_COUNT) {
+            i = _worstCount++;
+        } else if (_worst[WORST_COUNT - 1].durationMs >= durationMs) {
+            return true;
+        } else {
+            i = WORST_COUNT - 1;
+        }
+        for (; i > 0 && _worst[i - 1].durationMs < durationMs; i--) {
+            _worst[i] = _worst[i - 1];
+        }
+        _worst[i].durationMs = durationMs;
+        _worst[i].atMs = nowMs;
+        _worst[i].phase = phase;
+        _worst[i].screenId = screenId;
+        return true;
+    }
+};
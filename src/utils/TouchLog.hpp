@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "TouchPoint.hpp"
+
+// One touch as loop() saw it, with the time since the previous event
+struct TouchEvent {
+    uint32_t dtMs;
+    int16_t x;
+    int16_t y;
+    bool pressed;
+    bool released;
+    uint8_t id = 0;  // Touch point; see TouchPoint
+};
+
+// Touch session wire format, one line per event:
+//   ~T app <id>          App on screen when recording started
+//   ~T <dt> <x> <y> <P|R|B> [point]   Pressed, released or both; the touch
+//                                     point id when not 0 (multi-touch)
+//   ~T end <events>
+// Points seen in the same loop follow each other with a dt of 0. Other
+// lines (logs) are ignored, so a captured serial session can be replayed
+// as is.
+namespace TouchLog {
+
+static constexpr size_t LINE_CHARS = 40;
+static constexpr size_t APP_ID_CHARS = 16;
+
+inline char flagChar(bool pressed, bool released) {
+    return pressed && released ? 'B' : released ? 'R' : 'P';
+}
+
+inline size_t formatLine(char* buf, size_t len, const TouchEvent& event) {
+    int n;
+    if (event.id == 0) {
+        n = snprintf(buf, len, "~T %lu %d %d %c\n", static_cast<unsigned long>(event.dtMs),
+                     event.x, event.y, flagChar(event.pressed, event.released));
+    } else {
+        n = snprintf(buf, len, "~T %lu %d %d %c %u\n", static_cast<unsigned long>(event.dtMs),
+                     event.x, event.y, flagChar(event.pressed, event.released), event.id);
+    }
+    return n < 0 ? 0 : (static_cast<size_t>(n) < len ? n : len - 1);
+}
+
+// True for an event line
+inline bool parseEvent(const char* line, TouchEvent& out) {
+    unsigned long dt;
+    int x, y;
+    char flag;
+    unsigned id = 0;
+    if (sscanf(line, "~T %lu %d %d %c %u", &dt, &x, &y, &flag, &id) < 4) {
+        return false;
+    }
+    if ((flag != 'P' && flag != 'R' && flag != 'B') || id >= TouchPoint::MAX_POINTS) {
+        return false;
+    }
+    out.dtMs = static_cast<uint32_t>(dt);
+    out.x = static_cast<int16_t>(x);
+    out.y = static_cast<int16_t>(y);
+    out.pressed = flag != 'R';
+    out.released = flag != 'P';
+    out.id = static_cast<uint8_t>(id);
+    return true;
+}
+
+// True for the "app" line; appId gets up to APP_ID_CHARS - 1 characters
+inline bool parseApp(const char* line, char* appId, size_t len) {
+    if (strncmp(line, "~T app ", 7) != 0 || len == 0) {
+        return false;
+    }
+    const char* id = line + 7;
+    size_t n = 0;
+    while (id[n] && id[n] != '\n' && id[n] != '\r' && id[n] != ' ' && n + 1 < len) {
+        appId[n] = id[n];
+        n++;
+    }
+    appId[n] = '\0';
+    return n > 0;
+}
+
+}  // namespace TouchLog
+
+// Turns the per-loop touch stream into events. A held touch is reported
+// every loop; only its first report and moves are kept, and replay repeats
+// the last press of each point every frame until its next event.
+class TouchLogEncoder {
+   public:
+    void start(uint32_t nowMs) {
+        _lastMs = nowMs;
+        for (Point& point : _points) {
+            point.held = false;
+        }
+        _count = 0;
+    }
+
+    // True when the touch should be recorded; out holds the event
+    bool add(uint32_t nowMs, uint8_t id, int16_t x, int16_t y, bool pressed, bool released,
+             TouchEvent& out) {
+        if ((!pressed && !released) || id >= TouchPoint::MAX_POINTS) {
+            return false;
+        }
+        Point& point = _points[id];
+        if (pressed && !released && point.held && x == point.x && y == point.y) {
+            return false;
+        }
+        out.dtMs = nowMs - _lastMs;
+        out.x = x;
+        out.y = y;
+        out.pressed = pressed;
+        out.released = released;
+        out.id = id;
+        _lastMs = nowMs;
+        point.held = pressed && !released;
+        point.x = x;
+        point.y = y;
+        _count++;
+        return true;
+    }
+
+    // Single-touch stream
+    bool add(uint32_t nowMs, int16_t x, int16_t y, bool pressed, bool released,
+             TouchEvent& out) {
+        return add(nowMs, 0, x, y, pressed, released, out);
+    }
+
+    uint32_t count() const { return _count; }
+
+   private:
+    struct Point {
+        bool held = false;
+        int16_t x = 0;
+        int16_t y = 0;
+    };
+
+    uint32_t _lastMs = 0;
+    Point _points[TouchPoint::MAX_POINTS];
+    uint32_t _count = 0;
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// One finger as loop() passes it to Navigation. The touch controller reports
+// each point with a tracking id that stays the same while the finger is down
+// (the GT911 tracks up to five); pressed is true on every loop it is down,
+// released once when it lifts.
+struct TouchPoint {
+    static constexpr uint8_t MAX_POINTS = 5;
+
+    uint8_t id = 0;
+    int16_t x = 0;
+    int16_t y = 0;
+    bool pressed = false;
+    bool released = false;
+    bool primary = true;  // First finger down; set by Navigation
+};
@@ -0,0 +1,46 @@
+#include "TouchRecorder.hpp"
+#include <Arduino.h>
+#include "Log.hpp"
+#include "TouchLog.hpp"
+
+namespace TouchRecorder {
+
+static TouchLogEncoder encoder;
+static bool isRecording = false;
+
+void start(const char* appId) {
+    if (isRecording) {
+        return;
+    }
+    encoder.start(millis());
+    isRecording = true;
+
+    Log::flush();
+    Serial.printf("~T app %s\n", appId ? appId : "home");
+}
+
+void stop() {
+    if (!isRecording) {
+        return;
+    }
+    isRecording = false;
+    Serial.printf("~T end %lu\n", static_cast<unsigned long>(encoder.count()));
+}
+
+bool recording() {
+    return isRecording;
+}
+
+void onTouch(const TouchPoint& point) {
+    if (!isRecording) {
+        return;
+    }
+    TouchEvent event;
+    if (encoder.add(millis(), point.id, point.x, point.y, point.pressed, point.released, event)) {
+        char line[TouchLog::LINE_CHARS];
+        size_t len = TouchLog::formatLine(line, sizeof(line), event);
+        Serial.write(reinterpret_cast<const uint8_t*>(line), len);
+    }
+}
+
+}  // namespace TouchRecorder
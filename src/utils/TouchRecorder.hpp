@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+#include "TouchPoint.hpp"
+
+// Records the touch stream from loop() as "~T" lines on serial (see
+// TouchLog.hpp) for replay on the host. Wired up in main only with -DTRACE.
+namespace TouchRecorder {
+
+// appId is the app on screen; replay launches it first
+void start(const char* appId);
+void stop();
+bool recording();
+
+// Every touch point loop() passes to Navigation
+void onTouch(const TouchPoint& point);
+
+}  // namespace TouchRecorder
@@ -0,0 +1,98 @@
+#include "Trace.hpp"
+#include <cstdio>
+#include "Log.hpp"
+#include "Memory.hpp"
+
+namespace Trace {
+
+static constexpr size_t CAPACITY = 1024;
+
+static TraceRecorder recorderInstance;
+
+#ifdef NATIVE_TEST
+static TraceEvent hostStorage[CAPACITY];
+#endif
+
+void init() {
+#ifdef NATIVE_TEST
+    recorderInstance.attach(hostStorage, CAPACITY);
+#else
+    void* storage = Memory::allocate(CAPACITY * sizeof(TraceEvent), Memory::Region::Psram);
+    if (!storage) {
+        LOG_E("Trace: no memory for %u events", static_cast<unsigned>(CAPACITY));
+        return;
+    }
+    recorderInstance.attach(static_cast<TraceEvent*>(storage), CAPACITY);
+#endif
+}
+
+TraceRecorder& recorder() {
+    return recorderInstance;
+}
+
+// Names are code literals, but keep the JSON valid whatever they contain
+static void writeEscaped(Sink sink, void* context, const char* text) {
+    char buf[64];
+    size_t n = 0;
+    for (const char* p = text; *p; p++) {
+        if (n + 3 > sizeof(buf)) {
+            buf[n] = '\0';
+            sink(buf, context);
+            n = 0;
+        }
+        if (*p == '"' || *p == '\\') {
+            buf[n++] = '\\';
+        }
+        buf[n++] = static_cast<unsigned char>(*p) < 0x20 ? ' ' : *p;
+    }
+    buf[n] = '\0';
+    sink(buf, context);
+}
+
+void exportJson(Sink sink, void* context) {
+    const TraceRecorder& r = recorderInstance;
+    uint32_t originUs = r.size() ? r.at(0).startUs : 0;
+    for (size_t i = 1; i < r.size(); i++) {
+        if (static_cast<int32_t>(r.at(i).startUs - originUs) < 0) {
+            originUs = r.at(i).startUs;  // Inner spans end first but start earlier
+        }
+    }
+
+    sink("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", context);
+    char buf[96];
+    for (size_t i = 0; i < r.size(); i++) {
+        const TraceEvent& e = r.at(i);
+        sink(i ? ",\n{\"name\":\"" : "\n{\"name\":\"", context);
+        writeEscaped(sink, context, e.name);
+        snprintf(buf, sizeof(buf), "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%lu,\"dur\":%lu",
+                 static_cast<unsigned long>(e.startUs - originUs),
+                 static_cast<unsigned long>(e.durUs));
+        sink(buf, context);
+        if (e.arg) {
+            sink(",\"args\":{\"detail\":\"", context);
+            writeEscaped(sink, context, e.arg);
+            sink("\"}", context);
+        }
+        sink("}", context);
+    }
+    sink("\n]}\n", context);
+}
+
+static void serialSink(const char* text, void* context) {
+    (void)context;
+    Serial.print(text);
+}
+
+void dump() {
+    Log::flush();  // Keep log lines out of the JSON
+    Serial.println("--- TRACE BEGIN ---");
+    exportJson(serialSink, nullptr);
+    Serial.println("--- TRACE END ---");
+    if (recorderInstance.overwritten()) {
+        LOG_W("Trace: %lu older spans were overwritten",
+              static_cast<unsigned long>(recorderInstance.overwritten()));
+    }
+    recorderInstance.clear();
+}
+
+}  // namespace Trace
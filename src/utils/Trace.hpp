@@ -0,0 +1,116 @@
+#pragma once
+
+#include <Arduino.h>
+#include <cstddef>
+#include <cstdint>
+
+// Scoped trace spans for timelines. Compiled in only with -DTRACE (the
+// m5papers3_trace and native envs); otherwise TRACE_SCOPE is empty.
+//
+//   void Navigation::draw(M5GFX* gfx) {
+//       TRACE_SCOPE_ARG("draw", screen->screenId());
+//
+// Names and args must be string literals or other static strings - only
+// the pointers are stored.
+
+struct TraceEvent {
+    const char* name;
+    const char* arg;  // Optional detail, nullptr if none
+    uint32_t startUs;
+    uint32_t durUs;
+};
+
+// Fixed ring of completed spans; when full the oldest are overwritten so
+// the buffer always holds the most recent timeline
+class TraceRecorder {
+   public:
+    void attach(TraceEvent* storage, size_t capacity) {
+        _events = storage;
+        _capacity = capacity;
+        clear();
+    }
+
+    void clear() {
+        _next = 0;
+        _count = 0;
+        _overwritten = 0;
+    }
+
+    void record(const char* name, const char* arg, uint32_t startUs, uint32_t durUs) {
+        if (!_events) {
+            return;
+        }
+        TraceEvent& e = _events[_next];
+        e.name = name;
+        e.arg = arg;
+        e.startUs = startUs;
+        e.durUs = durUs;
+        _next = (_next + 1) % _capacity;
+        if (_count < _capacity) {
+            _count++;
+        } else {
+            _overwritten++;
+        }
+    }
+
+    size_t size() const { return _count; }
+    uint32_t overwritten() const { return _overwritten; }
+
+    // Oldest first
+    const TraceEvent& at(size_t i) const {
+        return _events[(_next + _capacity - _count + i) % _capacity];
+    }
+
+   private:
+    TraceEvent* _events = nullptr;
+    size_t _capacity = 0;
+    size_t _next = 0;
+    size_t _count = 0;
+    uint32_t _overwritten = 0;
+};
+
+namespace Trace {
+
+// Allocate the ring (PSRAM on device); spans before this are not recorded
+void init();
+
+TraceRecorder& recorder();
+
+// Chrome trace-event JSON (chrome://tracing, ui.perfetto.dev), written in
+// pieces to sink. Timestamps are relative to the oldest span.
+using Sink = void (*)(const char* text, void* context);
+void exportJson(Sink sink, void* context);
+
+// Write the JSON to serial between BEGIN/END marker lines, then clear
+void dump();
+
+class Scope {
+   public:
+    explicit Scope(const char* name, const char* arg = nullptr)
+        : _name(name), _arg(arg), _startUs(micros()) {}
+    ~Scope() { recorder().record(_name, _arg, _startUs, micros() - _startUs); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    const char* _name;
+    const char* _arg;
+    uint32_t _startUs;
+};
+
+}  // namespace Trace
+
+#ifdef TRACE
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_SCOPE_ARG(name, arg) Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(name, arg)
+#else
+#define TRACE_SCOPE(name) \
+    do {                  \
+    } while (0)
+#define TRACE_SCOPE_ARG(name, arg) \
+    do {                           \
+    } while (0)
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+// Host stand-in for the Arduino core, used by the native env.
+// Time comes from a virtual clock that tests advance explicitly.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define IRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+namespace HostClock {
+inline uint64_t micros = 0;
+
+inline void set(uint32_t ms) {
+    micros = static_cast<uint64_t>(ms) * 1000;
+}
+inline void advance(uint32_t ms) {
+    micros += static_cast<uint64_t>(ms) * 1000;
+}
+inline void advanceMicros(uint64_t us) {
+    micros += us;
+}
+}  // namespace HostClock
+
+inline unsigned long millis() {
+    return static_cast<unsigned long>(HostClock::micros / 1000);
+}
+inline unsigned long micros() {
+    return static_cast<unsigned long>(HostClock::micros);
+}
+inline void delay(unsigned long ms) {
+    HostClock::advance(ms);
+}
+
+namespace HostCpu {
+inline uint32_t mhz = 240;
+}  // namespace HostCpu
+
+inline bool setCpuFrequencyMhz(uint32_t mhz) {
+    HostCpu::mhz = mhz;
+    return true;
+}
+inline uint32_t getCpuFrequencyMhz() {
+    return HostCpu::mhz;
+}
+
+class String {
+   public:
+    String() = default;
+    String(const char* str) : _str(str ? str : "") {}
+    String(const std::string& str) : _str(str) {}
+
+    const char* c_str() const { return _str.c_str(); }
+    size_t length() const { return _str.size(); }
+    bool isEmpty() const { return _str.empty(); }
+
+    bool operator==(const String& other) const { return _str == other._str; }
+    bool operator==(const char* other) const { return _str == (other ? other : ""); }
+    bool operator!=(const char* other) const { return !(*this == other); }
+
+   private:
+    std::string _str;
+};
+
+struct HostSerial {
+    void begin(unsigned long) {}
+    void flush() {}
+    template <typename... Args>
+    void printf(const char* fmt, Args... args) {
+        std::printf(fmt, args...);
+    }
+    void print(const char* str) { std::fputs(str, stdout); }
+    void println(const char* str = "") { std::puts(str); }
+    size_t write(const uint8_t* data, size_t len) { return std::fwrite(data, 1, len, stdout); }
+    int available() { return 0; }  // No host input
+    int read() { return -1; }
+};
+
+inline HostSerial Serial;
@@ -0,0 +1,67 @@
+#pragma once
+
+// Timing and energy model of an EPD update, used by the headless M5GFX to
+// estimate what each display() would cost on the panel. The panel is driven
+// line by line for every frame of the waveform, so time scales with the rows
+// of the region and the mode's frame count. Charge scales with the area the
+// source drivers switch. A full-panel update in the grey-level modes adds a
+// clearing pass. The defaults are estimates for the Paper S3 (ED047TC1): the
+// fastest mode matches EnergyLedger's default refresh coefficients, and the
+// other modes scale with waveform length. Override with measured figures.
+
+#include <cstdint>
+
+enum epd_mode_t : uint8_t { epd_quality = 1, epd_text = 2, epd_fast = 3, epd_fastest = 4 };
+
+struct EpdModeCost {
+    uint32_t fixedUs;      // Power-up and waveform setup
+    uint32_t rowUs;        // Per row of the region, all frames of the waveform
+    uint32_t fixedUc;      // Charge per update
+    uint32_t megapixelUc;  // Charge per megapixel of region
+    uint32_t fullUs;       // Extra for a full-panel update (clearing pass)
+    uint32_t fullUc;
+};
+
+struct EpdCost {
+    uint32_t us;
+    uint32_t uc;
+    bool full;
+};
+
+class EpdModel {
+   public:
+    static constexpr int MODES = 4;
+
+    EpdModel() { setDefaults(); }
+
+    void setDefaults() {
+        //                          fixed     row  fixedUc   /Mpx  fullUs  fullUc
+        _costs[index(epd_quality)] = {100000, 1700, 105000, 210000, 400000, 60000};
+        _costs[index(epd_text)] = {60000, 1000, 60000, 120000, 200000, 30000};
+        _costs[index(epd_fast)] = {40000, 500, 30000, 60000, 0, 0};
+        _costs[index(epd_fastest)] = {20000, 240, 15000, 30000, 0, 0};
+    }
+
+    void setCost(epd_mode_t mode, const EpdModeCost& cost) { _costs[index(mode)] = cost; }
+    const EpdModeCost& cost(epd_mode_t mode) const { return _costs[index(mode)]; }
+
+    // Cost of one update of a w x h region of a panelW x panelH panel
+    EpdCost update(epd_mode_t mode, int32_t w, int32_t h, int32_t panelW,
+                   int32_t panelH) const {
+        const EpdModeCost& c = cost(mode);
+        EpdCost out;
+        out.full = w >= panelW && h >= panelH;
+        uint64_t pixels = static_cast<uint64_t>(w) * h;
+        out.us = c.fixedUs + c.rowUs * static_cast<uint32_t>(h) + (out.full ? c.fullUs : 0);
+        out.uc = c.fixedUc + static_cast<uint32_t>(c.megapixelUc * pixels / 1000000) +
+                 (out.full ? c.fullUc : 0);
+        return out;
+    }
+
+   private:
+    EpdModeCost _costs[MODES];
+
+    static int index(epd_mode_t mode) {
+        return mode >= epd_quality && mode <= epd_fastest ? mode - epd_quality : 0;
+    }
+};
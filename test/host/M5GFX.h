@@ -0,0 +1,242 @@
+#pragma once
+
+// Headless stand-in for M5GFX, used by the native env.
+// Draws into an 8-bit grayscale framebuffer and keeps a second buffer for
+// what the panel currently shows, so display() can report refreshed and
+// changed pixels, and estimates panel time and charge per update with an
+// EpdModel. Text uses the 6x8 GLCD cell metrics, with each glyph
+// rendered as a solid block.
+
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include "Arduino.h"
+#include "EpdModel.h"
+
+enum textdatum_t : uint8_t {
+    TL_DATUM = 0,
+    TC_DATUM = 1,
+    TR_DATUM = 2,
+    ML_DATUM = 4,
+    MC_DATUM = 5,
+    MR_DATUM = 6,
+    BL_DATUM = 8,
+    BC_DATUM = 9,
+    BR_DATUM = 10,
+};
+
+static constexpr uint32_t TFT_BLACK = 0x0000;
+static constexpr uint32_t TFT_WHITE = 0xFFFF;
+static constexpr uint32_t TFT_DARKGREY = 0x7BEF;
+static constexpr uint32_t TFT_LIGHTGREY = 0xD69A;
+
+struct HostDisplayStats {
+    uint32_t drawCalls = 0;
+    uint32_t displayCalls = 0;
+    uint64_t refreshedPixels = 0;  // Sum of dirty-rect areas pushed by display()
+    uint64_t changedPixels = 0;    // Pixels whose value differed from the panel
+    uint32_t fullRefreshes = 0;    // Updates covering the whole panel
+    uint64_t panelUs = 0;          // Estimated panel update time (EpdModel)
+    uint64_t panelUc = 0;          // Estimated panel charge, microcoulombs
+};
+
+class M5GFX {
+   public:
+    static constexpr int32_t WIDTH = 960;
+    static constexpr int32_t HEIGHT = 540;
+
+    M5GFX() : _frame(WIDTH * HEIGHT, 0xFF), _panel(WIDTH * HEIGHT, 0xFF) {}
+
+    int32_t width() const { return WIDTH; }
+    int32_t height() const { return HEIGHT; }
+    void setRotation(uint8_t) {}
+    void setEpdMode(epd_mode_t mode) { _epdMode = mode; }
+    epd_mode_t getEpdMode() const { return _epdMode; }
+    void startWrite() {}
+    void endWrite() {}
+    void waitDisplay() {}
+    bool displayBusy() const { return false; }
+
+    void setTextColor(uint32_t fg) { _textColor = fg; }
+    void setTextColor(uint32_t fg, uint32_t) { _textColor = fg; }
+    void setTextDatum(textdatum_t datum) { _datum = datum; }
+    void setTextSize(float size) { _textSize = size < 1 ? 1 : static_cast<int32_t>(size); }
+    int32_t textWidth(const char* str) const {
+        return static_cast<int32_t>(strlen(str)) * 6 * _textSize;
+    }
+    int32_t fontHeight() const { return 8 * _textSize; }
+
+    void fillScreen(uint32_t color) { fillRect(0, 0, WIDTH, HEIGHT, color); }
+
+    void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+        _stats.drawCalls++;
+        if (!clip(x, y, w, h))
+            return;
+        uint8_t gray = toGray(color);
+        for (int32_t row = y; row < y + h; row++) {
+            memset(&_frame[row * WIDTH + x], gray, w);
+        }
+        markDirty(x, y, w, h);
+    }
+
+    void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+        if (w <= 0 || h <= 0)
+            return;
+        fillRect(x, y, w, 1, color);
+        fillRect(x, y + h - 1, w, 1, color);
+        fillRect(x, y, 1, h, color);
+        fillRect(x + w - 1, y, 1, h, color);
+    }
+
+    void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+        if (y0 == y1) {
+            fillRect(x0 < x1 ? x0 : x1, y0, (x1 > x0 ? x1 - x0 : x0 - x1) + 1, 1, color);
+        } else if (x0 == x1) {
+            fillRect(x0, y0 < y1 ? y0 : y1, 1, (y1 > y0 ? y1 - y0 : y0 - y1) + 1, color);
+        } else {
+            // Diagonal lines are not used by the UI; approximate with the bounding box
+            int32_t x = x0 < x1 ? x0 : x1;
+            int32_t y = y0 < y1 ? y0 : y1;
+            drawRect(x, y, (x0 > x1 ? x0 - x1 : x1 - x0) + 1, (y0 > y1 ? y0 - y1 : y1 - y0) + 1,
+                     color);
+        }
+    }
+
+    void drawBitmap(int32_t x, int32_t y, const uint8_t* bitmap, int32_t w, int32_t h,
+                    uint32_t color) {
+        _stats.drawCalls++;
+        uint8_t gray = toGray(color);
+        int32_t bytesPerRow = (w + 7) / 8;
+        for (int32_t row = 0; row < h; row++) {
+            for (int32_t col = 0; col < w; col++) {
+                if (bitmap[row * bytesPerRow + col / 8] & (0x80 >> (col % 8))) {
+                    setPixel(x + col, y + row, gray);
+                }
+            }
+        }
+        int32_t cx = x, cy = y, cw = w, ch = h;
+        if (clip(cx, cy, cw, ch))
+            markDirty(cx, cy, cw, ch);
+    }
+
+    void drawString(const char* str, int32_t x, int32_t y) {
+        int32_t len = static_cast<int32_t>(strlen(str));
+        int32_t cellW = 6 * _textSize;
+        int32_t cellH = 8 * _textSize;
+        int32_t w = len * cellW;
+        int32_t h = cellH;
+
+        int32_t hAlign = _datum & 3;
+        int32_t vAlign = _datum & 12;
+        if (hAlign == 1)
+            x -= w / 2;
+        else if (hAlign == 2)
+            x -= w;
+        if (vAlign == 4)
+            y -= h / 2;
+        else if (vAlign == 8)
+            y -= h;
+
+        for (int32_t i = 0; i < len; i++) {
+            if (str[i] != ' ') {
+                fillRect(x + i * cellW, y, cellW - _textSize, cellH - _textSize, _textColor);
+            }
+        }
+    }
+
+    void drawNumber(long value, int32_t x, int32_t y) {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%ld", value);
+        drawString(buf, x, y);
+    }
+
+    void display() {
+        _stats.displayCalls++;
+        if (_dirtyW <= 0 || _dirtyH <= 0)
+            return;
+        _stats.refreshedPixels += static_cast<uint64_t>(_dirtyW) * _dirtyH;
+        EpdCost cost = _epd.update(_epdMode, _dirtyW, _dirtyH, WIDTH, HEIGHT);
+        _stats.fullRefreshes += cost.full ? 1 : 0;
+        _stats.panelUs += cost.us;
+        _stats.panelUc += cost.uc;
+        for (int32_t row = _dirtyY; row < _dirtyY + _dirtyH; row++) {
+            for (int32_t col = _dirtyX; col < _dirtyX + _dirtyW; col++) {
+                int32_t i = row * WIDTH + col;
+                if (_frame[i] != _panel[i]) {
+                    _stats.changedPixels++;
+                    _panel[i] = _frame[i];
+                }
+            }
+        }
+        _dirtyW = _dirtyH = 0;
+    }
+
+    // Host-only: a reboot loses the framebuffer, but the EPD keeps its image
+    void hostPowerCycle() {
+        std::fill(_frame.begin(), _frame.end(), 0xFF);
+        _dirtyW = _dirtyH = 0;
+    }
+
+    // Host-only inspection
+    const HostDisplayStats& hostStats() const { return _stats; }
+    void hostResetStats() { _stats = HostDisplayStats(); }
+    EpdModel& hostEpdModel() { return _epd; }
+    uint8_t hostPixel(int32_t x, int32_t y) const { return _frame[y * WIDTH + x]; }
+    uint8_t hostPanelPixel(int32_t x, int32_t y) const { return _panel[y * WIDTH + x]; }
+
+   private:
+    std::vector<uint8_t> _frame;
+    std::vector<uint8_t> _panel;
+    HostDisplayStats _stats;
+    EpdModel _epd;
+    epd_mode_t _epdMode = epd_quality;
+    textdatum_t _datum = TL_DATUM;
+    uint32_t _textColor = TFT_BLACK;
+    int32_t _textSize = 1;
+    int32_t _dirtyX = 0, _dirtyY = 0, _dirtyW = 0, _dirtyH = 0;
+
+    static uint8_t toGray(uint32_t color565) {
+        uint32_t r = (color565 >> 11) & 0x1F;
+        uint32_t g = (color565 >> 5) & 0x3F;
+        uint32_t b = color565 & 0x1F;
+        return static_cast<uint8_t>((r * 255 / 31 * 3 + g * 255 / 63 * 6 + b * 255 / 31) / 10);
+    }
+
+    static bool clip(int32_t& x, int32_t& y, int32_t& w, int32_t& h) {
+        if (x < 0) {
+            w += x;
+            x = 0;
+        }
+        if (y < 0) {
+            h += y;
+            y = 0;
+        }
+        if (x + w > WIDTH)
+            w = WIDTH - x;
+        if (y + h > HEIGHT)
+            h = HEIGHT - y;
+        return w > 0 && h > 0;
+    }
+
+    void setPixel(int32_t x, int32_t y, uint8_t gray) {
+        if (x >= 0 && y >= 0 && x < WIDTH && y < HEIGHT)
+            _frame[y * WIDTH + x] = gray;
+    }
+
+    void markDirty(int32_t x, int32_t y, int32_t w, int32_t h) {
+        if (_dirtyW <= 0 || _dirtyH <= 0) {
+            _dirtyX = x;
+            _dirtyY = y;
+            _dirtyW = w;
+            _dirtyH = h;
+            return;
+        }
+        int32_t x1 = x + w > _dirtyX + _dirtyW ? x + w : _dirtyX + _dirtyW;
+        int32_t y1 = y + h > _dirtyY + _dirtyH ? y + h : _dirtyY + _dirtyH;
+        _dirtyX = x < _dirtyX ? x : _dirtyX;
+        _dirtyY = y < _dirtyY ? y : _dirtyY;
+        _dirtyW = x1 - _dirtyX;
+        _dirtyH = y1 - _dirtyY;
+    }
+};
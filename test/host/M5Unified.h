@@ -0,0 +1,118 @@
+#pragma once
+
+// Host stand-in for M5Unified, used by the native env.
+// Touch, battery and RTC values are set by tests; outputs are counted.
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include "Arduino.h"
+#include "M5GFX.h"
+
+namespace m5 {
+struct touch_detail_t {
+    uint8_t id = 0;
+    int16_t x = 0;
+    int16_t y = 0;
+    bool pressed = false;
+    bool released = false;
+
+    bool isPressed() const { return pressed; }
+    bool wasReleased() const { return released; }
+};
+
+struct rtc_time_t {
+    int8_t hours = 0;
+    int8_t minutes = 0;
+    int8_t seconds = 0;
+};
+
+struct rtc_datetime_t {
+    rtc_time_t time;
+};
+}  // namespace m5
+
+struct HostConfig {
+    uint32_t serial_baudrate = 115200;
+};
+
+struct HostTouch {
+    static constexpr uint8_t MAX_POINTS = 5;
+
+    uint8_t count = 0;
+    m5::touch_detail_t details[MAX_POINTS];
+
+    uint8_t getCount() const { return count; }
+    const m5::touch_detail_t& getDetail(size_t index = 0) const {
+        return details[index < MAX_POINTS ? index : 0];
+    }
+};
+
+struct HostPower {
+    int32_t batteryLevel = 100;
+    int16_t batteryVoltage = 4100;
+    uint32_t powerOffCalls = 0;
+    uint32_t deepSleepCalls = 0;
+    uint64_t deepSleepUs = 0;  // Timer armed by the last deepSleep(); 0 = touch only
+
+    int32_t getBatteryLevel() const { return batteryLevel; }
+    int16_t getBatteryVoltage() const { return batteryVoltage; }
+    void powerOff() { powerOffCalls++; }
+    void deepSleep(uint64_t microSeconds = 0, bool touchWakeup = true) {
+        (void)touchWakeup;
+        deepSleepUs = microSeconds;
+        deepSleepCalls++;
+    }
+};
+
+struct HostSpeaker {
+    uint32_t toneCalls = 0;
+
+    bool begin() { return true; }
+    bool tone(float frequency, uint32_t durationMs) {
+        (void)frequency;
+        (void)durationMs;
+        toneCalls++;
+        return true;
+    }
+};
+
+struct HostRtc {
+    m5::rtc_datetime_t getDateTime() const {
+        uint32_t secs = millis() / 1000;
+        m5::rtc_datetime_t dt;
+        dt.time.hours = static_cast<int8_t>((secs / 3600) % 24);
+        dt.time.minutes = static_cast<int8_t>((secs / 60) % 60);
+        dt.time.seconds = static_cast<int8_t>(secs % 60);
+        return dt;
+    }
+};
+
+struct HostImu {
+    bool isEnabled() const { return false; }
+};
+
+struct HostLog {
+    void printf(const char* fmt, ...) {
+        va_list args;
+        va_start(args, fmt);
+        vprintf(fmt, args);
+        va_end(args);
+    }
+};
+
+struct HostM5 {
+    M5GFX Display;
+    HostTouch Touch;
+    HostPower Power;
+    HostSpeaker Speaker;
+    HostRtc Rtc;
+    HostImu Imu;
+    HostLog Log;
+
+    HostConfig config() const { return HostConfig(); }
+    void begin(const HostConfig&) {}
+    void update() {}
+};
+
+inline HostM5 M5;
@@ -0,0 +1,302 @@
+#pragma once
+
+// Model of the ESP-IDF NVS layer on flash, fed by the host Preferences.
+// The partition is a ring of 4 KB sectors ("pages"), each holding 126
+// 32-byte entries after its header and entry-state bitmap. Writing a key
+// appends its entries to the active page and marks the old copy erased; a
+// write with the value already stored is skipped, as in NVS. When only the
+// reserved page is left free, the page with the most erased entries is
+// garbage collected: its live entries move to the reserved page and the
+// sector is erased. Counts programmed entries and erases per sector so
+// persistence policies can be compared by wear. Blobs are modelled as one
+// item like strings (no separate index entry).
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class NvsFlash {
+   public:
+    static constexpr uint32_t PAGE_BYTES = 4096;
+    static constexpr uint32_t ENTRY_BYTES = 32;
+    static constexpr uint32_t ENTRIES_PER_PAGE = 126;
+    static constexpr uint32_t DEFAULT_PAGES = 5;  // 20 KB "nvs" partition (default_16MB.csv)
+
+    struct Sector {
+        uint32_t erases = 0;
+        uint32_t entryWrites = 0;   // Entries programmed (data and moves)
+        uint32_t bitmapWrites = 0;  // Entry-state updates
+    };
+
+    explicit NvsFlash(uint32_t pages = DEFAULT_PAGES) { format(pages); }
+
+    void format(uint32_t pages) {
+        _pages.assign(pages, Page());
+        _sectors.assign(pages, Sector());
+        _active = 0;
+        _seq = 0;
+        open(0);
+        _writes = 0;
+        _skipped = 0;
+        _moved = 0;
+        _failed = 0;
+    }
+
+    // Entries an item of this size takes: the item itself, then data entries
+    // for strings and blobs
+    static uint32_t span(size_t len, bool variable) {
+        if (!variable) {
+            return 1;
+        }
+        return 1 + static_cast<uint32_t>((len + ENTRY_BYTES - 1) / ENTRY_BYTES);
+    }
+
+    // Returns false when the partition is full
+    bool write(const char* ns, const char* key, const uint8_t* data, size_t len, bool variable) {
+        uint32_t keyHash = hash(ns, strlen(ns), hash(key, strlen(key), FNV_BASIS));
+        uint32_t dataHash = hash(data, len, FNV_BASIS);
+        Item* old = find(keyHash);
+        if (old && old->dataHash == dataHash) {
+            _skipped++;
+            return true;
+        }
+        Item item;
+        item.keyHash = keyHash;
+        item.dataHash = dataHash;
+        item.span = span(len, variable);
+        if (!append(item)) {
+            _failed++;
+            return false;
+        }
+        _writes++;
+        eraseOld(keyHash, _active, _pages[_active].count - 1);
+        return true;
+    }
+
+    void remove(const char* ns, const char* key) {
+        eraseOld(hash(ns, strlen(ns), hash(key, strlen(key), FNV_BASIS)), UINT32_MAX, 0);
+    }
+
+    uint32_t pageCount() const { return static_cast<uint32_t>(_pages.size()); }
+    const Sector& sector(uint32_t page) const { return _sectors[page]; }
+    uint32_t writes() const { return _writes; }    // Items written
+    uint32_t skipped() const { return _skipped; }  // Writes of an unchanged value
+    uint32_t moved() const { return _moved; }      // Items copied by garbage collection
+    uint32_t failed() const { return _failed; }
+
+    uint32_t maxErases() const {
+        uint32_t max = 0;
+        for (const Sector& s : _sectors) {
+            max = s.erases > max ? s.erases : max;
+        }
+        return max;
+    }
+
+    uint64_t totalErases() const {
+        uint64_t total = 0;
+        for (const Sector& s : _sectors) {
+            total += s.erases;
+        }
+        return total;
+    }
+
+    uint64_t entryWrites() const {
+        uint64_t total = 0;
+        for (const Sector& s : _sectors) {
+            total += s.entryWrites;
+        }
+        return total;
+    }
+
+    // Sector erases the written entries will cost once the ring wraps: every
+    // ENTRIES_PER_PAGE entries fill a page that must be erased to be reused.
+    // Also right for runs too short to have erased anything yet.
+    double steadyStateErases() const {
+        return static_cast<double>(entryWrites()) / ENTRIES_PER_PAGE;
+    }
+
+   private:
+    enum class PageState : uint8_t { Empty, Active, Full };
+
+    // Items are told apart by hash, as the NVS item hash list does; the model
+    // keeps no payloads and allocates nothing after format()
+    struct Item {
+        uint32_t keyHash = 0;
+        uint32_t dataHash = 0;
+        uint32_t span = 1;
+        bool live = true;
+    };
+
+    struct Page {
+        PageState state = PageState::Empty;
+        uint32_t used = 0;    // Entries programmed since the last erase
+        uint32_t erased = 0;  // Of those, superseded or removed
+        uint32_t count = 0;
+        uint32_t seq = 0;  // Order the page was opened in
+        Item items[ENTRIES_PER_PAGE];
+    };
+
+    static constexpr uint32_t FNV_BASIS = 2166136261u;
+
+    std::vector<Page> _pages;
+    std::vector<Sector> _sectors;
+    uint32_t _active = 0;
+    uint32_t _seq = 0;
+    uint32_t _writes = 0;
+    uint32_t _skipped = 0;
+    uint32_t _moved = 0;
+    uint32_t _failed = 0;
+
+    static uint32_t hash(const void* data, size_t len, uint32_t h) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; i++) {
+            h = (h ^ p[i]) * 16777619u;
+        }
+        return (h ^ 0xff) * 16777619u;  // Separates "ab"+"c" from "a"+"bc"
+    }
+
+    Item* find(uint32_t keyHash) {
+        for (Page& page : _pages) {
+            for (uint32_t i = 0; i < page.count; i++) {
+                if (page.items[i].live && page.items[i].keyHash == keyHash) {
+                    return &page.items[i];
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // Mark every live copy except the one at (keepPage, keepIndex) erased
+    void eraseOld(uint32_t keyHash, uint32_t keepPage, uint32_t keepIndex) {
+        for (uint32_t p = 0; p < _pages.size(); p++) {
+            Page& page = _pages[p];
+            for (uint32_t i = 0; i < page.count; i++) {
+                Item& item = page.items[i];
+                if (!item.live || item.keyHash != keyHash || (p == keepPage && i == keepIndex)) {
+                    continue;
+                }
+                item.live = false;
+                page.erased += item.span;
+                _sectors[p].bitmapWrites++;
+            }
+        }
+    }
+
+    void program(uint32_t p, const Item& item) {
+        Page& page = _pages[p];
+        page.items[page.count++] = item;
+        page.used += item.span;
+        _sectors[p].entryWrites += item.span;
+        _sectors[p].bitmapWrites++;
+    }
+
+    void open(uint32_t p) {
+        _pages[p].state = PageState::Active;
+        _pages[p].seq = _seq++;
+    }
+
+    int freePages() const {
+        int free = 0;
+        for (const Page& page : _pages) {
+            free += page.state == PageState::Empty ? 1 : 0;
+        }
+        return free;
+    }
+
+    // The next empty page after the active one, so the ring rotates
+    uint32_t nextEmpty() const {
+        for (uint32_t i = 1; i <= _pages.size(); i++) {
+            uint32_t p = (_active + i) % _pages.size();
+            if (_pages[p].state == PageState::Empty) {
+                return p;
+            }
+        }
+        return _active;
+    }
+
+    bool append(const Item& item) {
+        if (item.span > ENTRIES_PER_PAGE) {
+            return false;
+        }
+        for (uint32_t attempt = 0; attempt <= _pages.size(); attempt++) {
+            Page& active = _pages[_active];
+            if (active.used + item.span <= ENTRIES_PER_PAGE) {
+                program(_active, item);
+                return true;
+            }
+            active.state = PageState::Full;
+            if (!requestPage()) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    // One empty page is kept in reserve for garbage collection
+    bool requestPage() {
+        if (freePages() > 1) {
+            _active = nextEmpty();
+            open(_active);
+            return true;
+        }
+
+        // Most erased entries; the oldest page on a tie, as NVS walks its
+        // page list in sequence order
+        uint32_t victim = _active;
+        uint32_t mostErased = 0;
+        for (uint32_t p = 0; p < _pages.size(); p++) {
+            const Page& page = _pages[p];
+            if (page.state != PageState::Full) {
+                continue;
+            }
+            if (page.erased > mostErased ||
+                (page.erased == mostErased && mostErased > 0 && page.seq < _pages[victim].seq)) {
+                mostErased = page.erased;
+                victim = p;
+            }
+        }
+        if (mostErased == 0 || freePages() == 0) {
+            return false;
+        }
+
+        uint32_t target = nextEmpty();
+        open(target);
+        for (uint32_t i = 0; i < _pages[victim].count; i++) {
+            const Item& item = _pages[victim].items[i];
+            if (item.live) {
+                program(target, item);
+                _moved++;
+            }
+        }
+        _pages[victim] = Page();
+        _sectors[victim].erases++;
+        _active = target;
+        return true;
+    }
+};
+
+// Flash wear projection from a simulated stretch of use
+namespace NvsWear {
+
+static constexpr uint32_t ENDURANCE_CYCLES = 100000;  // Erase cycles per sector (NOR flash)
+static constexpr double PLAY_HOURS_PER_YEAR = 4.0 * 52;  // A weekly four-hour game night
+
+// Hours of the simulated use until the sectors reach the endurance limit.
+// Garbage collection rotates through the sectors, but a page holding data
+// that never changes (names, settings) always has fewer erased entries and
+// is never picked, so wear is spread over one page fewer than the partition.
+// Entries moved by GC count as written.
+inline double hoursToWearOut(const NvsFlash& flash, double simulatedHours) {
+    uint32_t sectors = flash.pageCount() > 1 ? flash.pageCount() - 1 : 1;
+    double erasesPerSector = flash.steadyStateErases() / sectors;
+    if (erasesPerSector <= 0) {
+        return 1e12;
+    }
+    return ENDURANCE_CYCLES * simulatedHours / erasesPerSector;
+}
+
+inline double yearsToWearOut(const NvsFlash& flash, double simulatedHours) {
+    return hoursToWearOut(flash, simulatedHours) / PLAY_HOURS_PER_YEAR;
+}
+
+}  // namespace NvsWear
@@ -0,0 +1,151 @@
+#pragma once
+
+// Host stand-in for the ESP32 Preferences (NVS) library, used by the native env.
+// Values live in memory per namespace; writes are counted for tests and fed
+// to an NvsFlash model of the partition for wear figures.
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "NvsFlash.h"
+
+struct HostNvs {
+    std::map<std::string, std::map<std::string, std::vector<uint8_t>>> data;
+    uint32_t writes = 0;  // put*/remove calls that reached storage
+    uint32_t reads = 0;   // get* calls on an open namespace
+    NvsFlash flash;
+
+    static HostNvs& instance() {
+        static HostNvs nvs;
+        return nvs;
+    }
+
+    void clear() {
+        data.clear();
+        writes = 0;
+        reads = 0;
+        flash.format(NvsFlash::DEFAULT_PAGES);
+    }
+};
+
+class Preferences {
+   public:
+    bool begin(const char* name, bool readOnly = false) {
+        auto& nvs = HostNvs::instance();
+        if (readOnly && nvs.data.find(name) == nvs.data.end())
+            return false;  // Matches NVS: read-only open of a missing namespace fails
+        if (nvs.data.find(name) == nvs.data.end()) {
+            uint8_t index = static_cast<uint8_t>(nvs.data.size() + 1);
+            nvs.flash.write("", name, &index, sizeof(index), false);  // Namespace entry
+        }
+        _ns = &nvs.data[name];
+        strncpy(_name, name, sizeof(_name) - 1);
+        _readOnly = readOnly;
+        return true;
+    }
+
+    void end() { _ns = nullptr; }
+
+    bool remove(const char* key) {
+        if (!_ns || _readOnly)
+            return false;
+        HostNvs::instance().writes++;
+        HostNvs::instance().flash.remove(_name, key);
+        return _ns->erase(key) > 0;
+    }
+
+    bool isKey(const char* key) const { return _ns && _ns->count(key) > 0; }
+
+    size_t putBool(const char* key, bool value) { return putRaw(key, &value, sizeof(value)); }
+    size_t putUChar(const char* key, uint8_t value) { return putRaw(key, &value, sizeof(value)); }
+    size_t putShort(const char* key, int16_t value) { return putRaw(key, &value, sizeof(value)); }
+    size_t putUShort(const char* key, uint16_t value) {
+        return putRaw(key, &value, sizeof(value));
+    }
+    size_t putInt(const char* key, int32_t value) { return putRaw(key, &value, sizeof(value)); }
+    size_t putUInt(const char* key, uint32_t value) { return putRaw(key, &value, sizeof(value)); }
+    size_t putFloat(const char* key, float value) { return putRaw(key, &value, sizeof(value)); }
+    size_t putBytes(const char* key, const void* value, size_t len) {
+        return putRaw(key, value, len, true);
+    }
+    size_t putString(const char* key, const char* value) {
+        return putRaw(key, value, strlen(value) + 1, true);
+    }
+    size_t putString(const char* key, const String& value) {
+        return putString(key, value.c_str());
+    }
+
+    bool getBool(const char* key, bool def = false) const { return getRaw(key, def); }
+    uint8_t getUChar(const char* key, uint8_t def = 0) const { return getRaw(key, def); }
+    int16_t getShort(const char* key, int16_t def = 0) const { return getRaw(key, def); }
+    uint16_t getUShort(const char* key, uint16_t def = 0) const { return getRaw(key, def); }
+    int32_t getInt(const char* key, int32_t def = 0) const { return getRaw(key, def); }
+    uint32_t getUInt(const char* key, uint32_t def = 0) const { return getRaw(key, def); }
+    float getFloat(const char* key, float def = 0) const { return getRaw(key, def); }
+
+    size_t getBytesLength(const char* key) const {
+        const auto* value = find(key);
+        return value ? value->size() : 0;
+    }
+
+    size_t getBytes(const char* key, void* buf, size_t maxLen) const {
+        const auto* value = find(key);
+        if (!value || value->size() > maxLen)
+            return 0;
+        memcpy(buf, value->data(), value->size());
+        return value->size();
+    }
+
+    String getString(const char* key, const String& def = String()) const {
+        const auto* value = find(key);
+        if (!value)
+            return def;
+        return String(reinterpret_cast<const char*>(value->data()));
+    }
+
+    // Matches NVS: returns 0 and leaves buf untouched if missing or too long
+    size_t getString(const char* key, char* buf, size_t maxLen) const {
+        const auto* value = find(key);
+        if (!value || value->size() > maxLen)
+            return 0;
+        memcpy(buf, value->data(), value->size());
+        return value->size();
+    }
+
+   private:
+    std::map<std::string, std::vector<uint8_t>>* _ns = nullptr;
+    char _name[16] = {};  // NVS namespace names are at most 15 characters
+    bool _readOnly = false;
+
+    const std::vector<uint8_t>* find(const char* key) const {
+        if (!_ns)
+            return nullptr;
+        HostNvs::instance().reads++;
+        auto it = _ns->find(key);
+        return it == _ns->end() ? nullptr : &it->second;
+    }
+
+    // variable: stored as a string/blob item rather than inline
+    size_t putRaw(const char* key, const void* value, size_t len, bool variable = false) {
+        if (!_ns || _readOnly)
+            return 0;
+        HostNvs::instance().writes++;
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        HostNvs::instance().flash.write(_name, key, bytes, len, variable);
+        (*_ns)[key].assign(bytes, bytes + len);
+        return len;
+    }
+
+    template <typename T>
+    T getRaw(const char* key, T def) const {
+        const auto* value = find(key);
+        if (!value || value->size() != sizeof(T))
+            return def;
+        T out;
+        memcpy(&out, value->data(), sizeof(T));
+        return out;
+    }
+};
@@ -0,0 +1,80 @@
+#pragma once
+
+// Host stand-in for the ESP32 WiFi library, used by the native env.
+// Scan results and connection state are injected by tests.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+enum wl_status_t { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 };
+enum wifi_mode_t { WIFI_OFF = 0, WIFI_STA = 1 };
+enum wifi_ps_type_t { WIFI_PS_NONE = 0, WIFI_PS_MIN_MODEM = 1, WIFI_PS_MAX_MODEM = 2 };
+enum wifi_auth_mode_t { WIFI_AUTH_OPEN = 0, WIFI_AUTH_WPA2_PSK = 3 };
+
+struct IPAddress {
+    String toString() const { return String("192.168.0.2"); }
+};
+
+struct HostScanResult {
+    std::string ssid;
+    int32_t rssi;
+    wifi_auth_mode_t auth;
+};
+
+class HostWiFi {
+   public:
+    std::vector<HostScanResult> scanResults;
+    wl_status_t currentStatus = WL_DISCONNECTED;
+    std::string connectedSsid;
+    int32_t connectedRssi = -60;
+    uint32_t scanCalls = 0;
+    wifi_ps_type_t sleepMode = WIFI_PS_MIN_MODEM;
+
+    wl_status_t status() const { return currentStatus; }
+    bool mode(wifi_mode_t m) {
+        _mode = m;
+        return true;
+    }
+    wifi_mode_t getMode() const { return _mode; }
+    bool setSleep(wifi_ps_type_t type) {
+        sleepMode = type;
+        return true;
+    }
+
+    int begin(const char* ssid, const char* pass = nullptr) {
+        (void)pass;
+        connectedSsid = ssid ? ssid : "";
+        currentStatus = WL_CONNECTED;
+        return currentStatus;
+    }
+
+    bool disconnect(bool wifiOff = false, bool eraseAp = false) {
+        (void)wifiOff;
+        (void)eraseAp;
+        currentStatus = WL_DISCONNECTED;
+        connectedSsid.clear();
+        return true;
+    }
+
+    int16_t scanNetworks(bool async = false, bool showHidden = false) {
+        (void)async;
+        (void)showHidden;
+        scanCalls++;
+        return static_cast<int16_t>(scanResults.size());
+    }
+    void scanDelete() {}
+
+    String SSID() const { return String(connectedSsid); }
+    String SSID(int i) const { return String(scanResults[i].ssid); }
+    int32_t RSSI() const { return connectedRssi; }
+    int32_t RSSI(int i) const { return scanResults[i].rssi; }
+    wifi_auth_mode_t encryptionType(int i) const { return scanResults[i].auth; }
+    IPAddress localIP() const { return IPAddress(); }
+
+   private:
+    wifi_mode_t _mode = WIFI_OFF;
+};
+
+inline HostWiFi WiFi;
@@ -0,0 +1,92 @@
+#pragma once
+
+// Host stand-in for ESP-IDF heap_caps, used by the native env.
+// Simulates the internal SRAM and PSRAM heaps of the M5Paper S3 so memory
+// reports and budgets behave as on device. Tests that replace operator new
+// attribute those allocations to the internal heap via HostHeap::note().
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+struct HostHeap {
+    static constexpr size_t INTERNAL_TOTAL = 320 * 1024;
+    static constexpr size_t PSRAM_TOTAL = 8 * 1024 * 1024;
+
+    size_t internalUsed = 0;
+    size_t psramUsed = 0;
+    size_t internalPeak = 0;
+    size_t psramPeak = 0;
+    uint32_t failNext = 0;  // Tests: the next N heap_caps_malloc calls return nullptr
+
+    static HostHeap& instance() {
+        static HostHeap heap;
+        return heap;
+    }
+
+    void note(bool psram, size_t bytes, bool allocated) {
+        size_t& used = psram ? psramUsed : internalUsed;
+        size_t& peak = psram ? psramPeak : internalPeak;
+        if (allocated) {
+            used += bytes;
+            if (used > peak)
+                peak = used;
+        } else {
+            used -= bytes;
+        }
+    }
+};
+
+namespace host_heap_detail {
+struct Header {
+    size_t size;
+    bool psram;
+    alignas(alignof(max_align_t)) unsigned char payload[1];
+};
+constexpr size_t HEADER_SIZE = offsetof(Header, payload);
+}  // namespace host_heap_detail
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    using namespace host_heap_detail;
+    if (HostHeap::instance().failNext > 0) {
+        HostHeap::instance().failNext--;
+        return nullptr;
+    }
+    auto* header = static_cast<Header*>(malloc(HEADER_SIZE + size));
+    if (!header)
+        return nullptr;
+    header->size = size;
+    header->psram = (caps & MALLOC_CAP_SPIRAM) != 0;
+    HostHeap::instance().note(header->psram, size, true);
+    return header->payload;
+}
+
+inline void heap_caps_free(void* ptr) {
+    using namespace host_heap_detail;
+    if (!ptr)
+        return;
+    auto* header = reinterpret_cast<Header*>(static_cast<unsigned char*>(ptr) - HEADER_SIZE);
+    HostHeap::instance().note(header->psram, header->size, false);
+    free(header);
+}
+
+inline size_t heap_caps_get_total_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? HostHeap::PSRAM_TOTAL : HostHeap::INTERNAL_TOTAL;
+}
+
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+    auto& heap = HostHeap::instance();
+    bool psram = (caps & MALLOC_CAP_SPIRAM) != 0;
+    return heap_caps_get_total_size(caps) - (psram ? heap.psramUsed : heap.internalUsed);
+}
+
+inline size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    auto& heap = HostHeap::instance();
+    bool psram = (caps & MALLOC_CAP_SPIRAM) != 0;
+    return heap_caps_get_total_size(caps) - (psram ? heap.psramPeak : heap.internalPeak);
+}
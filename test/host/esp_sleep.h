@@ -0,0 +1,22 @@
+#pragma once
+
+// Host stand-in for ESP-IDF sleep control, used by the native env.
+// Tests set the wake cause to simulate a wake from deep sleep.
+
+#include <cstdint>
+
+enum esp_sleep_wakeup_cause_t {
+    ESP_SLEEP_WAKEUP_UNDEFINED = 0,
+    ESP_SLEEP_WAKEUP_EXT0 = 2,
+    ESP_SLEEP_WAKEUP_EXT1 = 3,
+    ESP_SLEEP_WAKEUP_TIMER = 4,
+    ESP_SLEEP_WAKEUP_GPIO = 7,
+};
+
+namespace HostSleep {
+inline esp_sleep_wakeup_cause_t wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+}
+
+inline esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+    return HostSleep::wakeCause;
+}
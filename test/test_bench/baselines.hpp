@@ -0,0 +1,25 @@
+#pragma once
+
+// Per-benchmark baselines checked by test_bench. Allocation counts are
+// enforced; the ns/op figures were recorded with the native env on a
+// development machine and are enforced only with BENCH_CHECK_TIME=1. After
+// an intended change re-record with BENCH_RECORD=1 and paste the rows here.
+struct BenchBaseline {
+    const char* name;
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+static const BenchBaseline BENCH_BASELINES[] = {
+    {"InlineFunction [this, idx] construct+call", 2.19, 0.000},
+    {"InlineFunction 3-word capture construct+call", 2.60, 0.000},
+    {"InlineFunction invoke", 2.19, 0.000},
+    {"layout: player card rects (2-6 players)", 76.41, 0.000},
+    {"touch: hit-test 4-player life screen", 23.19, 0.000},
+    {"keyboard: keyAt/getKeyChar lookup", 12.20, 0.000},
+    {"game state: save", 1638.68, 0.000},
+    {"game state: load", 688.07, 0.000},
+    {"player card: format + draw", 9122.02, 0.000},
+    {"toolbar: format + draw", 1267.94, 0.000},
+    {"render: full 4-player life screen", 478927.29, 0.000},
+};
@@ -0,0 +1,423 @@
+#include <M5Unified.h>
+#include <unity.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+#include "app/Navigation.hpp"
+#include "apps/mtg/MTGLifeScreen.hpp"
+#include "baselines.hpp"
+#include "models/GameState.hpp"
+#include "models/WiFiNetwork.hpp"
+#include "ui/Keyboard.hpp"
+#include "ui/PlayerCard.hpp"
+#include "ui/Toolbar.hpp"
+#include "utils/AllocTracker.hpp"
+#include "utils/InlineFunction.hpp"
+
+// Host-side benchmarks. Each named benchmark is checked against its stored
+// baseline (baselines.hpp): allocating more per op than recorded fails.
+// Timings depend on the machine and the optimisation level, so they are
+// printed with the baseline for reference and only fail with
+// BENCH_CHECK_TIME=1, past the baseline by more than BENCH_NS_THRESHOLD (a
+// fraction, default 1.0 = twice as slow). The timing asserts that always run
+// compare two implementations measured in the same run. BENCH_RECORD=1
+// prints fresh baseline rows instead of checking.
+
+static size_t g_liveBytes = 0;
+static size_t g_peakBytes = 0;
+
+// Each block carries its size in a header so live/peak bytes can be tracked
+static constexpr size_t HEADER = alignof(std::max_align_t);
+
+void* operator new(size_t size) {
+    AllocTracker::onAlloc(size);
+    char* p = static_cast<char*>(malloc(size + HEADER));
+    if (!p)
+        throw std::bad_alloc();
+    *reinterpret_cast<size_t*>(p) = size;
+    g_liveBytes += size;
+    if (g_liveBytes > g_peakBytes)
+        g_peakBytes = g_liveBytes;
+    return p + HEADER;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr)
+        return;
+    AllocTracker::onFree();
+    char* p = static_cast<char*>(ptr) - HEADER;
+    g_liveBytes -= *reinterpret_cast<size_t*>(p);
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
+
+static void resetPeak() {
+    g_peakBytes = g_liveBytes;
+}
+
+static constexpr int ITERATIONS = 1000000;
+static constexpr int REPEATS = 3;  // Best of, to ride out scheduler noise
+static constexpr double NS_SLACK = 1.0;
+static volatile int g_sink = 0;
+
+struct Target {
+    int value = 0;
+    void tap(int idx) { value += idx; }
+};
+
+// Out of line, so the call goes through the type-erased invoker as it does
+// from a Button, instead of being folded into the benchmark loop
+template <typename Fn>
+__attribute__((noinline)) static void callOpaque(Fn& fn) {
+    fn();
+}
+
+struct BenchResult {
+    double nsPerOp;
+    double allocsPerOp;
+};
+
+template <typename Fn>
+static BenchResult runBench(Fn&& body, int iterations = ITERATIONS) {
+    BenchResult best = {0, 0};
+    for (int rep = 0; rep < REPEATS; rep++) {
+        size_t allocsBefore = AllocTracker::total().allocs;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            body(i);
+        }
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        double allocs = double(AllocTracker::total().allocs - allocsBefore) / iterations;
+        if (rep == 0 || ns < best.nsPerOp) {
+            best.nsPerOp = ns;
+        }
+        if (rep == 0 || allocs > best.allocsPerOp) {
+            best.allocsPerOp = allocs;
+        }
+    }
+    return best;
+}
+
+static void report(const char* name, BenchResult r) {
+    printf("[bench] %-44s %8.2f ns/op %6.3f allocs/op\n", name, r.nsPerOp, r.allocsPerOp);
+}
+
+static double envDouble(const char* name, double fallback) {
+    const char* value = getenv(name);
+    return value && *value ? atof(value) : fallback;
+}
+
+// Report, then compare with the stored baseline
+static void check(const char* name, BenchResult r) {
+    report(name, r);
+    if (envDouble("BENCH_RECORD", 0) != 0) {
+        printf("[bench] baseline    {\"%s\", %.2f, %.3f},\n", name, r.nsPerOp, r.allocsPerOp);
+        return;
+    }
+
+    const BenchBaseline* baseline = nullptr;
+    for (const BenchBaseline& b : BENCH_BASELINES) {
+        if (strcmp(b.name, name) == 0) {
+            baseline = &b;
+        }
+    }
+    char msg[160];
+    if (!baseline) {
+        snprintf(msg, sizeof(msg), "%s has no baseline (run with BENCH_RECORD=1)", name);
+        TEST_FAIL_MESSAGE(msg);
+        return;
+    }
+
+    // The absolute slack keeps very short benchmarks from failing on timer noise
+    double limit = baseline->nsPerOp * (1.0 + envDouble("BENCH_NS_THRESHOLD", 1.0)) + NS_SLACK;
+    if (r.nsPerOp > limit) {
+        printf("[bench]   %.1f ns/op is over %.1f (baseline %.1f)\n", r.nsPerOp, limit,
+               baseline->nsPerOp);
+    }
+    if (r.nsPerOp > limit && envDouble("BENCH_CHECK_TIME", 0) != 0) {
+        snprintf(msg, sizeof(msg), "%s: %.1f ns/op exceeds %.1f (baseline %.1f)", name,
+                 r.nsPerOp, limit, baseline->nsPerOp);
+        TEST_FAIL_MESSAGE(msg);
+    }
+    // Allocation counts are deterministic: any increase is a regression
+    if (r.allocsPerOp > baseline->allocsPerOp + 0.0005) {
+        snprintf(msg, sizeof(msg), "%s: %.3f allocs/op, baseline %.3f", name, r.allocsPerOp,
+                 baseline->allocsPerOp);
+        TEST_FAIL_MESSAGE(msg);
+    }
+}
+
+// Construct + invoke, as when a screen (re)creates its buttons and the user taps them
+
+void test_bench_callback_construct_small_capture() {
+    Target t;
+    auto inl = runBench([&t](int i) {
+        InlineFunction<void()> fn = [&t, i]() { t.tap(i); };
+        callOpaque(fn);
+    });
+    auto std_ = runBench([&t](int i) {
+        std::function<void()> fn = [&t, i]() { t.tap(i); };
+        callOpaque(fn);
+    });
+    check("InlineFunction [this, idx] construct+call", inl);
+    report("std::function  [this, idx] construct+call", std_);
+    g_sink = t.value;
+    TEST_ASSERT_EQUAL(0, inl.allocsPerOp);
+}
+
+void test_bench_callback_construct_large_capture() {
+    Target t;
+    auto inl = runBench([&t](int i) {
+        int a = i, b = i + 1;
+        InlineFunction<void(), 3 * sizeof(void*)> fn = [&t, a, b]() { t.tap(a + b); };
+        callOpaque(fn);
+    });
+    auto std_ = runBench([&t](int i) {
+        int a = i, b = i + 1;
+        void* pad = &t;
+        std::function<void()> fn = [&t, a, b, pad]() { t.tap(a + b + (pad != nullptr)); };
+        callOpaque(fn);
+    });
+    check("InlineFunction 3-word capture construct+call", inl);
+    report("std::function  4-word capture construct+call", std_);
+    g_sink = t.value;
+    TEST_ASSERT_EQUAL(0, inl.allocsPerOp);
+    // std::function heap-allocates this capture on every construction
+    TEST_ASSERT_EQUAL(1, std_.allocsPerOp);
+    TEST_ASSERT_TRUE(inl.nsPerOp < std_.nsPerOp);
+}
+
+// Invoke only, as on every tap of an existing button
+
+void test_bench_callback_invoke() {
+    Target t;
+    int idx = 1;
+    InlineFunction<void()> inlFn = [&t, idx]() { t.tap(idx); };
+    std::function<void()> stdFn = [&t, idx]() { t.tap(idx); };
+    auto inl = runBench([&inlFn](int) { callOpaque(inlFn); });
+    auto std_ = runBench([&stdFn](int) { callOpaque(stdFn); });
+    check("InlineFunction invoke", inl);
+    report("std::function  invoke", std_);
+    g_sink = t.value;
+    TEST_ASSERT_EQUAL(0, inl.allocsPerOp);
+}
+
+// Dense WiFi environment: 300 scan results, many sharing SSIDs (mesh/extenders)
+
+static constexpr int DENSE_SCAN_RESULTS = 300;
+
+static void denseScanEntry(int i, char* ssid, size_t len, int32_t& rssi) {
+    snprintf(ssid, len, "Office-Mesh-Network-%03d", i % 120);
+    rssi = -95 + (i * 37) % 65;
+}
+
+void test_bench_dense_scan_peak_heap() {
+    char ssid[40];
+    int32_t rssi;
+
+    // Fixed-capacity list used by WiFiScreen
+    resetPeak();
+    size_t liveBefore = g_liveBytes;
+    size_t allocsBefore = AllocTracker::total().allocs;
+    WiFiNetworkList list;
+    for (int i = 0; i < DENSE_SCAN_RESULTS; i++) {
+        denseScanEntry(i, ssid, sizeof(ssid), rssi);
+        WiFiNetwork net;
+        net.ssid = ssid;
+        net.rssi = rssi;
+        list.insertRanked(net);
+    }
+    size_t fixedPeak = g_peakBytes - liveBefore;
+    size_t fixedAllocs = AllocTracker::total().allocs - allocsBefore;
+
+    // Previous approach: vector of heap strings, grown per result
+    struct HeapNetwork {
+        std::string ssid;
+        int32_t rssi;
+    };
+    resetPeak();
+    liveBefore = g_liveBytes;
+    allocsBefore = AllocTracker::total().allocs;
+    size_t heapPeak = 0;
+    {
+        std::vector<HeapNetwork> networks;
+        for (int i = 0; i < DENSE_SCAN_RESULTS; i++) {
+            denseScanEntry(i, ssid, sizeof(ssid), rssi);
+            networks.push_back({ssid, rssi});
+        }
+        heapPeak = g_peakBytes - liveBefore;
+    }
+    size_t heapAllocs = AllocTracker::total().allocs - allocsBefore;
+
+    printf("[bench] dense scan (%d results) WiFiNetworkList: %zu bytes inline, %zu heap peak, "
+           "%zu allocs\n",
+           DENSE_SCAN_RESULTS, sizeof(WiFiNetworkList), fixedPeak, fixedAllocs);
+    printf("[bench] dense scan (%d results) vector<string>:  %zu heap peak, %zu allocs\n",
+           DENSE_SCAN_RESULTS, heapPeak, heapAllocs);
+
+    TEST_ASSERT_EQUAL(0, fixedAllocs);
+    TEST_ASSERT_EQUAL(0, fixedPeak);
+    TEST_ASSERT_EQUAL(WIFI_MAX_NETWORKS, list.size());
+}
+
+// Four-player game on the life screen, as the UI benchmarks below see it
+
+static void launchFourPlayerGame() {
+    GameState state;
+    state.initDefaults();
+    state.playerCount = 4;
+    Preferences prefs;
+    state.save(prefs);
+    Navigation::instance().launchApp("mtg");
+    Navigation::instance().draw(&M5.Display);
+}
+
+// Card rects for every player count, as computed on entering the life screen
+
+void test_bench_layout_player_cards() {
+    auto r = runBench([](int) {
+        int sum = 0;
+        for (int count = 2; count <= GameState::MAX_PLAYERS; count++) {
+            for (int i = 0; i < count; i++) {
+                Rect rect = MTGLifeScreen::getPlayerCardRect(i, count);
+                sum += rect.x + rect.y + rect.w + rect.h;
+            }
+        }
+        g_sink = sum;
+    });
+    check("layout: player card rects (2-6 players)", r);
+}
+
+// Touch-down dispatch through Navigation to the header and four cards
+
+void test_bench_touch_hit_test() {
+    launchFourPlayerGame();
+    auto& nav = Navigation::instance();
+    auto r = runBench([&nav](int i) {
+        int16_t x = static_cast<int16_t>((i * 97) % Layout::screenW());
+        int16_t y = static_cast<int16_t>((i * 53) % Layout::screenH());
+        g_sink = nav.handleTouch(x, y, true, false);
+    });
+    check("touch: hit-test 4-player life screen", r);
+}
+
+// Resolve a tap to a character the way Keyboard::handleTouch does, and the
+// same taps by scanning every key rect as it did before keyAt()
+
+void test_bench_keyboard_key_lookup() {
+    Keyboard keyboard("Player 1", nullptr);
+    Rect bounds = keyboard.getBounds();
+    auto r = runBench([&keyboard, &bounds](int i) {
+        int16_t x = static_cast<int16_t>(bounds.x + (i * 97) % bounds.w);
+        int16_t y = static_cast<int16_t>(bounds.y + (i * 53) % bounds.h);
+        int row;
+        int col;
+        char found = '\0';
+        if (keyboard.keyAt(x, y, row, col) && row < 3) {
+            found = keyboard.getKeyChar(row, col);
+        }
+        g_sink = found;
+    });
+    auto scan = runBench([&keyboard, &bounds](int i) {
+        int16_t x = static_cast<int16_t>(bounds.x + (i * 97) % bounds.w);
+        int16_t y = static_cast<int16_t>(bounds.y + (i * 53) % bounds.h);
+        char found = '\0';
+        for (int row = 0; row < 3 && !found; row++) {
+            int cols = row == 0 ? 11 : 10;
+            for (int col = 0; col < cols; col++) {
+                if (keyboard.getKeyRect(row, col).contains(x, y)) {
+                    found = keyboard.getKeyChar(row, col);
+                    break;
+                }
+            }
+        }
+        g_sink = found;
+    });
+    check("keyboard: keyAt/getKeyChar lookup", r);
+    report("keyboard: getKeyRect scan lookup", scan);
+    TEST_ASSERT_TRUE(r.nsPerOp < scan.nsPerOp);
+}
+
+// Game state round trip through (host) NVS
+
+void test_bench_game_state_serialization() {
+    GameState state;
+    state.initDefaults();
+    state.playerCount = 4;
+    Preferences prefs;
+    auto save = runBench([&state, &prefs](int i) {
+        state.players[0].life = static_cast<int16_t>(i & 0xFF);
+        state.save(prefs);
+    }, ITERATIONS / 100);
+    auto load = runBench([&state, &prefs](int) {
+        state.load(prefs);
+        g_sink = state.players[0].life;
+    }, ITERATIONS / 100);
+    check("game state: save", save);
+    check("game state: load", load);
+}
+
+// Text formatting and drawing of a dirty component into the host framebuffer
+
+void test_bench_player_card_draw() {
+    Player player;
+    player.setName("Player 1");
+    player.life = 20;
+    PlayerCard card(&player);
+    card.setBounds(MTGLifeScreen::getPlayerCardRect(0, 4));
+    auto r = runBench([&card, &player](int i) {
+        player.life = static_cast<int16_t>(i % 200);
+        card.setDirty();
+        card.draw(&M5.Display);
+    }, ITERATIONS / 1000);
+    check("player card: format + draw", r);
+}
+
+void test_bench_toolbar_draw() {
+    Toolbar toolbar;
+    auto r = runBench([&toolbar](int) {
+        toolbar.setDirty();
+        toolbar.draw(&M5.Display);
+    }, ITERATIONS / 1000);
+    check("toolbar: format + draw", r);
+}
+
+// Full redraw of the four-player life screen, including display()
+
+void test_bench_full_screen_render() {
+    launchFourPlayerGame();
+    Screen* screen = Navigation::instance().currentScreen();
+    auto r = runBench([screen](int) {
+        screen->setNeedsFullRedraw(true);
+        screen->draw(&M5.Display);
+    }, ITERATIONS / 10000);
+    check("render: full 4-player life screen", r);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bench_callback_construct_small_capture);
+    RUN_TEST(test_bench_callback_construct_large_capture);
+    RUN_TEST(test_bench_callback_invoke);
+    RUN_TEST(test_bench_dense_scan_peak_heap);
+    RUN_TEST(test_bench_layout_player_cards);
+    RUN_TEST(test_bench_touch_hit_test);
+    RUN_TEST(test_bench_keyboard_key_lookup);
+    RUN_TEST(test_bench_game_state_serialization);
+    RUN_TEST(test_bench_player_card_draw);
+    RUN_TEST(test_bench_toolbar_draw);
+    RUN_TEST(test_bench_full_screen_render);
+
+    UNITY_END();
+    return 0;
+}
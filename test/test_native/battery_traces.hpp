@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+
+// Discharge trace for the battery estimator tests: one reading per minute at
+// about 10%/h (Balanced), from full to empty. Readings carry the PMIC's
+// +/-2% jitter and a voltage sag when an EPD refresh lands on the sample.
+
+struct BatteryReading {
+    int8_t percent;
+    int16_t millivolts;
+};
+
+static constexpr uint32_t TRACE_INTERVAL_MS = 60 * 1000;
+
+static const BatteryReading BALANCED_DISCHARGE_TRACE[] = {
+    {100, 4165}, {99, 4146}, {98, 4135}, {100, 4135}, {99, 4149}, {97, 4159},
+    {100, 4135}, {97, 4130}, {99, 4140}, {98, 4133}, {97, 4142}, {98, 4125},
+    {100, 4126}, {93, 4082}, {100, 4151}, {96, 4138}, {99, 4131}, {95, 4126},
+    {95, 4135}, {96, 4126}, {97, 4120}, {98, 4118}, {98, 4123}, {97, 4139},
+    {95, 4115}, {98, 4129}, {96, 4121}, {94, 4126}, {94, 4126}, {93, 4126},
+    {95, 4121}, {96, 4118}, {95, 4118}, {96, 4132}, {95, 4113}, {94, 4108},
+    {93, 4123}, {94, 4102}, {96, 4108}, {94, 4113}, {93, 4120}, {94, 4105},
+    {95, 4097}, {92, 4110}, {93, 4098}, {92, 4096}, {93, 4104}, {90, 4120},
+    {91, 4113}, {93, 4106}, {92, 4097}, {92, 4105}, {92, 4103}, {92, 4086},
+    {90, 4113}, {91, 4097}, {90, 4082}, {90, 4100}, {92, 4100}, {91, 4087},
+    {85, 4045}, {90, 4077}, {91, 4087}, {88, 4094}, {88, 4089}, {87, 4079},
+    {89, 4076}, {89, 4083}, {89, 4099}, {90, 4071}, {87, 4082}, {88, 4084},
+    {88, 4094}, {87, 4091}, {88, 4091}, {88, 4071}, {87, 4073}, {87, 4091},
+    {87, 4064}, {86, 4064}, {86, 4065}, {86, 4057}, {87, 4082}, {88, 4060},
+    {86, 4063}, {84, 4057}, {86, 4069}, {86, 4070}, {87, 4060}, {84, 4071},
+    {86, 4078}, {87, 4067}, {83, 4060}, {86, 4057}, {84, 4056}, {84, 4046},
+    {85, 4062}, {84, 4042}, {84, 4042}, {84, 4053}, {82, 4041}, {83, 4056},
+    {81, 4039}, {81, 4053}, {82, 4051}, {82, 4063}, {82, 4051}, {75, 3973},
+    {82, 4049}, {82, 4033}, {82, 4058}, {82, 4046}, {81, 4041}, {80, 4028},
+    {82, 4038}, {82, 4038}, {81, 4024}, {80, 4024}, {80, 4043}, {80, 4034},
+    {79, 4034}, {78, 4023}, {81, 4027}, {78, 4037}, {80, 4043}, {77, 4037},
+    {80, 4021}, {78, 4033}, {79, 4026}, {78, 4038}, {77, 4019}, {78, 4024},
+    {79, 4030}, {79, 4015}, {78, 4023}, {78, 4028}, {77, 4028}, {77, 4024},
+    {77, 4006}, {78, 4014}, {77, 4021}, {74, 3997}, {76, 4011}, {76, 4001},
+    {78, 4024}, {76, 4007}, {76, 4022}, {76, 3993}, {75, 3993}, {75, 4004},
+    {75, 3998}, {75, 4002}, {77, 4014}, {76, 4011}, {67, 3939}, {74, 4008},
+    {73, 4008}, {73, 4010}, {74, 4005}, {74, 3994}, {72, 3991}, {73, 3979},
+    {73, 3990}, {73, 3998}, {72, 3997}, {72, 3978}, {71, 3972}, {71, 3989},
+    {73, 3995}, {71, 3988}, {74, 3982}, {72, 3970}, {72, 3982}, {70, 3964},
+    {69, 3988}, {70, 3978}, {70, 3974}, {70, 3986}, {70, 3959}, {70, 3964},
+    {70, 3973}, {70, 3980}, {72, 3965}, {70, 3971}, {69, 3979}, {68, 3953},
+    {69, 3979}, {70, 3971}, {71, 3975}, {70, 3961}, {69, 3951}, {69, 3950},
+    {69, 3960}, {66, 3970}, {69, 3966}, {66, 3960}, {65, 3964}, {66, 3944},
+    {66, 3953}, {69, 3960}, {66, 3953}, {59, 3885}, {67, 3950}, {67, 3948},
+    {65, 3960}, {67, 3932}, {66, 3936}, {66, 3930}, {64, 3943}, {66, 3943},
+    {63, 3949}, {64, 3938}, {65, 3942}, {66, 3941}, {65, 3927}, {64, 3934},
+    {65, 3936}, {65, 3934}, {64, 3939}, {64, 3944}, {63, 3944}, {64, 3941},
+    {63, 3938}, {64, 3915}, {63, 3913}, {62, 3923}, {62, 3910}, {62, 3920},
+    {61, 3912}, {62, 3930}, {61, 3932}, {60, 3933}, {61, 3906}, {61, 3928},
+    {60, 3929}, {62, 3905}, {60, 3909}, {62, 3901}, {60, 3900}, {60, 3910},
+    {60, 3903}, {60, 3898}, {60, 3901}, {58, 3912}, {59, 3888}, {59, 3904},
+    {60, 3900}, {57, 3897}, {54, 3840}, {60, 3892}, {59, 3912}, {57, 3884},
+    {58, 3908}, {57, 3880}, {58, 3885}, {56, 3904}, {56, 3883}, {56, 3900},
+    {57, 3900}, {57, 3884}, {56, 3888}, {58, 3887}, {57, 3890}, {56, 3869},
+    {56, 3867}, {55, 3878}, {55, 3872}, {54, 3883}, {54, 3887}, {55, 3862},
+    {57, 3886}, {55, 3860}, {55, 3884}, {54, 3870}, {52, 3865}, {55, 3867},
+    {54, 3872}, {53, 3852}, {55, 3872}, {54, 3879}, {52, 3853}, {53, 3848},
+    {52, 3852}, {53, 3865}, {53, 3859}, {52, 3851}, {53, 3857}, {51, 3848},
+    {52, 3864}, {50, 3846}, {50, 3837}, {50, 3858}, {52, 3851}, {51, 3849},
+    {52, 3839}, {47, 3774}, {51, 3851}, {52, 3845}, {50, 3843}, {50, 3848},
+    {50, 3832}, {50, 3830}, {49, 3835}, {50, 3822}, {48, 3820}, {48, 3839},
+    {49, 3831}, {48, 3818}, {48, 3837}, {48, 3841}, {49, 3834}, {48, 3831},
+    {48, 3833}, {48, 3811}, {49, 3813}, {46, 3815}, {48, 3806}, {47, 3816},
+    {47, 3821}, {47, 3810}, {45, 3831}, {46, 3806}, {46, 3804}, {44, 3808},
+    {46, 3799}, {47, 3803}, {47, 3814}, {46, 3800}, {46, 3816}, {43, 3793},
+    {45, 3815}, {44, 3792}, {45, 3805}, {42, 3798}, {42, 3794}, {44, 3803},
+    {44, 3784}, {46, 3811}, {45, 3807}, {42, 3799}, {45, 3789}, {43, 3799},
+    {39, 3719}, {43, 3797}, {45, 3792}, {42, 3772}, {43, 3790}, {42, 3792},
+    {43, 3771}, {43, 3790}, {43, 3783}, {40, 3790}, {43, 3787}, {41, 3763},
+    {39, 3761}, {40, 3779}, {41, 3787}, {40, 3768}, {41, 3772}, {38, 3774},
+    {38, 3772}, {41, 3772}, {40, 3765}, {40, 3749}, {40, 3772}, {38, 3769},
+    {40, 3773}, {40, 3746}, {40, 3744}, {40, 3749}, {37, 3767}, {38, 3746},
+    {38, 3744}, {39, 3751}, {38, 3737}, {38, 3762}, {37, 3756}, {35, 3750},
+    {37, 3732}, {39, 3732}, {37, 3735}, {36, 3745}, {38, 3728}, {34, 3738},
+    {34, 3737}, {36, 3741}, {35, 3741}, {36, 3739}, {36, 3726}, {31, 3664},
+    {36, 3728}, {36, 3737}, {34, 3739}, {36, 3716}, {34, 3711}, {35, 3707},
+    {34, 3720}, {33, 3731}, {35, 3733}, {34, 3710}, {33, 3707}, {33, 3701},
+    {35, 3700}, {32, 3720}, {34, 3703}, {32, 3698}, {34, 3719}, {33, 3699},
+    {31, 3712}, {32, 3696}, {33, 3715}, {32, 3698}, {29, 3690}, {29, 3713},
+    {32, 3703}, {32, 3692}, {31, 3702}, {30, 3691}, {30, 3688}, {30, 3678},
+    {30, 3674}, {30, 3696}, {30, 3697}, {30, 3672}, {29, 3690}, {27, 3695},
+    {29, 3673}, {29, 3666}, {29, 3674}, {30, 3663}, {28, 3689}, {28, 3682},
+    {28, 3684}, {26, 3663}, {27, 3655}, {28, 3673}, {21, 3598}, {27, 3663},
+    {28, 3658}, {27, 3671}, {27, 3670}, {26, 3672}, {24, 3668}, {26, 3670},
+    {27, 3657}, {26, 3661}, {25, 3638}, {26, 3649}, {27, 3658}, {24, 3652},
+    {25, 3646}, {23, 3658}, {26, 3632}, {24, 3641}, {24, 3635}, {24, 3632},
+    {24, 3645}, {24, 3632}, {24, 3628}, {24, 3634}, {23, 3619}, {22, 3634},
+    {22, 3615}, {23, 3627}, {24, 3627}, {22, 3622}, {22, 3631}, {23, 3618},
+    {21, 3621}, {22, 3609}, {21, 3606}, {22, 3616}, {20, 3608}, {21, 3607},
+    {21, 3620}, {23, 3599}, {19, 3614}, {20, 3602}, {20, 3611}, {21, 3593},
+    {20, 3593}, {20, 3607}, {18, 3597}, {15, 3538}, {19, 3583}, {20, 3593},
+    {19, 3577}, {19, 3602}, {19, 3584}, {18, 3591}, {19, 3582}, {18, 3594},
+    {16, 3570}, {16, 3577}, {19, 3592}, {20, 3576}, {15, 3561}, {17, 3586},
+    {18, 3583}, {18, 3568}, {17, 3577}, {16, 3558}, {15, 3553}, {17, 3568},
+    {15, 3576}, {17, 3546}, {17, 3566}, {14, 3540}, {14, 3546}, {17, 3566},
+    {13, 3555}, {15, 3563}, {14, 3552}, {14, 3546}, {14, 3550}, {13, 3529},
+    {13, 3533}, {15, 3553}, {16, 3527}, {14, 3527}, {13, 3542}, {15, 3515},
+    {11, 3530}, {13, 3526}, {13, 3540}, {12, 3528}, {12, 3521}, {13, 3511},
+    {13, 3509}, {10, 3530}, {7, 3460}, {12, 3498}, {9, 3501}, {12, 3521},
+    {11, 3493}, {11, 3496}, {11, 3516}, {10, 3492}, {11, 3484}, {10, 3503},
+    {10, 3490}, {10, 3483}, {8, 3500}, {10, 3496}, {10, 3473}, {9, 3483},
+    {9, 3475}, {9, 3471}, {10, 3469}, {8, 3484}, {8, 3461}, {10, 3471},
+    {10, 3458}, {8, 3466}, {8, 3478}, {6, 3477}, {9, 3449}, {7, 3443},
+    {7, 3440}, {9, 3442}, {7, 3436}, {4, 3438}, {6, 3445}, {6, 3451},
+    {5, 3428}, {5, 3433}, {6, 3426}, {6, 3441}, {6, 3417}, {5, 3434},
+    {5, 3437}, {5, 3418}, {6, 3410}, {4, 3403}, {3, 3408}, {3, 3408},
+    {4, 3424}, {0, 3348}, {4, 3401}, {4, 3410}, {3, 3409}, {3, 3382},
+    {1, 3398}, {4, 3379}, {3, 3387}, {4, 3373}, {2, 3374}, {3, 3360},
+    {2, 3363}, {2, 3353}, {2, 3350}, {2, 3347}, {0, 3348}, {1, 3359},
+    {0, 3359}, {3, 3336}, {1, 3329}, {0, 3345}, {2, 3310}, {0, 3323},
+    {0, 3314},
+};
+
+static constexpr int BALANCED_DISCHARGE_TRACE_LEN =
+    sizeof(BALANCED_DISCHARGE_TRACE) / sizeof(BALANCED_DISCHARGE_TRACE[0]);
@@ -1,6 +1,63 @@
+#include <M5Unified.h>
+#include <WiFi.h>
+#include <esp_heap_caps.h>
+#include <esp_sleep.h>
 #include <unity.h>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include "app/AppRegistry.hpp"
+#include "app/Navigation.hpp"
+#include "app/Resume.hpp"
+#include "apps/diagnostics/DiagnosticsApp.hpp"
+#include "apps/home/HomeApp.hpp"
+#include "apps/mtg/MTGApp.hpp"
+#include "apps/settings/SettingsApp.hpp"
 #include "models/Player.hpp"
+#include "models/Settings.hpp"
+#include "models/WiFiNetwork.hpp"
+#include "ui/Keyboard.hpp"
+#include "utils/AllocTracker.hpp"
+#include "utils/AutoRepeat.hpp"
+#include "utils/DragGesture.hpp"
+#include "utils/Battery.hpp"
+#include "utils/Energy.hpp"
+#include "utils/InlineFunction.hpp"
+#include "utils/LogRecord.hpp"
+#include "utils/LogRing.hpp"
+#include "utils/Memory.hpp"
+#include "utils/Metrics.hpp"
+#include "utils/Power.hpp"
+#include "utils/ProfileSamples.hpp"
 #include "utils/Rect.hpp"
+#include "utils/Stall.hpp"
+#include "utils/TouchLog.hpp"
+#include "utils/Trace.hpp"
+#include "battery_traces.hpp"
+#include "touch_replay.hpp"
+#include "touch_sessions.hpp"
+
+// Route operator new through the simulated internal heap so per-screen
+// memory accounting sees every allocation, as heap_caps does on device, and
+// count it as the device's malloc hooks do
+void* operator new(size_t size) {
+    void* p = heap_caps_malloc(size, MALLOC_CAP_INTERNAL);
+    if (!p)
+        throw std::bad_alloc();
+    AllocTracker::onAlloc(size);
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    if (p)
+        AllocTracker::onFree();
+    heap_caps_free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    operator delete(p);
+}
 
 // Player::adjustLife() bounds tests
 
@@ -104,6 +161,2249 @@ void test_rect_default_constructor() {
     TEST_ASSERT_EQUAL(0, r.h);
 }
 
+// InlineFunction tests
+
+void test_inline_function_default_empty() {
+    InlineFunction<void()> fn;
+    TEST_ASSERT_FALSE(static_cast<bool>(fn));
+    InlineFunction<void()> fromNull = nullptr;
+    TEST_ASSERT_FALSE(static_cast<bool>(fromNull));
+}
+
+void test_inline_function_invokes_capture() {
+    int counter = 0;
+    int step = 3;
+    InlineFunction<void()> fn = [&counter, step]() { counter += step; };
+    TEST_ASSERT_TRUE(static_cast<bool>(fn));
+    fn();
+    fn();
+    TEST_ASSERT_EQUAL(6, counter);
+}
+
+void test_inline_function_args_and_return() {
+    InlineFunction<int(int, int)> add = [](int a, int b) { return a + b; };
+    TEST_ASSERT_EQUAL(7, add(3, 4));
+}
+
+void test_inline_function_copy_is_independent() {
+    int hits = 0;
+    InlineFunction<void()> a = [&hits]() { hits++; };
+    InlineFunction<void()> b = a;
+    a = nullptr;
+    TEST_ASSERT_FALSE(static_cast<bool>(a));
+    b();
+    TEST_ASSERT_EQUAL(1, hits);
+}
+
+// FixedString / FixedVector tests
+
+void test_fixed_string_truncates() {
+    FixedString<4> s("abcdefgh");
+    TEST_ASSERT_EQUAL_STRING("abcd", s.c_str());
+    TEST_ASSERT_EQUAL(4, s.length());
+    s = nullptr;
+    TEST_ASSERT_TRUE(s.empty());
+}
+
+void test_fixed_string_compare() {
+    WiFiSsid a("HomeNet");
+    WiFiSsid b("HomeNet");
+    TEST_ASSERT_TRUE(a == b);
+    TEST_ASSERT_TRUE(a == "HomeNet");
+    TEST_ASSERT_TRUE(a != "Other");
+}
+
+void test_fixed_vector_rejects_when_full() {
+    FixedVector<int, 2> v;
+    TEST_ASSERT_TRUE(v.push_back(1));
+    TEST_ASSERT_TRUE(v.push_back(2));
+    TEST_ASSERT_FALSE(v.push_back(3));
+    TEST_ASSERT_EQUAL(2, v.size());
+}
+
+void test_fixed_vector_insert_erase() {
+    FixedVector<int, 4> v;
+    v.push_back(1);
+    v.push_back(3);
+    v.insert(1, 2);
+    TEST_ASSERT_EQUAL(3, v.size());
+    TEST_ASSERT_EQUAL(2, v[1]);
+    v.erase(0);
+    TEST_ASSERT_EQUAL(2, v[0]);
+    TEST_ASSERT_EQUAL(3, v.back());
+}
+
+// WiFiNetworkList ranking tests
+
+static WiFiNetwork makeNetwork(const char* ssid, int32_t rssi, bool connected = false) {
+    WiFiNetwork net;
+    net.ssid = ssid;
+    net.rssi = rssi;
+    net.connected = connected;
+    return net;
+}
+
+void test_wifi_list_ranked_connected_first() {
+    WiFiNetworkList list;
+    list.insertRanked(makeNetwork("weak", -80));
+    list.insertRanked(makeNetwork("strong", -40));
+    list.insertRanked(makeNetwork("mine", -70, true));
+    TEST_ASSERT_EQUAL(3, list.size());
+    TEST_ASSERT_EQUAL_STRING("mine", list[0].ssid.c_str());
+    TEST_ASSERT_EQUAL_STRING("strong", list[1].ssid.c_str());
+    TEST_ASSERT_EQUAL_STRING("weak", list[2].ssid.c_str());
+}
+
+void test_wifi_list_dedupes_ssid() {
+    WiFiNetworkList list;
+    list.insertRanked(makeNetwork("mesh", -75));
+    list.insertRanked(makeNetwork("mesh", -45));
+    list.insertRanked(makeNetwork("mesh", -90));
+    TEST_ASSERT_EQUAL(1, list.size());
+    TEST_ASSERT_EQUAL(-45, list[0].rssi);
+}
+
+void test_wifi_list_bounded_keeps_strongest() {
+    WiFiNetworkList list;
+    char name[8];
+    for (int i = 0; i < 200; i++) {
+        snprintf(name, sizeof(name), "n%d", i);
+        list.insertRanked(makeNetwork(name, -100 + (i % 70)));
+    }
+    TEST_ASSERT_EQUAL(WIFI_MAX_NETWORKS, list.size());
+    TEST_ASSERT_EQUAL(-31, list[0].rssi);
+    for (size_t i = 1; i < list.size(); i++) {
+        TEST_ASSERT_TRUE(list[i - 1].rssi >= list[i].rssi);
+    }
+}
+
+void test_wifi_list_skips_empty_ssid() {
+    WiFiNetworkList list;
+    TEST_ASSERT_FALSE(list.insertRanked(makeNetwork("", -30)));
+    TEST_ASSERT_EQUAL(0, list.size());
+}
+
+// MemoryLedger tests
+
+void test_memory_ledger_tracks_peak() {
+    MemoryLedger ledger;
+    ledger.enter("app/main", {1000, 0}, 50000, 80000);
+    ledger.sample(49500, 80000);
+    ledger.sample(49800, 80000);
+    const MemoryScopeStats* s = ledger.find("app/main");
+    TEST_ASSERT_NOT_NULL(s);
+    TEST_ASSERT_EQUAL(200, s->internalUsed);
+    TEST_ASSERT_EQUAL(500, s->internalPeak);
+    TEST_ASSERT_FALSE(s->overBudget());
+}
+
+void test_memory_ledger_flags_over_budget_once() {
+    MemoryLedger ledger;
+    ledger.enter("app/main", {100, 100}, 1000, 1000);
+    TEST_ASSERT_FALSE(ledger.sample(950, 1000));
+    TEST_ASSERT_TRUE(ledger.sample(1000, 850));  // PSRAM over budget
+    TEST_ASSERT_FALSE(ledger.sample(1000, 800));  // Already reported
+    TEST_ASSERT_TRUE(ledger.anyOverBudget());
+}
+
+void test_memory_ledger_counts_allocs_per_screen() {
+    MemoryLedger ledger;
+    ledger.enter("app/main", {1000, 0}, 1000, 1000, 100);
+    ledger.sample(1000, 1000, 104);
+    ledger.enter("app/settings", {1000, 0}, 1000, 1000, 110);  // 6 more before leaving
+    ledger.sample(1000, 1000, 111);
+    ledger.enter("app/main", {1000, 0}, 1000, 1000, 120);
+    ledger.sample(1000, 1000, 123);
+    TEST_ASSERT_EQUAL(13, ledger.find("app/main")->allocs);  // Across both visits
+    TEST_ASSERT_EQUAL(10, ledger.find("app/settings")->allocs);
+}
+
+// Screen memory budget tests - every screen must stay within its declared budget
+
+template <typename T>
+static T* registeredApp(const char* id) {
+    return static_cast<T*>(AppRegistry::instance().findApp(id));
+}
+
+static void exerciseAllScreens() {
+    auto& nav = Navigation::instance();
+    M5GFX* gfx = &M5.Display;
+
+    nav.launchApp("home");
+    nav.draw(gfx);
+
+    nav.launchApp("mtg");
+    nav.draw(gfx);
+    HostClock::advance(1000);
+    nav.handleTouch(100, 100, false, true);  // Player 1 name opens the keyboard
+    nav.draw(gfx);
+
+    nav.pushScreen(registeredApp<MTGApp>("mtg")->settingsScreen());
+    nav.draw(gfx);
+
+    nav.launchApp("settings");
+    nav.draw(gfx);
+    nav.pushScreen(registeredApp<SettingsApp>("settings")->wifiScreen());
+    nav.draw(gfx);
+    nav.handleTouch(900, 50, false, true);  // SCAN
+    nav.draw(gfx);
+
+    nav.launchApp("diag");
+    nav.draw(gfx);
+
+    nav.goHome();
+    nav.draw(gfx);
+}
+
+void test_screens_within_memory_budget() {
+    // Dense WiFi environment
+    WiFi.scanResults.clear();
+    for (int i = 0; i < 60; i++) {
+        WiFi.scanResults.push_back({"Network-" + std::to_string(i), -40 - i, WIFI_AUTH_WPA2_PSK});
+    }
+
+    exerciseAllScreens();  // Warm up NVS namespaces and one-time state
+    Memory::ledger().reset();
+    exerciseAllScreens();
+
+    auto& ledger = Memory::ledger();
+    TEST_ASSERT_EQUAL(6, ledger.count());
+    for (size_t i = 0; i < ledger.count(); i++) {
+        const MemoryScopeStats& s = ledger.at(i);
+        char msg[96];
+        snprintf(msg, sizeof(msg), "%s over budget: internal %u/%u psram %u/%u", s.name.c_str(),
+                 (unsigned)s.internalPeak, (unsigned)s.budget.internalBytes, (unsigned)s.psramPeak,
+                 (unsigned)s.budget.psramBytes);
+        TEST_ASSERT_FALSE_MESSAGE(s.overBudget(), msg);
+    }
+
+    // Scan results are a cold buffer and must land in PSRAM
+    const MemoryScopeStats* wifi = ledger.find("settings/wifi");
+    TEST_ASSERT_NOT_NULL(wifi);
+    TEST_ASSERT_TRUE(wifi->psramPeak >= sizeof(WiFiNetworkList));
+}
+
+// With neither heap able to hold the scan results the WiFi screen still
+// opens, draws and ignores SCAN instead of crashing
+void test_wifi_screen_without_scan_memory() {
+    auto& nav = Navigation::instance();
+    M5GFX* gfx = &M5.Display;
+    WiFi.scanResults = {{"HomeNet", -48, WIFI_AUTH_WPA2_PSK}};
+    nav.launchApp("settings");
+    nav.draw(gfx);
+    WiFiScreen* screen = registeredApp<SettingsApp>("settings")->wifiScreen();
+    HostHeap::instance().failNext = 2;  // PSRAM, then the internal fallback
+    nav.pushScreen(screen);
+    TEST_ASSERT_EQUAL(0, HostHeap::instance().failNext);
+    TEST_ASSERT_TRUE(screen->networks().empty());
+    nav.draw(gfx);
+
+    // SCAN has nowhere to put results, so the radio is left alone
+    uint32_t scans = WiFi.scanCalls;
+    nav.handleTouch(900, 50, false, true);
+    nav.update();
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(scans, WiFi.scanCalls);
+    TEST_ASSERT_TRUE(screen->networks().empty());
+    nav.popScreen();
+    nav.draw(gfx);
+
+    // The next visit allocates again and the scan fills the list
+    nav.pushScreen(screen);
+    nav.handleTouch(900, 50, false, true);
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(scans + 1, WiFi.scanCalls);
+    TEST_ASSERT_EQUAL(1, screen->networks().size());
+    TEST_ASSERT_EQUAL_STRING("HomeNet", screen->networks()[0].ssid.c_str());
+
+    WiFi.scanResults.clear();
+    WiFi.mode(WIFI_OFF);
+    nav.goHome();
+}
+
+// AppRegistry lazy construction tests
+
+class ProbeScreen : public Screen {
+   public:
+    void draw(M5GFX* gfx) override { (void)gfx; }
+};
+
+class ProbeApp : public App {
+   public:
+    static constexpr AppMetadata METADATA = {"probe", "Probe", nullptr, true};
+    static int constructed;
+    static int destroyed;
+
+    ProbeApp() { constructed++; }
+    ~ProbeApp() override { destroyed++; }
+
+    const AppMetadata& metadata() const override { return METADATA; }
+    Screen* getMainScreen() override { return &_screen; }
+
+   private:
+    ProbeScreen _screen;
+};
+
+constexpr AppMetadata ProbeApp::METADATA;
+int ProbeApp::constructed = 0;
+int ProbeApp::destroyed = 0;
+
+void test_registry_compiled_table_lookup() {
+    auto& registry = AppRegistry::instance();
+
+    TEST_ASSERT_EQUAL_STRING("mtg", registry.findApp("mtg")->metadata().id);
+    TEST_ASSERT_EQUAL_STRING("settings", registry.findApp("settings")->metadata().id);
+    TEST_ASSERT_EQUAL_STRING("home", registry.homeApp()->metadata().id);
+    TEST_ASSERT_NULL(registry.findApp("mt"));
+    TEST_ASSERT_NULL(registry.findApp("unknown"));
+    TEST_ASSERT_NULL(registry.findApp(""));
+
+    // Launcher order is the declaration order, home excluded
+    TEST_ASSERT_EQUAL_STRING("mtg", registry.getLaunchableMetadata(0)->id);
+    TEST_ASSERT_EQUAL_STRING("settings", registry.getLaunchableMetadata(1)->id);
+    TEST_ASSERT_NULL(registry.getLaunchableMetadata(-1));
+}
+
+static void registerProbeApp() {
+    static bool registered = false;
+    if (!registered) {
+        AppRegistry::instance().registerApp<ProbeApp>();
+        registered = true;
+    }
+}
+
+void test_registry_constructs_on_first_launch() {
+    registerProbeApp();
+    auto& registry = AppRegistry::instance();
+    int before = ProbeApp::constructed;
+
+    // Enumerating the launcher reads metadata only
+    bool listed = false;
+    for (int i = 0; i < registry.launchableAppCount(); i++) {
+        listed |= strcmp(registry.getLaunchableMetadata(i)->id, "probe") == 0;
+    }
+    TEST_ASSERT_TRUE(listed);
+    TEST_ASSERT_FALSE(registry.isConstructed("probe"));
+    TEST_ASSERT_EQUAL(before, ProbeApp::constructed);
+
+    Navigation::instance().launchApp("probe");
+    TEST_ASSERT_TRUE(registry.isConstructed("probe"));
+    TEST_ASSERT_EQUAL(before + 1, ProbeApp::constructed);
+
+    // Later lookups reuse the instance
+    TEST_ASSERT_EQUAL_PTR(registry.findApp("probe"), Navigation::instance().currentApp());
+    TEST_ASSERT_EQUAL(before + 1, ProbeApp::constructed);
+    Navigation::instance().goHome();
+    Navigation::instance().update();
+}
+
+void test_registry_reclaims_suspended_app() {
+    registerProbeApp();
+    auto& registry = AppRegistry::instance();
+    auto& nav = Navigation::instance();
+    int destroyedBefore = ProbeApp::destroyed;
+
+    // Plenty of heap: WhenLow keeps the suspended app resident
+    registry.setReclaimPolicy(AppRegistry::ReclaimPolicy::WhenLow);
+    nav.launchApp("probe");
+    nav.goHome();
+    nav.update();
+    TEST_ASSERT_TRUE(registry.isConstructed("probe"));
+
+    // Teardown is deferred to update() so callbacks can unwind first
+    registry.setReclaimPolicy(AppRegistry::ReclaimPolicy::Always);
+    nav.launchApp("probe");
+    nav.goHome();
+    TEST_ASSERT_TRUE(registry.isConstructed("probe"));
+    nav.update();
+    TEST_ASSERT_FALSE(registry.isConstructed("probe"));
+    TEST_ASSERT_EQUAL(destroyedBefore + 1, ProbeApp::destroyed);
+    TEST_ASSERT_TRUE(registry.isConstructed("home"));
+
+    // Relaunch rebuilds it
+    nav.launchApp("probe");
+    TEST_ASSERT_TRUE(registry.isConstructed("probe"));
+    nav.goHome();
+    nav.update();
+    registry.setReclaimPolicy(AppRegistry::ReclaimPolicy::WhenLow);
+}
+
+// Power tier tests - driven by the virtual clock
+
+void test_power_tiers_escalate_with_inactivity() {
+    Power::init();
+    const uint16_t timeoutSecs = 300;
+
+    TEST_ASSERT_EQUAL(PowerTier::Active, Power::update(timeoutSecs));
+    HostClock::advance(PowerStateMachine::DEFAULT_LIGHT_SLEEP_MS);
+    TEST_ASSERT_EQUAL(PowerTier::LightSleep, Power::update(timeoutSecs));
+    TEST_ASSERT_TRUE(Power::pollingEnabled());
+
+    HostClock::advance(PowerStateMachine::DEFAULT_IDLE_MS);
+    TEST_ASSERT_EQUAL(PowerTier::Idle, Power::update(timeoutSecs));
+    TEST_ASSERT_FALSE(Power::pollingEnabled());
+
+    HostClock::advance(timeoutSecs * 1000);
+    TEST_ASSERT_EQUAL(PowerTier::Off, Power::update(timeoutSecs));
+
+    // A touch brings it straight back
+    Power::resetInactivityTimer();
+    TEST_ASSERT_EQUAL(PowerTier::Active, Power::update(timeoutSecs));
+}
+
+void test_power_timeout_zero_never_powers_off() {
+    Power::init();
+    HostClock::advance(24UL * 60 * 60 * 1000);
+    TEST_ASSERT_EQUAL(PowerTier::Idle, Power::update(0));
+    Power::resetInactivityTimer();
+}
+
+void test_power_sleep_never_overshoots_next_tier() {
+    PowerStateMachine sm;
+    sm.setTimeouts(1000, 5000, 10000);
+    sm.reset(0);
+    TEST_ASSERT_EQUAL(1000, sm.msUntilNextTier(0));
+    sm.update(1500);
+    TEST_ASSERT_EQUAL(PowerTier::LightSleep, sm.tier());
+    TEST_ASSERT_EQUAL(3500, sm.msUntilNextTier(1500));
+    sm.update(5000);
+    TEST_ASSERT_EQUAL(5000, sm.msUntilNextTier(5000));
+    sm.update(10000);
+    TEST_ASSERT_EQUAL(PowerStateMachine::NEVER, sm.msUntilNextTier(10000));
+}
+
+void test_power_commander_game_mostly_light_sleep() {
+    // Two-hour game, one life change every 30 seconds, run through the real loop wait
+    WiFi.mode(WIFI_OFF);
+    Power::init();
+    const uint32_t start = millis();
+    const uint32_t gameMs = 2UL * 60 * 60 * 1000;
+    uint32_t nextTap = start;
+
+    while (millis() - start < gameMs) {
+        if (millis() >= nextTap) {
+            Power::resetInactivityTimer();
+            nextTap += 30 * 1000;
+        }
+        TEST_ASSERT_TRUE(Power::update(0) != PowerTier::Off);
+        Power::waitForNextFrame();
+    }
+
+    const PowerStateMachine& sm = Power::stateMachine();
+    uint32_t active = sm.timeInTier(PowerTier::Active);
+    uint32_t asleep = sm.timeInTier(PowerTier::LightSleep);
+    TEST_ASSERT_EQUAL(0, sm.timeInTier(PowerTier::Idle));
+    TEST_ASSERT_TRUE(asleep > 4 * active);
+    Power::resetInactivityTimer();
+}
+
+// Power profile tests
+
+void test_power_profile_applies_together() {
+    WiFi.mode(WIFI_STA);
+    Power::init();
+
+    Power::setProfile(PowerProfile::Saver);
+    TEST_ASSERT_EQUAL(80, getCpuFrequencyMhz());
+    TEST_ASSERT_EQUAL(WIFI_PS_MAX_MODEM, WiFi.sleepMode);
+    HostClock::advance(PowerProfiles::config(PowerProfile::Saver).lightSleepAfterMs);
+    TEST_ASSERT_EQUAL(PowerTier::LightSleep, Power::update(0));
+
+    Power::setProfile(PowerProfile::Performance);
+    Power::resetInactivityTimer();
+    TEST_ASSERT_EQUAL(240, getCpuFrequencyMhz());
+    TEST_ASSERT_EQUAL(WIFI_PS_NONE, WiFi.sleepMode);
+    HostClock::advance(PowerStateMachine::DEFAULT_LIGHT_SLEEP_MS);
+    TEST_ASSERT_EQUAL(PowerTier::Active, Power::update(0));
+
+    Power::setProfile(PowerProfile::Balanced);
+    WiFi.mode(WIFI_OFF);
+}
+
+void test_power_auto_saver_on_low_battery() {
+    M5.Power.batteryLevel = 10;
+    Power::init();
+    Power::setProfile(PowerProfile::Performance);
+
+    Power::update(0);
+    TEST_ASSERT_TRUE(Power::autoSaverActive());
+    TEST_ASSERT_EQUAL(PowerProfile::Performance, Power::profile());
+    TEST_ASSERT_EQUAL(PowerProfile::Saver, Power::activeProfile());
+    TEST_ASSERT_EQUAL(80, getCpuFrequencyMhz());
+
+    // Hysteresis: a small recovery does not release it
+    M5.Power.batteryLevel = 20;
+    HostClock::advance(60 * 1000);
+    Power::update(0);
+    TEST_ASSERT_EQUAL(PowerProfile::Saver, Power::activeProfile());
+
+    M5.Power.batteryLevel = 30;
+    HostClock::advance(60 * 1000);
+    Power::update(0);
+    TEST_ASSERT_FALSE(Power::autoSaverActive());
+    TEST_ASSERT_EQUAL(240, getCpuFrequencyMhz());
+    TEST_ASSERT_EQUAL(120 * 1000, Power::timeInProfile(PowerProfile::Saver));
+
+    M5.Power.batteryLevel = 100;
+    Power::setProfile(PowerProfile::Balanced);
+    Power::resetInactivityTimer();
+}
+
+void test_power_saver_coalesces_refreshes() {
+    auto& nav = Navigation::instance();
+    M5GFX* gfx = &M5.Display;
+    nav.goHome();
+    nav.draw(gfx);
+    Power::setProfile(PowerProfile::Saver);
+    const uint32_t minRefreshMs = PowerProfiles::config(PowerProfile::Saver).minRefreshMs;
+    HostClock::advance(minRefreshMs);
+    M5.Display.hostResetStats();
+
+    // Two redraws inside the refresh interval produce one refresh
+    nav.currentScreen()->setNeedsFullRedraw(true);
+    nav.draw(gfx);
+    nav.currentScreen()->setNeedsFullRedraw(true);
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(1, M5.Display.hostStats().displayCalls);
+
+    // The deferred content goes out once the interval has passed
+    HostClock::advance(minRefreshMs);
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(2, M5.Display.hostStats().displayCalls);
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(2, M5.Display.hostStats().displayCalls);
+
+    Power::setProfile(PowerProfile::Balanced);
+}
+
+// Battery estimator tests
+
+void test_battery_filter_tracks_recorded_discharge() {
+    BatteryEstimator est;
+    uint32_t now = 0;
+    float previous = 0;
+    int32_t midpointPrediction = -1;
+    int midpointIndex = 0;
+
+    for (int i = 0; i < BALANCED_DISCHARGE_TRACE_LEN; i++) {
+        const BatteryReading& r = BALANCED_DISCHARGE_TRACE[i];
+        est.addSample(now, r.percent, r.millivolts, PowerProfile::Balanced);
+        now += TRACE_INTERVAL_MS;
+
+        // Jitter and refresh sags never read as charging or as a jump
+        TEST_ASSERT_FALSE(est.charging());
+        if (i > 0) {
+            TEST_ASSERT_TRUE(previous - est.level() < 1.5f);
+        }
+        previous = est.level();
+
+        if (midpointPrediction < 0 && est.level() <= 50.0f) {
+            midpointPrediction = est.minutesRemaining(PowerProfile::Balanced);
+            midpointIndex = i;
+        }
+    }
+
+    // The learned rate predicts the second half of the trace within 15%
+    TEST_ASSERT_TRUE(est.learned(PowerProfile::Balanced));
+    int32_t actual = (BALANCED_DISCHARGE_TRACE_LEN - 1 - midpointIndex) * TRACE_INTERVAL_MS / 60000;
+    TEST_ASSERT_INT_WITHIN(actual * 15 / 100, actual, midpointPrediction);
+    TEST_ASSERT_FALSE(est.learned(PowerProfile::Saver));
+}
+
+void test_battery_learns_each_profile() {
+    BatteryEstimator est;
+    uint32_t now = 0;
+    float level = 90.0f;
+
+    // One hour in Saver at 6%/h, then one in Performance at 18%/h
+    for (int m = 0; m < 60; m++, now += 60000, level -= 0.1f) {
+        est.addSample(now, static_cast<int8_t>(level + 0.5f), 3900, PowerProfile::Saver);
+    }
+    for (int m = 0; m < 60; m++, now += 60000, level -= 0.3f) {
+        est.addSample(now, static_cast<int8_t>(level + 0.5f), 3800, PowerProfile::Performance);
+    }
+
+    TEST_ASSERT_INT_WITHIN(100, 600, est.drainCentiPercentPerHour(PowerProfile::Saver));
+    TEST_ASSERT_INT_WITHIN(300, 1800, est.drainCentiPercentPerHour(PowerProfile::Performance));
+    TEST_ASSERT_FALSE(est.learned(PowerProfile::Balanced));
+    TEST_ASSERT_TRUE(est.minutesRemaining(PowerProfile::Saver) >
+                     est.minutesRemaining(PowerProfile::Performance));
+}
+
+void test_battery_charging_pauses_prediction() {
+    BatteryEstimator est;
+    uint32_t now = 0;
+    for (int i = 0; i < 10; i++, now += 60000) {
+        est.addSample(now, 40, 3700, PowerProfile::Balanced);
+    }
+    TEST_ASSERT_EQUAL(BatteryEstimator::SAMPLE_SLOW_MS, est.sampleIntervalMs());
+
+    for (int i = 0; i < 10; i++, now += 10000) {
+        est.addSample(now, 45 + i, 3900, PowerProfile::Balanced);
+    }
+    TEST_ASSERT_TRUE(est.charging());
+    TEST_ASSERT_EQUAL(-1, est.minutesRemaining(PowerProfile::Balanced));
+    TEST_ASSERT_EQUAL(BatteryEstimator::SAMPLE_FAST_MS, est.sampleIntervalMs());
+    TEST_ASSERT_FALSE(est.learned(PowerProfile::Balanced));
+}
+
+void test_battery_coefficients_persist_across_boots() {
+    HostNvs::instance().clear();
+    Power::init();
+    Battery::init(false);
+
+    // 30 minutes at 12%/h through the real sampling path
+    for (int i = 0; i <= 180; i++) {
+        M5.Power.batteryLevel = 80 - i / 30;
+        Battery::update();
+        HostClock::advance(10 * 1000);
+    }
+    TEST_ASSERT_TRUE(Battery::estimator().learned(PowerProfile::Balanced));
+    uint16_t learned = Battery::estimator().drainCentiPercentPerHour(PowerProfile::Balanced);
+    Battery::save();
+
+    Battery::init(false);
+    TEST_ASSERT_EQUAL(learned,
+                      Battery::estimator().drainCentiPercentPerHour(PowerProfile::Balanced));
+    M5.Power.batteryLevel = 100;
+}
+
+// Energy ledger tests
+
+void test_energy_ledger_attributes_charge() {
+    EnergyLedger ledger;
+    EnergyCoefficients c = EnergyLedger::defaultCoefficients();
+    c.refreshUc = 1000;
+    c.megapixelUc = 2000;
+    c.wifiMa = 50;
+    c.cpuMa[2] = 20;
+    c.sleepUa = 500;
+    ledger.setCoefficients(c);
+
+    ledger.recordRefresh(500000);
+    ledger.recordWifi(1000);
+    ledger.recordAwake(1000, 80);
+    ledger.recordSleep(4000);
+
+    const EnergyTotals& boot = ledger.boot();
+    TEST_ASSERT_EQUAL(2000, boot.charge(EnergySubsystem::Display));
+    TEST_ASSERT_EQUAL(50000, boot.charge(EnergySubsystem::Wifi));
+    TEST_ASSERT_EQUAL(20000, boot.charge(EnergySubsystem::Cpu));
+    TEST_ASSERT_EQUAL(2000, boot.charge(EnergySubsystem::Sleep));
+    TEST_ASSERT_EQUAL(1000, boot.cpuMs[EnergyLedger::cpuClockIndex(80)]);
+    TEST_ASSERT_EQUAL(74000, boot.totalUc());
+
+    // A new game starts from zero; the boot totals keep counting
+    ledger.resetGame();
+    ledger.recordSpeaker(20);
+    TEST_ASSERT_EQUAL(1, boot.refreshes);
+    TEST_ASSERT_EQUAL(0, ledger.game().refreshes);
+    TEST_ASSERT_EQUAL(20, ledger.game().speakerMs);
+    TEST_ASSERT_EQUAL(20, boot.speakerMs);
+}
+
+void test_energy_refresh_charged_by_drawn_area() {
+    auto& nav = Navigation::instance();
+    M5GFX* gfx = &M5.Display;
+    const EnergyTotals& boot = Energy::ledger().boot();
+    const uint64_t fullScreen = static_cast<uint64_t>(M5GFX::WIDTH) * M5GFX::HEIGHT;
+
+    nav.launchApp("mtg");
+    HostClock::advance(1000);
+    uint32_t refreshes = boot.refreshes;
+    uint64_t pixels = boot.refreshedPixels;
+    nav.currentScreen()->setNeedsFullRedraw(true);
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(refreshes + 1, boot.refreshes);
+    TEST_ASSERT_EQUAL(pixels + fullScreen, boot.refreshedPixels);
+
+    // A keystroke that keeps the key labels refreshes only the keyboard's
+    // preview line
+    nav.handleTouch(100, 100, false, true);  // Player 1 name opens the keyboard
+    HostClock::advance(1000);
+    nav.draw(gfx);
+    nav.handleTouch(300, 500, false, true);  // SPACE (also drops shift)
+    HostClock::advance(1000);
+    nav.draw(gfx);
+    HostClock::advance(1000);
+    refreshes = boot.refreshes;
+    pixels = boot.refreshedPixels;
+    nav.handleTouch(300, 500, false, true);  // SPACE
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(refreshes + 1, boot.refreshes);
+    TEST_ASSERT_EQUAL(static_cast<uint64_t>(M5GFX::WIDTH) * 44, boot.refreshedPixels - pixels);
+    nav.handleTouch(700, 500, false, true);  // CANCEL
+
+    // The same on the WiFi password keyboard
+    WiFi.scanResults = {{"HomeNet", -48, WIFI_AUTH_WPA2_PSK}};
+    nav.launchApp("settings");
+    nav.pushScreen(registeredApp<SettingsApp>("settings")->wifiScreen());
+    nav.draw(gfx);
+    nav.handleTouch(900, 50, false, true);  // SCAN
+    nav.draw(gfx);
+    nav.handleTouch(480, Layout::TOOLBAR_H + Layout::HEADER_H + 70, false, true);  // HomeNet
+    HostClock::advance(1000);
+    nav.draw(gfx);
+    nav.handleTouch(300, 500, false, true);  // SPACE (also drops shift)
+    HostClock::advance(1000);
+    nav.draw(gfx);
+    HostClock::advance(1000);
+    refreshes = boot.refreshes;
+    pixels = boot.refreshedPixels;
+    nav.handleTouch(300, 500, false, true);  // SPACE
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(refreshes + 1, boot.refreshes);
+    TEST_ASSERT_EQUAL(static_cast<uint64_t>(M5GFX::WIDTH) * 44, boot.refreshedPixels - pixels);
+    nav.handleTouch(700, 500, false, true);  // CANCEL
+    WiFi.scanResults.clear();
+    WiFi.mode(WIFI_OFF);
+    nav.goHome();
+}
+
+void test_energy_light_sleep_not_charged_as_cpu() {
+    WiFi.mode(WIFI_OFF);
+    Power::init();
+    Energy::init();
+    const EnergyTotals& boot = Energy::ledger().boot();
+    uint32_t sleepMs = boot.sleepMs;
+    uint32_t cpuMs = boot.cpuMs[EnergyLedger::cpuClockIndex(getCpuFrequencyMhz())];
+
+    HostClock::advance(PowerStateMachine::DEFAULT_LIGHT_SLEEP_MS);
+    Power::update(0);
+    Power::waitForNextFrame();
+    Energy::update();
+
+    TEST_ASSERT_EQUAL(sleepMs + 1000, boot.sleepMs);
+    TEST_ASSERT_EQUAL(cpuMs + PowerStateMachine::DEFAULT_LIGHT_SLEEP_MS,
+                      boot.cpuMs[EnergyLedger::cpuClockIndex(getCpuFrequencyMhz())]);
+    Power::resetInactivityTimer();
+}
+
+// Deferred logging tests
+
+template <typename... Args>
+static void assertLogMatchesPrintf(const char* fmt, const Args&... args) {
+    uint8_t rec[LogRecord::MAX_RECORD];
+    size_t len = LogRecord::encode(rec, sizeof(rec), LogRecord::Level::Info, 0, fmt, args...);
+    char deferred[128];
+    char direct[128];
+    LogRecord::format(rec, len, deferred, sizeof(deferred));
+    snprintf(direct, sizeof(direct), fmt, args...);
+    TEST_ASSERT_EQUAL_STRING(direct, deferred);
+}
+
+void test_log_record_formats_like_printf() {
+    assertLogMatchesPrintf("Memory: %-20s int %6u peak %6u%s", "mtg/life", 1234u, 99u, " OVER");
+    assertLogMatchesPrintf("Power: tier %d -> %d, %lu ms", -1, 2, 4000000000ul);
+    assertLogMatchesPrintf("Battery: %u.%02u%%/h at %.1f", 8u, 5u, 3.75);
+    assertLogMatchesPrintf("%llu %lld %c %x", 1ull << 40, -3ll, 'A', 0xBEEFu);
+}
+
+void test_log_record_copies_strings() {
+    char name[16] = "Alice";
+    uint8_t rec[LogRecord::MAX_RECORD];
+    size_t len =
+        LogRecord::encode(rec, sizeof(rec), LogRecord::Level::Warn, 42, "renamed %s", name);
+    strcpy(name, "Bob");
+
+    char text[32];
+    LogRecord::format(rec, len, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("renamed Alice", text);
+    LogRecord::Header h = LogRecord::readHeader(rec);
+    TEST_ASSERT_EQUAL(LogRecord::Level::Warn, h.level);
+    TEST_ASSERT_EQUAL(42, h.timestampUs);
+}
+
+void test_log_ring_wraps_and_counts_drops() {
+    uint8_t storage[64];
+    LogRing ring;
+    ring.attach(storage, sizeof(storage));
+    uint8_t rec[20];
+    uint8_t out[20];
+
+    // Many cycles so records straddle the end of the buffer
+    for (int i = 0; i < 50; i++) {
+        memset(rec, i, sizeof(rec));
+        TEST_ASSERT_TRUE(ring.push(rec, sizeof(rec)));
+        TEST_ASSERT_TRUE(ring.push(rec, 10));
+        TEST_ASSERT_EQUAL(sizeof(rec), ring.pop(out, sizeof(out)));
+        TEST_ASSERT_EQUAL(i, out[19]);
+        TEST_ASSERT_EQUAL(10, ring.pop(out, sizeof(out)));
+    }
+    TEST_ASSERT_TRUE(ring.empty());
+
+    // Full: 64 bytes hold two 22-byte records, the third is dropped
+    TEST_ASSERT_TRUE(ring.push(rec, sizeof(rec)));
+    TEST_ASSERT_TRUE(ring.push(rec, sizeof(rec)));
+    TEST_ASSERT_FALSE(ring.push(rec, sizeof(rec)));
+    TEST_ASSERT_EQUAL(1, ring.takeDropped());
+    TEST_ASSERT_EQUAL(0, ring.takeDropped());
+}
+
+// Trace span tests
+
+static void appendToString(const char* text, void* context) {
+    static_cast<std::string*>(context)->append(text);
+}
+
+void test_trace_ring_keeps_newest_spans() {
+    TraceEvent storage[4];
+    TraceRecorder recorder;
+    recorder.attach(storage, 4);
+    static const char* NAMES[] = {"a", "b", "c", "d", "e", "f", "g", "h", "i", "j"};
+    for (uint32_t i = 0; i < 10; i++) {
+        recorder.record(NAMES[i], nullptr, i * 100, 10);
+    }
+
+    TEST_ASSERT_EQUAL(4, recorder.size());
+    TEST_ASSERT_EQUAL(6, recorder.overwritten());
+    TEST_ASSERT_EQUAL_STRING("g", recorder.at(0).name);
+    TEST_ASSERT_EQUAL_STRING("j", recorder.at(3).name);
+    TEST_ASSERT_EQUAL(900, recorder.at(3).startUs);
+}
+
+void test_trace_exports_nested_scopes_as_json() {
+    Trace::init();
+    {
+        Trace::Scope outer("loop");
+        HostClock::advanceMicros(250);
+        {
+            Trace::Scope inner("nvs.save", "say \"hi\"");
+            HostClock::advanceMicros(1000);
+        }
+        HostClock::advanceMicros(50);
+    }
+
+    // Inner spans complete first; timestamps are relative to the outer start
+    std::string json;
+    Trace::exportJson(appendToString, &json);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"displayTimeUnit\":\"ms\",\"traceEvents\":["
+        "\n{\"name\":\"nvs.save\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":250,\"dur\":1000,"
+        "\"args\":{\"detail\":\"say \\\"hi\\\"\"}},"
+        "\n{\"name\":\"loop\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":0,\"dur\":1300}"
+        "\n]}\n",
+        json.c_str());
+}
+
+void test_trace_draw_span_contains_display() {
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    HostClock::advance(1000);
+    Trace::init();
+    nav.currentScreen()->setNeedsFullRedraw(true);
+    nav.draw(&M5.Display);
+
+    const TraceRecorder& recorder = Trace::recorder();
+    const TraceEvent* draw = nullptr;
+    const TraceEvent* display = nullptr;
+    for (size_t i = 0; i < recorder.size(); i++) {
+        const TraceEvent& e = recorder.at(i);
+        if (strcmp(e.name, "draw") == 0) {
+            draw = &e;
+        } else if (strcmp(e.name, "display") == 0) {
+            display = &e;
+        }
+    }
+    TEST_ASSERT_NOT_NULL(draw);
+    TEST_ASSERT_NOT_NULL(display);
+    TEST_ASSERT_EQUAL_STRING("main", draw->arg);
+    TEST_ASSERT_TRUE(display->startUs >= draw->startUs);
+    TEST_ASSERT_TRUE(display->startUs + display->durUs <= draw->startUs + draw->durUs);
+    nav.goHome();
+}
+
+// Sampling profiler tests
+
+void test_profile_ring_drops_when_full() {
+    ProfileSample storage[4];
+    ProfileSampleRing ring;
+    ring.attach(storage, 4);
+    for (uint32_t i = 0; i < 6; i++) {
+        ring.push(0x42000000 + i, 0);
+    }
+    TEST_ASSERT_EQUAL(2, ring.takeDropped());
+
+    // The oldest samples are kept; the interrupt never overwrites unread ones
+    ProfileSample sample;
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.pop(sample));
+        TEST_ASSERT_EQUAL(0x42000000 + i, sample.pc);
+    }
+    TEST_ASSERT_FALSE(ring.pop(sample));
+    ring.push(0x42001000, 0);
+    TEST_ASSERT_TRUE(ring.pop(sample));
+    TEST_ASSERT_EQUAL(0, ring.takeDropped());
+}
+
+void test_profile_sample_wire_format() {
+    // a0 from a call8 (window increment 2) into flash-mapped code
+    uint32_t caller = ProfileSamples::returnAddress(0x82001234, 0x42005678);
+    TEST_ASSERT_EQUAL(0x42001234, caller);
+    TEST_ASSERT_EQUAL(0, ProfileSamples::returnAddress(0, 0x42005678));
+
+    ProfileSample sample = {0x4037abcd, caller};
+    char line[32];
+    int len = ProfileSamples::formatLine(line, sizeof(line), sample);
+    TEST_ASSERT_EQUAL_STRING("~P 4037abcd 42001234\n", line);
+    TEST_ASSERT_EQUAL(ProfileSamples::LINE_CHARS, len);
+}
+
+// Stall detector tests
+
+void test_stall_monitor_keeps_worst_and_blames_innermost() {
+    StallMonitor monitor;
+    monitor.setThresholdMs(100);
+    uint32_t durations[] = {150, 40, 900, 120, 300, 200};
+    uint32_t now = 0;
+    for (uint32_t d : durations) {
+        monitor.beginLoop(now);
+        monitor.endPhase(StallPhase::Draw, "main", now, now + d, monitor.beginPhase());
+        now += d;
+        monitor.endLoop(now);
+    }
+
+    // Loops with a stalled callback are not counted again as loop stalls
+    TEST_ASSERT_EQUAL(5, monitor.count());
+    TEST_ASSERT_EQUAL(StallMonitor::WORST_COUNT, monitor.worstCount());
+    TEST_ASSERT_EQUAL(900, monitor.worst(0).durationMs);
+    TEST_ASSERT_EQUAL(300, monitor.worst(1).durationMs);
+    TEST_ASSERT_EQUAL(200, monitor.worst(2).durationMs);
+    TEST_ASSERT_EQUAL(150, monitor.worst(3).durationMs);
+    TEST_ASSERT_EQUAL(900, monitor.longestLoopMs());
+
+    // A touch that opens a slow screen is blamed on the screen's onEnter
+    uint32_t touchToken = monitor.beginPhase();
+    TEST_ASSERT_TRUE(monitor.endPhase(StallPhase::Enter, "wifi", now, now + 500,
+                                      monitor.beginPhase()));
+    TEST_ASSERT_FALSE(monitor.endPhase(StallPhase::Touch, "main", now, now + 510, touchToken));
+    TEST_ASSERT_EQUAL(StallPhase::Enter, monitor.worst(1).phase);
+}
+
+class SlowScreen : public Screen {
+   public:
+    uint32_t updateMs = 0;
+    uint32_t drawMs = 0;
+
+    const char* screenId() const override { return "slow"; }
+    void update() override { delay(updateMs); }
+    void draw(M5GFX* gfx) override {
+        (void)gfx;
+        delay(drawMs);
+    }
+};
+
+static void runLoopIteration(Navigation& nav) {
+    Stall::beginLoop();
+    nav.update();
+    nav.draw(&M5.Display);
+    Stall::endLoop();
+}
+
+void test_stall_detects_slow_screen_callback() {
+    auto& nav = Navigation::instance();
+    StallMonitor& monitor = Stall::monitor();
+    monitor.clear();
+    monitor.setThresholdMs(StallMonitor::DEFAULT_THRESHOLD_MS);
+    SlowScreen slow;
+    nav.launchApp("mtg");
+    nav.pushScreen(&slow);
+
+    runLoopIteration(nav);
+    TEST_ASSERT_EQUAL(0, monitor.count());
+
+    slow.updateMs = StallMonitor::DEFAULT_THRESHOLD_MS + 50;
+    runLoopIteration(nav);
+    TEST_ASSERT_EQUAL(1, monitor.count());
+    TEST_ASSERT_EQUAL(StallPhase::Update, monitor.worst(0).phase);
+    TEST_ASSERT_EQUAL_STRING("slow", monitor.worst(0).screenId);
+    TEST_ASSERT_EQUAL(StallMonitor::DEFAULT_THRESHOLD_MS + 50, monitor.worst(0).durationMs);
+
+    // Each callback under the threshold, but together they block input
+    slow.updateMs = StallMonitor::DEFAULT_THRESHOLD_MS / 2 + 10;
+    slow.drawMs = StallMonitor::DEFAULT_THRESHOLD_MS / 2 + 10;
+    runLoopIteration(nav);
+    TEST_ASSERT_EQUAL(2, monitor.count());
+    TEST_ASSERT_EQUAL(StallPhase::Loop, monitor.worst(1).phase);
+
+    // The threshold is configurable
+    monitor.setThresholdMs(1000);
+    runLoopIteration(nav);
+    TEST_ASSERT_EQUAL(2, monitor.count());
+
+    char summary[80];
+    Stall::format(summary, sizeof(summary));
+    TEST_ASSERT_EQUAL_STRING("2 over 1000ms, worst 0.3s update on slow", summary);
+
+    nav.popScreen();
+    monitor.clear();
+    monitor.setThresholdMs(StallMonitor::DEFAULT_THRESHOLD_MS);
+    nav.goHome();
+}
+
+// Diagnostics tests
+
+void test_perf_counters_window() {
+    PerfCounters perf;
+    // 50 loops over one second, two frames drawn
+    for (uint32_t t = 0; t < 1000; t += 20) {
+        perf.onLoop(t);
+    }
+    perf.onFrame(2000, 150000, true);
+    perf.onFrame(4000, 50000, false);
+    perf.onNvsWrite();
+    TEST_ASSERT_EQUAL(0, perf.loopCentiHz());  // Window still open
+
+    perf.onLoop(1000);
+    TEST_ASSERT_EQUAL(5100, perf.loopCentiHz());
+    TEST_ASSERT_EQUAL(3000, perf.renderAvgUs());
+    TEST_ASSERT_EQUAL(4000, perf.renderMaxUs());
+    TEST_ASSERT_EQUAL(100000, perf.presentAvgUs());
+    TEST_ASSERT_EQUAL(150000, perf.presentMaxUs());
+    TEST_ASSERT_EQUAL(1, perf.fullRefreshes());
+    TEST_ASSERT_EQUAL(1, perf.partialRefreshes());
+    TEST_ASSERT_EQUAL(1, perf.nvsWrites());
+
+    // An idle window reports no frame timing; counts are kept
+    perf.onLoop(2000);
+    TEST_ASSERT_EQUAL(100, perf.loopCentiHz());
+    TEST_ASSERT_EQUAL(0, perf.presentMaxUs());
+    TEST_ASSERT_EQUAL(1, perf.fullRefreshes());
+}
+
+void test_diagnostics_hidden_until_enabled() {
+    auto& registry = AppRegistry::instance();
+    auto launcherHas = [&registry](const char* id) {
+        for (int i = 0; i < registry.launchableAppCount(); i++) {
+            if (strcmp(registry.getLaunchableMetadata(i)->id, id) == 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+    int visible = registry.launchableAppCount();
+
+    registry.setHidden("diag", true);
+    TEST_ASSERT_TRUE(registry.isHidden("diag"));
+    TEST_ASSERT_FALSE(launcherHas("diag"));
+    TEST_ASSERT_EQUAL(visible - 1, registry.launchableAppCount());
+    TEST_ASSERT_EQUAL_STRING("settings", registry.getLaunchableMetadata(1)->id);
+    TEST_ASSERT_NULL(registry.getLaunchableMetadata(visible - 1));
+    TEST_ASSERT_NOT_NULL(registry.findApp("diag"));  // Still launchable by id
+
+    registry.setHidden("diag", false);
+    TEST_ASSERT_TRUE(launcherHas("diag"));
+    TEST_ASSERT_EQUAL(visible, registry.launchableAppCount());
+}
+
+void test_diagnostics_redraws_only_changed_fields() {
+    auto& nav = Navigation::instance();
+    M5GFX* gfx = &M5.Display;
+    nav.launchApp("diag");
+    nav.update();  // Leaving the previous app may save state
+    nav.draw(gfx);
+    HostClock::advance(DiagnosticsScreen::UPDATE_MS);
+    nav.update();
+    nav.draw(gfx);
+    auto* screen = static_cast<DiagnosticsScreen*>(nav.currentScreen());
+    uint32_t writes = Metrics::counters().nvsWrites();
+    char expected[24];
+    snprintf(expected, sizeof(expected), "%lu writes", static_cast<unsigned long>(writes));
+    TEST_ASSERT_EQUAL_STRING(expected, screen->value(DiagnosticsScreen::NVS_WRITES));
+    TEST_ASSERT_NOT_NULL(strstr(screen->value(DiagnosticsScreen::ALLOCS), "/main "));
+
+    // Nothing is redrawn between updates
+    HostClock::advance(1000);
+    Metrics::onNvsWrite();
+    M5.Display.hostResetStats();
+    nav.update();
+    nav.draw(gfx);
+    TEST_ASSERT_EQUAL(0, M5.Display.hostStats().displayCalls);
+
+    // The next update redraws the NVS count (and the uptime), not the screen
+    HostClock::advance(1000);
+    nav.update();
+    nav.draw(gfx);
+    snprintf(expected, sizeof(expected), "%lu writes", static_cast<unsigned long>(writes + 1));
+    TEST_ASSERT_EQUAL_STRING(expected, screen->value(DiagnosticsScreen::NVS_WRITES));
+    TEST_ASSERT_EQUAL(1, M5.Display.hostStats().displayCalls);
+    TEST_ASSERT_TRUE(M5.Display.hostStats().refreshedPixels <
+                     static_cast<uint64_t>(M5GFX::WIDTH) * M5GFX::HEIGHT / 2);
+    nav.goHome();
+}
+
+// Touch replay tests
+
+void test_touch_log_records_changes_only() {
+    TouchLogEncoder encoder;
+    encoder.start(1000);
+    TouchEvent event;
+    TEST_ASSERT_TRUE(encoder.add(1250, 100, 200, true, false, event));
+    TEST_ASSERT_EQUAL(250, event.dtMs);
+    TEST_ASSERT_FALSE(encoder.add(1270, 100, 200, true, false, event));  // Held, no news
+    TEST_ASSERT_TRUE(encoder.add(1290, 101, 200, true, false, event));   // Moved
+    TEST_ASSERT_EQUAL(40, event.dtMs);
+    TEST_ASSERT_TRUE(encoder.add(1330, 101, 200, false, true, event));
+    TEST_ASSERT_FALSE(encoder.add(1350, 0, 0, false, false, event));
+    TEST_ASSERT_EQUAL(3, encoder.count());
+
+    char line[TouchLog::LINE_CHARS];
+    TouchLog::formatLine(line, sizeof(line), event);
+    TEST_ASSERT_EQUAL_STRING("~T 40 101 200 R\n", line);
+    TouchEvent parsed;
+    TEST_ASSERT_TRUE(TouchLog::parseEvent(line, parsed));
+    TEST_ASSERT_EQUAL(40, parsed.dtMs);
+    TEST_ASSERT_EQUAL(101, parsed.x);
+    TEST_ASSERT_FALSE(parsed.pressed);
+    TEST_ASSERT_TRUE(parsed.released);
+
+    char appId[TouchLog::APP_ID_CHARS];
+    TEST_ASSERT_TRUE(TouchLog::parseApp("~T app mtg\r", appId, sizeof(appId)));
+    TEST_ASSERT_EQUAL_STRING("mtg", appId);
+    TEST_ASSERT_FALSE(TouchLog::parseEvent("~T app mtg", parsed));
+    TEST_ASSERT_FALSE(TouchLog::parseEvent("~T end 3", parsed));
+    TEST_ASSERT_FALSE(TouchLog::parseEvent("[I] Touch at 1 2", parsed));
+}
+
+// Fresh install: empty NVS, WiFi off, home screen, panel mode as set by setup()
+static void resetForReplay() {
+    M5.Display.setEpdMode(epd_fastest);
+    Navigation::instance().goHome();
+    Navigation::instance().update();
+    HostNvs::instance().clear();
+    WiFi.disconnect();
+    WiFi.mode(WIFI_OFF);
+    HostClock::advance(1000);
+}
+
+void test_replay_four_player_game() {
+    resetForReplay();
+    ReplayStats stats = TouchReplay().run(FOUR_PLAYER_GAME);
+    TouchReplay::print("4-player game", stats);
+
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    TEST_ASSERT_EQUAL(4, game.playerCount);
+    TEST_ASSERT_NOT_EQUAL(20, game.players[0].life);
+
+    // Regression limits: about 25% over the current figures
+    TEST_ASSERT_EQUAL(355, stats.events);
+    TEST_ASSERT_LESS_OR_EQUAL(186, stats.frames);
+    TEST_ASSERT_LESS_OR_EQUAL(21400000ULL, stats.refreshedPixels);
+    TEST_ASSERT_LESS_OR_EQUAL(14000000ULL, stats.panelUs);
+    TEST_ASSERT_LESS_OR_EQUAL(3430000ULL, stats.panelUc);
+    TEST_ASSERT_LESS_OR_EQUAL(443, stats.nvsWrites);
+    TEST_ASSERT_LESS_OR_EQUAL(40000, stats.maxLatencyUs);
+    Navigation::instance().goHome();
+}
+
+void test_replay_rename_players() {
+    resetForReplay();
+    ReplayStats stats = TouchReplay().run(RENAME_PLAYERS);
+    TouchReplay::print("rename all players", stats);
+
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    TEST_ASSERT_EQUAL_STRING("Alice", game.players[0].name);
+    TEST_ASSERT_EQUAL_STRING("Bob", game.players[1].name);
+    TEST_ASSERT_EQUAL_STRING("Carol", game.players[2].name);
+    TEST_ASSERT_EQUAL_STRING("Dave", game.players[3].name);
+
+    TEST_ASSERT_EQUAL(147, stats.events);
+    TEST_ASSERT_LESS_OR_EQUAL(76, stats.frames);
+    TEST_ASSERT_LESS_OR_EQUAL(10400000ULL, stats.refreshedPixels);
+    TEST_ASSERT_LESS_OR_EQUAL(4200000ULL, stats.panelUs);
+    TEST_ASSERT_LESS_OR_EQUAL(1460000ULL, stats.panelUc);
+    TEST_ASSERT_LESS_OR_EQUAL(215, stats.nvsWrites);
+    TEST_ASSERT_LESS_OR_EQUAL(10000, stats.maxLatencyUs);
+    Navigation::instance().goHome();
+}
+
+void test_replay_wifi_setup() {
+    resetForReplay();
+    WiFi.scanResults = {{"HomeNet", -48, WIFI_AUTH_WPA2_PSK},
+                        {"Cafe", -71, WIFI_AUTH_OPEN},
+                        {"Neighbour", -83, WIFI_AUTH_WPA2_PSK}};
+    ReplayStats stats = TouchReplay().run(WIFI_SETUP);
+    TouchReplay::print("WiFi setup", stats);
+
+    TEST_ASSERT_EQUAL(WL_CONNECTED, WiFi.status());
+    Preferences prefs;
+    TEST_ASSERT_TRUE(prefs.begin("wifi", true));
+    TEST_ASSERT_EQUAL_STRING("HomeNet", prefs.getString("ssid").c_str());
+    TEST_ASSERT_EQUAL_STRING("Hunter22", prefs.getString("pass").c_str());
+    prefs.end();
+    TEST_ASSERT_TRUE(prefs.begin("settings", true));
+    TEST_ASSERT_TRUE(prefs.getBool("wifiAuto"));
+    prefs.end();
+
+    TEST_ASSERT_EQUAL(35, stats.events);
+    TEST_ASSERT_LESS_OR_EQUAL(23, stats.frames);
+    TEST_ASSERT_LESS_OR_EQUAL(7000000ULL, stats.refreshedPixels);
+    TEST_ASSERT_LESS_OR_EQUAL(2250000ULL, stats.panelUs);
+    TEST_ASSERT_LESS_OR_EQUAL(545000ULL, stats.panelUc);
+    TEST_ASSERT_LESS_OR_EQUAL(20, stats.nvsWrites);
+    TEST_ASSERT_LESS_OR_EQUAL(125000, stats.maxLatencyUs);
+
+    WiFi.disconnect();
+    WiFi.mode(WIFI_OFF);
+    WiFi.scanResults.clear();
+    Navigation::instance().goHome();
+}
+
+// EPD cost model tests
+
+void test_epd_model_costs_rows_and_full_updates() {
+    EpdModel epd;
+    const int32_t W = M5GFX::WIDTH, H = M5GFX::HEIGHT;
+
+    // Time follows the rows scanned, charge the area switched
+    EpdCost wide = epd.update(epd_fastest, 400, 50, W, H);
+    EpdCost tall = epd.update(epd_fastest, 50, 400, W, H);
+    TEST_ASSERT_TRUE(wide.us < tall.us);
+    TEST_ASSERT_EQUAL(wide.uc, tall.uc);
+    TEST_ASSERT_FALSE(wide.full);
+
+    // A full update in a grey-level mode adds the clearing pass
+    EpdCost full = epd.update(epd_quality, W, H, W, H);
+    EpdCost almost = epd.update(epd_quality, W, H - 1, W, H);
+    TEST_ASSERT_TRUE(full.full);
+    TEST_ASSERT_EQUAL(epd.cost(epd_quality).fullUs + epd.cost(epd_quality).rowUs,
+                      full.us - almost.us);
+    // The ~150 ms fast waveform EnergyLedger assumes
+    uint32_t fastestFull = epd.update(epd_fastest, W, H, W, H).us;
+    TEST_ASSERT_TRUE(fastestFull > 140000 && fastestFull < 160000);
+
+    EpdModeCost measured = {10000, 100, 5000, 10000, 0, 0};
+    epd.setCost(epd_fast, measured);
+    TEST_ASSERT_EQUAL(10000 + 100 * 20, epd.update(epd_fast, 10, 20, W, H).us);
+}
+
+void test_epd_compare_modes_on_replay() {
+    static const epd_mode_t MODES[] = {epd_fastest, epd_fast, epd_text, epd_quality};
+    static const char* NAMES[] = {"4-player, fastest", "4-player, fast", "4-player, text",
+                                  "4-player, quality"};
+    uint64_t lastUs = 0;
+    uint64_t lastUc = 0;
+    for (int i = 0; i < 4; i++) {
+        resetForReplay();
+        M5.Display.setEpdMode(MODES[i]);
+        ReplayStats stats = TouchReplay().run(FOUR_PLAYER_GAME);
+        TouchReplay::print(NAMES[i], stats);
+        TEST_ASSERT_TRUE(stats.panelUs > lastUs);
+        TEST_ASSERT_TRUE(stats.panelUc > lastUc);
+        lastUs = stats.panelUs;
+        lastUc = stats.panelUc;
+    }
+    M5.Display.setEpdMode(epd_fastest);
+    Navigation::instance().goHome();
+}
+
+// Flash endurance tests
+
+// Flash wear budget: projected years at a weekly game night, and entries a
+// replayed game may program
+static constexpr double WEAR_GAME_MIN_YEARS = 70;
+static constexpr uint64_t WEAR_GAME_ENTRIES = 112;
+
+static void writeInt(NvsFlash& flash, const char* key, int32_t value) {
+    flash.write("mtg", key, reinterpret_cast<const uint8_t*>(&value), sizeof(value), false);
+}
+
+void test_nvs_flash_model_wear() {
+    NvsFlash flash;
+    writeInt(flash, "life", 20);
+    writeInt(flash, "life", 20);  // Unchanged: NVS skips it
+    TEST_ASSERT_EQUAL(1, flash.writes());
+    TEST_ASSERT_EQUAL(1, flash.skipped());
+    TEST_ASSERT_EQUAL(1, flash.entryWrites());
+
+    const char name[] = "A forty-character player name, truncated";  // 42 bytes: 1 + 2 entries
+    flash.write("mtg", "name", reinterpret_cast<const uint8_t*>(name), sizeof(name), true);
+    TEST_ASSERT_EQUAL(4, flash.entryWrites());
+
+    // Fill the ring: pages fill in turn, then garbage collection erases the
+    // page with the most superseded entries and moves its live ones
+    for (int32_t i = 0; i < static_cast<int32_t>(NvsFlash::ENTRIES_PER_PAGE) * 4; i++) {
+        writeInt(flash, "life", i);
+    }
+    TEST_ASSERT_EQUAL(0, flash.failed());
+    TEST_ASSERT_EQUAL(1, flash.totalErases());
+    TEST_ASSERT_EQUAL(0, flash.sector(0).erases);  // Oldest, but the name is still live there
+    TEST_ASSERT_EQUAL(1, flash.sector(1).erases);  // Only superseded lives: nothing to move
+    TEST_ASSERT_EQUAL(0, flash.moved());
+
+    for (int32_t i = 0; i < static_cast<int32_t>(NvsFlash::ENTRIES_PER_PAGE) * 50; i++) {
+        writeInt(flash, "life", i);
+    }
+    TEST_ASSERT_EQUAL(0, flash.failed());
+    // Wear rotates round the other pages; the page with the live name always
+    // has fewer erased entries and is never collected
+    TEST_ASSERT_EQUAL(0, flash.sector(0).erases);
+    for (uint32_t p = 1; p < flash.pageCount(); p++) {
+        TEST_ASSERT_TRUE(flash.sector(p).erases >= 11 && flash.sector(p).erases <= 14);
+    }
+    double hours = NvsWear::hoursToWearOut(flash, 1.0);
+    TEST_ASSERT_TRUE(hours > 6000 && hours < 9000);  // ~13.5 erases per sector per "hour"
+}
+
+static void printWear(const char* policy, const NvsFlash& flash, double hours) {
+    printf("[wear] %-22s %5lu writes %6llu entries %3llu erases, %9.0f years\n", policy,
+           static_cast<unsigned long>(flash.writes()),
+           static_cast<unsigned long long>(flash.entryWrites()),
+           static_cast<unsigned long long>(flash.totalErases()),
+           NvsWear::yearsToWearOut(flash, hours));
+}
+
+void test_wear_four_player_game() {
+    resetForReplay();
+    uint32_t start = millis();
+    TouchReplay().run(FOUR_PLAYER_GAME);
+    Navigation::instance().goHome();  // Save on exit
+    Navigation::instance().update();
+    double hours = (millis() - start) / 3600000.0;
+    const NvsFlash& flash = HostNvs::instance().flash;
+    printWear("4-player game", flash, hours);
+
+    // Most autosaves rewrite unchanged keys, which NVS skips; regression
+    // limits about 25% over the current figures
+    TEST_ASSERT_EQUAL(0, flash.failed());
+    TEST_ASSERT_LESS_OR_EQUAL(WEAR_GAME_ENTRIES, flash.entryWrites());
+    TEST_ASSERT_TRUE(NvsWear::yearsToWearOut(flash, hours) >= WEAR_GAME_MIN_YEARS);
+}
+
+// An hour of play: a life change every few seconds, sometimes in bursts
+// (combat), driving GameState saves under each persistence policy
+static void runWearPolicy(const char* policy, uint32_t intervalMs, bool everyChange) {
+    HostNvs::instance().clear();
+    GameState game;
+    game.playerCount = 4;
+    game.resetLifeTotals();
+    Preferences prefs;
+    game.save(prefs);
+
+    uint32_t seed = 12345;
+    uint32_t lastSave = 0;
+    const uint32_t hourMs = 3600000;
+    for (uint32_t now = 0; now < hourMs; now += 250) {
+        seed = seed * 1103515245 + 12345;
+        if ((seed >> 16) % 12 == 0) {  // About one change per 3 s
+            game.players[(seed >> 8) % 4].adjustLife((seed >> 4) % 2 ? -1 : 1);
+            if (everyChange) {
+                game.save(prefs);
+            }
+        }
+        if (intervalMs && now - lastSave > intervalMs) {
+            game.save(prefs);
+            lastSave = now;
+        }
+    }
+    game.save(prefs);  // On exit
+    printWear(policy, HostNvs::instance().flash, 1.0);
+}
+
+void test_wear_persistence_policies() {
+    runWearPolicy("save every change", 0, true);
+    double everyChange = NvsWear::yearsToWearOut(HostNvs::instance().flash, 1.0);
+    runWearPolicy("autosave 5 s (current)", MTGLifeScreen::SAVE_INTERVAL_MS, false);
+    double current = NvsWear::yearsToWearOut(HostNvs::instance().flash, 1.0);
+    runWearPolicy("autosave 30 s", 30000, false);
+    double slow = NvsWear::yearsToWearOut(HostNvs::instance().flash, 1.0);
+    runWearPolicy("save on exit only", 0, false);
+    double exitOnly = NvsWear::yearsToWearOut(HostNvs::instance().flash, 1.0);
+
+    TEST_ASSERT_TRUE(everyChange <= current);
+    TEST_ASSERT_TRUE(current < slow);
+    TEST_ASSERT_TRUE(slow < exitOnly);
+    TEST_ASSERT_TRUE(current >= WEAR_GAME_MIN_YEARS);
+    HostNvs::instance().clear();
+}
+
+// Allocation tracker tests
+
+static int* volatile g_allocSink = nullptr;  // Keeps new/delete from being elided
+
+void test_alloc_scope_counts_new_and_delete() {
+    TEST_ASSERT_TRUE(AllocTracker::enabled());
+    AllocScope scope;
+    g_allocSink = new int(7);
+    delete g_allocSink;
+    AllocTracker::Counts counts = scope.counts();
+    TEST_ASSERT_EQUAL(1, counts.allocs);
+    TEST_ASSERT_EQUAL(1, counts.frees);
+    TEST_ASSERT_EQUAL(sizeof(int), counts.bytes);
+
+    // Memory::create goes to heap_caps directly and counts itself
+    AllocScope region;
+    GameState* state = Memory::create<GameState>(Memory::Region::Internal);
+    Memory::destroy(state);
+    TEST_ASSERT_EQUAL(1, region.allocs());
+}
+
+// Centre of a life button (0=-5, 1=-1, 2=+1, 3=+5) on a wide player card
+static void lifeButtonPoint(int player, int playerCount, int button, int16_t& x, int16_t& y) {
+    Rect card = MTGLifeScreen::getPlayerCardRect(player, playerCount);
+    int16_t spacing = (card.w - 2 * 12 - 4 * 80) / 3;
+    x = card.x + 12 + button * (80 + spacing) + 40;
+    y = card.y + card.h - 48 - 12 + 24;
+}
+
+// One loop iteration with a tap
+static void tapAndDraw(int16_t x, int16_t y) {
+    auto& nav = Navigation::instance();
+    HostClock::advance(200);
+    nav.handleTouch(x, y, true, false);
+    nav.handleTouch(x, y, false, true);
+    nav.update();
+    nav.draw(&M5.Display);
+}
+
+static void pushAndDraw(Screen* screen) {
+    auto& nav = Navigation::instance();
+    nav.pushScreen(screen);
+    nav.update();
+    nav.draw(&M5.Display);
+}
+
+static void popAndDraw() {
+    auto& nav = Navigation::instance();
+    nav.popScreen();
+    nav.update();
+    nav.draw(&M5.Display);
+}
+
+// Each path is run once first: first use may allocate (lazy statics, new
+// NVS keys, components created on a screen's first visit)
+void test_life_tap_allocates_nothing() {
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    int16_t x, y;
+    lifeButtonPoint(0, game.playerCount, 2, x, y);
+    tapAndDraw(x, y);
+
+    int16_t life = game.players[0].life;
+    AllocScope scope;
+    tapAndDraw(x, y);
+    TEST_ASSERT_EQUAL(life + 1, game.players[0].life);
+    TEST_ASSERT_EQUAL(0, scope.allocs());
+    nav.goHome();
+}
+
+void test_keystroke_allocates_nothing() {
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    tapAndDraw(100, 100);  // Player 1 name opens the keyboard
+    tapAndDraw(300, 500);  // SPACE
+
+    AllocScope scope;
+    tapAndDraw(300, 500);
+    TEST_ASSERT_EQUAL(0, scope.allocs());
+    tapAndDraw(700, 500);  // CANCEL
+    nav.goHome();
+}
+
+void test_screen_push_allocates_nothing() {
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    Screen* settings = registeredApp<MTGApp>("mtg")->settingsScreen();
+    pushAndDraw(settings);
+    popAndDraw();
+
+    AllocScope push;
+    pushAndDraw(settings);
+    TEST_ASSERT_EQUAL(0, push.allocs());
+    AllocScope pop;
+    popAndDraw();
+    TEST_ASSERT_EQUAL(0, pop.allocs());
+    nav.goHome();
+}
+
+// Gesture tests
+
+void test_drag_gesture_slop_and_steps() {
+    DragGesture drag;
+    TEST_ASSERT_FALSE(drag.active());
+    drag.press(100, 200);
+    drag.move(105, 190);  // Jitter
+    TEST_ASSERT_TRUE(drag.active());
+    TEST_ASSERT_FALSE(drag.dragging());
+    TEST_ASSERT_EQUAL(0, drag.steps(12));
+    drag.move(160, 180);  // Mostly sideways
+    TEST_ASSERT_FALSE(drag.dragging());
+    drag.move(100, 176);
+    TEST_ASSERT_TRUE(drag.dragging());
+    TEST_ASSERT_EQUAL(2, drag.steps(12));
+    drag.move(100, 260);  // Still a drag once past the start
+    TEST_ASSERT_TRUE(drag.dragging());
+    TEST_ASSERT_EQUAL(-5, drag.steps(12));
+    drag.end();
+    TEST_ASSERT_FALSE(drag.active());
+    TEST_ASSERT_EQUAL(0, drag.steps(12));
+}
+
+// Centre of the life total on a wide player card
+static void lifeCentrePoint(int player, int playerCount, int16_t& x, int16_t& y) {
+    Rect card = MTGLifeScreen::getPlayerCardRect(player, playerCount);
+    x = card.x + card.w / 2;
+    y = card.y + 56 + (card.h - 56 - 48 - 12 * 2) / 2;
+}
+
+// Holds a touch at (x, fromY) and moves it to toY over ms, one loop per
+// frame, then releases it there
+static void dragAndDraw(int16_t x, int16_t fromY, int16_t toY, uint32_t ms) {
+    auto& nav = Navigation::instance();
+    uint32_t frameMs = Power::profileConfig().frameMs;
+    int32_t steps = static_cast<int32_t>(ms / frameMs);
+    for (int32_t i = 0; i <= steps; i++) {
+        int16_t y = static_cast<int16_t>(fromY + (toY - fromY) * i / steps);
+        nav.handleTouch(x, y, true, false);
+        nav.update();
+        nav.draw(&M5.Display);
+        HostClock::advance(frameMs);
+    }
+    nav.handleTouch(x, toY, false, true);
+    nav.update();
+    nav.draw(&M5.Display);
+}
+
+void test_life_drag_commits_on_release() {
+    resetForReplay();
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    int16_t x, y;
+    lifeCentrePoint(0, game.playerCount, x, y);
+    int16_t life = game.players[0].life;
+
+    // Nothing is applied while the finger is down
+    nav.handleTouch(x, y, true, false);
+    for (int i = 1; i <= 10; i++) {
+        HostClock::advance(20);
+        nav.handleTouch(x, y - i * 12, true, false);
+        nav.update();
+        nav.draw(&M5.Display);
+    }
+    TEST_ASSERT_EQUAL(life, game.players[0].life);
+    nav.handleTouch(x, y - 144, false, true);
+    nav.update();
+    nav.draw(&M5.Display);
+    TEST_ASSERT_EQUAL(life + 12, game.players[0].life);
+
+    // Jitter on the life total is a tap, which changes nothing
+    HostClock::advance(200);
+    nav.handleTouch(x, y, true, false);
+    nav.handleTouch(x + 4, y + 6, true, false);
+    nav.handleTouch(x + 4, y + 6, false, true);
+    TEST_ASSERT_EQUAL(life + 12, game.players[0].life);
+
+    // A drag released over a button commits the drag, not the button
+    int16_t bx, by;
+    lifeButtonPoint(0, game.playerCount, 1, bx, by);
+    HostClock::advance(200);
+    dragAndDraw(x, y, by, 300);
+    TEST_ASSERT_EQUAL(life + 12 - (by - y) / 12, game.players[0].life);
+    nav.goHome();
+}
+
+// The preview is throttled, so a drag costs frames by duration, not distance;
+// the same change on the buttons costs one frame per tap
+void test_life_drag_refreshes_bounded() {
+    resetForReplay();
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    int16_t x, y;
+    lifeCentrePoint(0, game.playerCount, x, y);
+
+    const uint32_t DRAG_MS = 400;
+    const uint32_t MAX_FRAMES = DRAG_MS / 200 + 2;  // Previews, then the commit
+    int16_t life = game.players[0].life;
+    uint32_t frames = M5.Display.hostStats().displayCalls;
+    dragAndDraw(x, y, y - 12 * 12, DRAG_MS);
+    uint32_t smallDrag = M5.Display.hostStats().displayCalls - frames;
+    TEST_ASSERT_EQUAL(life + 12, game.players[0].life);
+
+    HostClock::advance(200);
+    frames = M5.Display.hostStats().displayCalls;
+    dragAndDraw(x, y, y + 30 * 12, DRAG_MS);
+    uint32_t bigDrag = M5.Display.hostStats().displayCalls - frames;
+    TEST_ASSERT_EQUAL(life - 18, game.players[0].life);
+
+    // 30 points on the buttons: six taps of -5
+    int16_t bx, by;
+    lifeButtonPoint(0, game.playerCount, 0, bx, by);
+    frames = M5.Display.hostStats().displayCalls;
+    for (int i = 0; i < 6; i++) {
+        tapAndDraw(bx, by);
+    }
+    uint32_t taps = M5.Display.hostStats().displayCalls - frames;
+    TEST_ASSERT_EQUAL(life - 48, game.players[0].life);
+
+    printf("[gesture] 12-point drag %lu frames, 30-point drag %lu frames, 30 points by tap "
+           "%lu frames\n",
+           static_cast<unsigned long>(smallDrag), static_cast<unsigned long>(bigDrag),
+           static_cast<unsigned long>(taps));
+    TEST_ASSERT_LESS_OR_EQUAL(MAX_FRAMES, smallDrag);
+    TEST_ASSERT_LESS_OR_EQUAL(MAX_FRAMES, bigDrag);
+    TEST_ASSERT_TRUE(bigDrag < taps);
+    nav.goHome();
+}
+
+void test_auto_repeat_accelerates() {
+    AutoRepeat repeat;
+    TEST_ASSERT_EQUAL(0, repeat.update(1000));
+    repeat.press(1000);
+    TEST_ASSERT_EQUAL(0, repeat.update(1499));
+    TEST_ASSERT_EQUAL(1, repeat.update(1500));
+    TEST_ASSERT_EQUAL(0, repeat.update(1700));  // Within the interval
+    TEST_ASSERT_EQUAL(1, repeat.update(1750));
+
+    // A stalled loop gets one step, not the ones it missed
+    TEST_ASSERT_EQUAL(1, repeat.update(5000));
+    TEST_ASSERT_EQUAL(0, repeat.update(5100));
+    TEST_ASSERT_EQUAL(1, repeat.update(5250));
+    TEST_ASSERT_EQUAL(5, repeat.update(5500));
+    TEST_ASSERT_EQUAL(5, AutoRepeat::stepFor(7));
+    TEST_ASSERT_EQUAL(10, AutoRepeat::stepFor(8));
+    TEST_ASSERT_EQUAL(10, AutoRepeat::stepFor(1000));
+
+    repeat.cancel();
+    TEST_ASSERT_FALSE(repeat.active());
+    TEST_ASSERT_EQUAL(0, repeat.update(9000));
+}
+
+// Holds a touch still at (x, y) for ms of virtual time (sounds take some),
+// one loop per frame, then releases it
+static void holdAndDraw(int16_t x, int16_t y, uint32_t ms) {
+    auto& nav = Navigation::instance();
+    uint32_t frameMs = Power::profileConfig().frameMs;
+    uint32_t start = millis();
+    while (millis() - start <= ms) {
+        nav.handleTouch(x, y, true, false);
+        nav.update();
+        nav.draw(&M5.Display);
+        HostClock::advance(frameMs);
+    }
+    nav.handleTouch(x, y, false, true);
+    nav.update();
+    nav.draw(&M5.Display);
+}
+
+void test_life_button_hold_repeats() {
+    resetForReplay();
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    int16_t x, y;
+    lifeButtonPoint(0, game.playerCount, 2, x, y);  // +1
+    int16_t life = game.players[0].life;
+
+    // Shorter than the delay: an ordinary tap
+    holdAndDraw(x, y, 300);
+    TEST_ASSERT_EQUAL(life + 1, game.players[0].life);
+
+    // A step every 250 ms or so from 500 ms (four of 1, four of 5, then 10s),
+    // one frame each; the release adds nothing
+    HostClock::advance(200);
+    life = game.players[0].life;
+    uint32_t frames = M5.Display.hostStats().displayCalls;
+    holdAndDraw(x, y, 3000);
+    frames = M5.Display.hostStats().displayCalls - frames;
+    int16_t expected = life;
+    for (uint32_t i = 0; i < frames; i++) {
+        expected += AutoRepeat::stepFor(i);
+    }
+    TEST_ASSERT_EQUAL(expected, game.players[0].life);
+    TEST_ASSERT_TRUE(frames >= 2 * AutoRepeat::STEPS_PER_STAGE + 1);  // Reached 10s
+    TEST_ASSERT_LESS_OR_EQUAL((3000 - AutoRepeat::DELAY_MS) / AutoRepeat::INTERVAL_MS + 1, frames);
+
+    // -5 never steps less than 5
+    HostClock::advance(200);
+    lifeButtonPoint(0, game.playerCount, 0, x, y);
+    life = game.players[0].life;
+    holdAndDraw(x, y, 1000);
+    TEST_ASSERT_EQUAL(life - 3 * 5, game.players[0].life);
+    nav.goHome();
+}
+
+void test_life_button_hold_stops_off_button() {
+    resetForReplay();
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    int16_t x, y;
+    lifeButtonPoint(0, game.playerCount, 1, x, y);  // -1
+    int16_t life = game.players[0].life;
+
+    // Scripted: hold for two steps, slide off the card, hold on, release
+    // there. The release is neither a tap nor a step.
+    uint32_t frameMs = Power::profileConfig().frameMs;
+    uint32_t start = millis();
+    while (millis() - start <= 800) {
+        nav.handleTouch(x, y, true, false);
+        HostClock::advance(frameMs);
+    }
+    TEST_ASSERT_EQUAL(life - 2, game.players[0].life);
+    Rect card = MTGLifeScreen::getPlayerCardRect(0, game.playerCount);
+    int16_t offX = card.x + card.w + 40;
+    for (uint32_t t = 0; t <= 1000; t += frameMs) {
+        nav.handleTouch(offX, y, true, false);
+        HostClock::advance(frameMs);
+    }
+    nav.handleTouch(offX, y, false, true);
+    TEST_ASSERT_EQUAL(life - 2, game.players[0].life);
+
+    // The next tap on the card is a tap again
+    HostClock::advance(200);
+    tapAndDraw(x, y);
+    TEST_ASSERT_EQUAL(life - 3, game.players[0].life);
+    nav.goHome();
+}
+
+// Multi-touch tests
+
+void test_touch_log_keeps_points_apart() {
+    TouchLogEncoder encoder;
+    encoder.start(0);
+    TouchEvent event;
+    TEST_ASSERT_TRUE(encoder.add(100, 0, 300, 500, true, false, event));
+    TEST_ASSERT_TRUE(encoder.add(100, 1, 780, 500, true, false, event));
+    TEST_ASSERT_EQUAL(0, event.dtMs);  // Same loop
+    TEST_ASSERT_FALSE(encoder.add(120, 0, 300, 500, true, false, event));  // Each held
+    TEST_ASSERT_FALSE(encoder.add(120, 1, 780, 500, true, false, event));
+    TEST_ASSERT_TRUE(encoder.add(140, 1, 780, 500, false, true, event));
+    TEST_ASSERT_FALSE(encoder.add(140, TouchPoint::MAX_POINTS, 1, 1, true, false, event));
+
+    char line[TouchLog::LINE_CHARS];
+    TouchLog::formatLine(line, sizeof(line), event);
+    TEST_ASSERT_EQUAL_STRING("~T 40 780 500 R 1\n", line);
+    TouchEvent parsed;
+    TEST_ASSERT_TRUE(TouchLog::parseEvent(line, parsed));
+    TEST_ASSERT_EQUAL(1, parsed.id);
+    TEST_ASSERT_TRUE(TouchLog::parseEvent("~T 40 780 500 R", parsed));
+    TEST_ASSERT_EQUAL(0, parsed.id);
+    TEST_ASSERT_FALSE(TouchLog::parseEvent("~T 40 780 500 R 9", parsed));
+}
+
+static TouchPoint touchPoint(uint8_t id, int16_t x, int16_t y, bool pressed, bool released) {
+    TouchPoint point;
+    point.id = id;
+    point.x = x;
+    point.y = y;
+    point.pressed = pressed;
+    point.released = released;
+    return point;
+}
+
+// Single-touch screens and the life screen's header see only the first finger
+void test_second_finger_ignored_off_cards() {
+    resetForReplay();
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    int16_t x, y;
+    lifeCentrePoint(0, game.playerCount, x, y);
+
+    nav.handleTouch(touchPoint(0, x, y, true, false));
+    nav.handleTouch(touchPoint(1, 901, 55, true, false));  // Settings
+    nav.handleTouch(touchPoint(1, 901, 55, false, true));
+    nav.update();
+    TEST_ASSERT_EQUAL_STRING("main", nav.currentScreen()->screenId());
+    nav.handleTouch(touchPoint(0, x, y, false, true));
+
+    // A finger already down when the primary lifts does not take over: its
+    // release is not a tap for the header
+    HostClock::advance(200);
+    nav.handleTouch(touchPoint(0, x, y, true, false));
+    nav.handleTouch(touchPoint(1, 901, 55, true, false));
+    nav.handleTouch(touchPoint(0, x, y, false, true));
+    nav.handleTouch(touchPoint(1, 901, 55, true, false));
+    nav.handleTouch(touchPoint(1, 901, 55, false, true));
+    nav.update();
+    TEST_ASSERT_EQUAL_STRING("main", nav.currentScreen()->screenId());
+
+    // Once the first finger lifts, the next one down is primary
+    HostClock::advance(200);
+    nav.handleTouch(touchPoint(1, 901, 55, true, false));
+    nav.handleTouch(touchPoint(1, 901, 55, false, true));
+    nav.update();
+    TEST_ASSERT_EQUAL_STRING("settings", nav.currentScreen()->screenId());
+    nav.goHome();
+}
+
+void test_two_cards_update_in_one_frame() {
+    resetForReplay();
+    auto& nav = Navigation::instance();
+    GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    game.reset();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    int16_t x1, y1, x2, y2;
+    lifeButtonPoint(0, game.playerCount, 2, x1, y1);  // +1
+    lifeButtonPoint(1, game.playerCount, 1, x2, y2);  // -1
+    int16_t life1 = game.players[0].life;
+    int16_t life2 = game.players[1].life;
+
+    HostClock::advance(200);
+    uint32_t frames = M5.Display.hostStats().displayCalls;
+    nav.handleTouch(touchPoint(0, x1, y1, true, false));
+    nav.handleTouch(touchPoint(1, x2, y2, true, false));
+    nav.update();
+    nav.draw(&M5.Display);
+    HostClock::advance(60);
+    nav.handleTouch(touchPoint(0, x1, y1, false, true));
+    nav.handleTouch(touchPoint(1, x2, y2, false, true));
+    nav.update();
+    nav.draw(&M5.Display);
+    TEST_ASSERT_EQUAL(life1 + 1, game.players[0].life);
+    TEST_ASSERT_EQUAL(life2 - 1, game.players[1].life);
+    TEST_ASSERT_EQUAL(1, M5.Display.hostStats().displayCalls - frames);
+    nav.goHome();
+}
+
+struct MultiTouchCheck {
+    const GameState* game;
+    int16_t lifeAfterPair[2];
+    uint32_t pairFrames;
+};
+
+void test_replay_two_player_multitouch() {
+    resetForReplay();
+    GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    game.reset();  // Fresh install: two players on 20
+
+    // Events 6 and 7 release both -5s in one loop
+    MultiTouchCheck check = {&game, {0, 0}, 0};
+    TouchReplay replay;
+    replay.onEvent(
+        [](uint32_t index, const TouchEvent&, const ReplayEventStats& stats, void* ctx) {
+            MultiTouchCheck* c = static_cast<MultiTouchCheck*>(ctx);
+            if (index == 6) {
+                c->lifeAfterPair[0] = c->game->players[0].life;
+                c->lifeAfterPair[1] = c->game->players[1].life;
+                c->pairFrames = stats.frames;
+            }
+        },
+        &check);
+    ReplayStats stats = replay.run(TWO_PLAYER_MULTITOUCH);
+    TouchReplay::print("2-player multi-touch", stats);
+
+    TEST_ASSERT_EQUAL(23, stats.events);
+    TEST_ASSERT_EQUAL(20 + 1 - 5, check.lifeAfterPair[0]);
+    TEST_ASSERT_EQUAL(20 + 1 - 5, check.lifeAfterPair[1]);
+    TEST_ASSERT_EQUAL(1, check.pairFrames);
+
+    // P1: +1, -5, drag +10, -1 (the second finger on the card is dropped).
+    // P2: +1, -5, held +1 repeating twice, -1.
+    TEST_ASSERT_EQUAL(25, game.players[0].life);
+    TEST_ASSERT_EQUAL(17, game.players[1].life);
+    Navigation::instance().goHome();
+}
+
+// Touch-down commit tests
+
+void test_life_commit_on_press() {
+    Settings settings;
+    settings.lifeOnTouchDown = true;
+    Preferences prefs;
+    settings.save(prefs);
+    Settings loaded;
+    loaded.load(prefs);
+    TEST_ASSERT_TRUE(loaded.lifeOnTouchDown);
+
+    resetForReplay();
+    PlayerCard::setCommitOnPress(loaded.lifeOnTouchDown);
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    int16_t x, y;
+    lifeButtonPoint(0, game.playerCount, 2, x, y);  // +1
+    int16_t life = game.players[0].life;
+
+    // The press changes life and draws; the release does neither
+    HostClock::advance(200);
+    uint32_t frames = M5.Display.hostStats().displayCalls;
+    nav.handleTouch(x, y, true, false);
+    TEST_ASSERT_EQUAL(life + 1, game.players[0].life);
+    nav.update();
+    nav.draw(&M5.Display);
+    HostClock::advance(80);
+    nav.handleTouch(x, y, true, false);
+    nav.handleTouch(x, y, false, true);
+    nav.update();
+    nav.draw(&M5.Display);
+    TEST_ASSERT_EQUAL(life + 1, game.players[0].life);
+    TEST_ASSERT_EQUAL(1, M5.Display.hostStats().displayCalls - frames);
+
+    // Holding still repeats: the press, then steps at about 500 and 750 ms
+    HostClock::advance(200);
+    holdAndDraw(x, y, 1000);
+    TEST_ASSERT_EQUAL(life + 1 + 1 + 2, game.players[0].life);
+
+    PlayerCard::setCommitOnPress(false);
+    nav.goHome();
+}
+
+// In touch-down mode a second tap inside DEBOUNCE_MS is dropped, release
+// included: the release must not commit what the press debounced
+void test_life_commit_on_press_debounces() {
+    resetForReplay();
+    PlayerCard::setCommitOnPress(true);
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    nav.update();
+    nav.draw(&M5.Display);
+    const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+    int16_t x, y;
+    lifeButtonPoint(0, game.playerCount, 2, x, y);  // +1
+    int16_t life = game.players[0].life;
+    const uint32_t debounceMs = 100;  // PlayerCard::DEBOUNCE_MS
+
+    HostClock::advance(200);
+    uint32_t pressMs = millis();
+    nav.handleTouch(x, y, true, false);
+    nav.handleTouch(x, y, false, true);
+    TEST_ASSERT_EQUAL(life + 1, game.players[0].life);
+
+    // The bounce lands within DEBOUNCE_MS of the tap; its release well after
+    HostClock::advance(debounceMs / 2 - (millis() - pressMs));
+    nav.handleTouch(x, y, true, false);
+    HostClock::advance(2 * debounceMs);
+    nav.handleTouch(x, y, false, true);
+    nav.update();
+    nav.draw(&M5.Display);
+    TEST_ASSERT_EQUAL(life + 1, game.players[0].life);
+
+    // The next tap past the debounce counts
+    HostClock::advance(200);
+    nav.handleTouch(x, y, true, false);
+    nav.handleTouch(x, y, false, true);
+    TEST_ASSERT_EQUAL(life + 2, game.players[0].life);
+
+    PlayerCard::setCommitOnPress(false);
+    nav.goHome();
+}
+
+// Touch-to-ink over the four-player game in both modes: same game, same
+// frames, and each life tap inks one tap-length sooner on touch-down
+void test_touch_to_ink_by_commit_mode() {
+    const char* NAMES[] = {"4-player, on release", "4-player, on press"};
+    ReplayStats stats[2];
+    int16_t lives[2][4];
+    for (int mode = 0; mode < 2; mode++) {
+        resetForReplay();
+        registeredApp<MTGApp>("mtg")->gameState().reset();
+        PlayerCard::setCommitOnPress(mode == 1);
+        stats[mode] = TouchReplay().run(FOUR_PLAYER_GAME);
+        TouchReplay::print(NAMES[mode], stats[mode]);
+        const GameState& game = registeredApp<MTGApp>("mtg")->gameState();
+        for (int i = 0; i < 4; i++) {
+            lives[mode][i] = game.players[i].life;
+        }
+        Navigation::instance().goHome();
+    }
+    PlayerCard::setCommitOnPress(false);
+
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL(lives[0][i], lives[1][i]);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(stats[0].frames, stats[1].frames);
+    TEST_ASSERT_TRUE(stats[1].meanInkUs() < stats[0].meanInkUs());
+    TEST_ASSERT_TRUE(stats[1].inkSamples > 0);
+}
+
+// Keyboard redraw tests
+
+static void keyPoint(const Keyboard& keyboard, int row, int col, int16_t& x, int16_t& y) {
+    Rect r = keyboard.getKeyRect(row, col);
+    x = static_cast<int16_t>(r.x + r.w / 2);
+    y = static_cast<int16_t>(r.y + r.h / 2);
+}
+
+void test_keyboard_key_at_matches_rects() {
+    Keyboard keyboard("", nullptr);
+    const int COLS[] = {11, 10, 10, 3};
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < COLS[row]; col++) {
+            Rect r = keyboard.getKeyRect(row, col);
+            int foundRow = -1;
+            int foundCol = -1;
+            TEST_ASSERT_TRUE(keyboard.keyAt(r.x, r.y, foundRow, foundCol));
+            TEST_ASSERT_EQUAL(row, foundRow);
+            TEST_ASSERT_EQUAL(col, foundCol);
+            TEST_ASSERT_TRUE(keyboard.keyAt(r.x + r.w - 1, r.y + r.h - 1, foundRow, foundCol));
+            TEST_ASSERT_EQUAL(col, foundCol);
+            // The gap right of the key and the one below it hit nothing
+            if (col < COLS[row] - 1) {
+                TEST_ASSERT_FALSE(keyboard.keyAt(r.x + r.w, r.y, foundRow, foundCol));
+            }
+            TEST_ASSERT_FALSE(keyboard.keyAt(r.x, r.y + r.h, foundRow, foundCol));
+        }
+    }
+    int row;
+    int col;
+    Rect bounds = keyboard.getBounds();
+    TEST_ASSERT_FALSE(keyboard.keyAt(bounds.x + bounds.w / 2, bounds.y + 10, row, col));  // Preview
+    TEST_ASSERT_FALSE(keyboard.keyAt(bounds.x + 2, bounds.y + 100, row, col));  // Left margin
+    TEST_ASSERT_FALSE(keyboard.keyAt(bounds.x + 50, bounds.y + 240, row, col));  // Left of SPACE
+}
+
+// Keys tapped between draws are applied in order, shift included, and the
+// text handed over on DONE has them all, even past the pending buffer
+void test_keyboard_keeps_keys_typed_before_draw() {
+    char result[40] = "";
+    Keyboard keyboard("", [&result](const char* text, bool confirmed) {
+        if (confirmed) {
+            strncpy(result, text, sizeof(result) - 1);
+        }
+    });
+    int16_t x, y;
+    const int KEYS[][2] = {{0, 2}, {2, 9}, {0, 2}, {0, 3}};  // E, shift, E, R
+    for (const auto& key : KEYS) {
+        keyPoint(keyboard, key[0], key[1], x, y);
+        keyboard.handleTouch(x, y, false, true);
+    }
+    keyPoint(keyboard, 3, 0, x, y);  // SPACE
+    for (int i = 0; i < 20; i++) {
+        keyboard.handleTouch(x, y, false, true);
+    }
+    keyPoint(keyboard, 0, 10, x, y);  // Backspace
+    for (int i = 0; i < 19; i++) {
+        keyboard.handleTouch(x, y, false, true);
+    }
+    keyPoint(keyboard, 3, 1, x, y);  // DONE, with nothing drawn yet
+    keyboard.handleTouch(x, y, false, true);
+    TEST_ASSERT_EQUAL_STRING("EEr ", result);
+}
+
+// A keystroke redraws the preview line; shift and 123 redraw only the keys
+// whose label changes
+void test_keyboard_redraws_changed_parts_only() {
+    Keyboard keyboard("", nullptr);
+    Rect bounds = keyboard.getBounds();
+    keyboard.draw(&M5.Display);
+    TEST_ASSERT_EQUAL(bounds.w, keyboard.drawnArea().w);
+    TEST_ASSERT_EQUAL(bounds.h, keyboard.drawnArea().h);
+
+    int16_t x, y;
+    keyPoint(keyboard, 2, 9, x, y);  // Shift off: letters and the shift key
+    keyboard.handleTouch(x, y, false, true);
+    keyboard.draw(&M5.Display);
+    Rect shift = keyboard.drawnArea();
+    TEST_ASSERT_EQUAL(keyboard.getKeyRect(0, 0).y, shift.y);
+    TEST_ASSERT_EQUAL(keyboard.getKeyRect(2, 9).y + 50, shift.y + shift.h);
+    TEST_ASSERT_EQUAL(keyboard.getKeyRect(0, 0).x, shift.x);
+
+    keyPoint(keyboard, 0, 0, x, y);  // q
+    keyboard.handleTouch(x, y, false, true);
+    keyboard.draw(&M5.Display);
+    Rect preview = keyboard.drawnArea();
+    TEST_ASSERT_EQUAL(bounds.y, preview.y);
+    TEST_ASSERT_EQUAL(44, preview.h);
+
+    keyPoint(keyboard, 2, 0, x, y);  // 123: every character key, not row 3
+    keyboard.handleTouch(x, y, false, true);
+    keyboard.draw(&M5.Display);
+    Rect mode = keyboard.drawnArea();
+    TEST_ASSERT_EQUAL(keyboard.getKeyRect(0, 0).y, mode.y);
+    TEST_ASSERT_TRUE(mode.y + mode.h <= keyboard.getKeyRect(3, 0).y);
+
+    keyboard.invalidate();
+    keyboard.draw(&M5.Display);
+    TEST_ASSERT_EQUAL(bounds.h, keyboard.drawnArea().h);
+}
+
+// A second finger typing while the first is still down is not dropped
+void test_keyboard_takes_overlapping_keys() {
+    resetForReplay();
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    tapAndDraw(100, 100);  // Player 1 name opens the keyboard
+    Keyboard layout("", nullptr);
+    int16_t x, y, x2, y2;
+    keyPoint(layout, 0, 10, x, y);
+    for (int i = 0; i < 10; i++) {
+        tapAndDraw(x, y);  // Clear "Player 1"
+    }
+    keyPoint(layout, 1, 0, x, y);    // A
+    keyPoint(layout, 1, 8, x2, y2);  // L
+    nav.handleTouch(touchPoint(0, x, y, true, false));
+    nav.handleTouch(touchPoint(1, x2, y2, true, false));
+    nav.handleTouch(touchPoint(1, x2, y2, false, true));
+    nav.handleTouch(touchPoint(0, x, y, false, true));
+    nav.update();
+    nav.draw(&M5.Display);
+    keyPoint(layout, 3, 1, x, y);
+    tapAndDraw(x, y);  // DONE
+    TEST_ASSERT_EQUAL_STRING("La", registeredApp<MTGApp>("mtg")->gameState().players[0].name);
+    nav.goHome();
+}
+
+// Typing a 15-character name refreshes the preview line per key instead of
+// the whole keyboard
+void test_keyboard_name_typing_pixels() {
+    resetForReplay();
+    auto& nav = Navigation::instance();
+    nav.launchApp("mtg");
+    tapAndDraw(100, 100);  // Player 1 name opens the keyboard
+    Keyboard layout("", nullptr);
+    int16_t x, y;
+    keyPoint(layout, 0, 10, x, y);
+    for (int i = 0; i < 10; i++) {
+        tapAndDraw(x, y);  // Clear "Player 1"
+    }
+
+    const char* NAME = "Jace the planes";
+    const size_t LEN = strlen(NAME);
+    uint64_t pixels = M5.Display.hostStats().refreshedPixels;
+    for (size_t i = 0; i < LEN; i++) {
+        char want = NAME[i];
+        char upper = want >= 'a' && want <= 'z' ? static_cast<char>(want - 32) : want;
+        bool found = want == ' ';
+        if (found) {
+            keyPoint(layout, 3, 0, x, y);
+        }
+        for (int row = 0; row < 3 && !found; row++) {
+            for (int col = 0; col < 10 && !found; col++) {
+                if (layout.getKeyChar(row, col) == upper) {
+                    keyPoint(layout, row, col, x, y);
+                    found = true;
+                }
+            }
+        }
+        TEST_ASSERT_TRUE(found);
+        tapAndDraw(x, y);
+    }
+    pixels = M5.Display.hostStats().refreshedPixels - pixels;
+    const uint64_t wholeKeyboard = static_cast<uint64_t>(LEN) * layout.getBounds().w *
+                                   layout.getBounds().h;
+    printf("[keyboard] %u-char name: %llu px refreshed (whole keyboard per key: %llu)\n",
+           static_cast<unsigned>(LEN), static_cast<unsigned long long>(pixels),
+           static_cast<unsigned long long>(wholeKeyboard));
+
+    keyPoint(layout, 3, 1, x, y);
+    tapAndDraw(x, y);  // DONE
+    TEST_ASSERT_EQUAL_STRING("Jace the planes",
+                             registeredApp<MTGApp>("mtg")->gameState().players[0].name);
+    TEST_ASSERT_LESS_OR_EQUAL(wholeKeyboard / 4, pixels);
+    nav.goHome();
+}
+
+// Deep-sleep resume tests
+
+void test_resume_warm_wake_skips_nvs_and_keeps_panel() {
+    auto& nav = Navigation::instance();
+    M5GFX* gfx = &M5.Display;
+    Settings settings;
+    settings.sleepTimeoutSecs = 120;
+
+    nav.launchApp("mtg");
+    MTGApp* mtg = registeredApp<MTGApp>("mtg");
+    mtg->gameState().players[0].life = 33;
+    mtg->gameState().players[1].life = 7;
+    nav.currentScreen()->setNeedsFullRedraw(true);
+    nav.draw(gfx);
+    Resume::capture(settings);
+
+    // Deep sleep: RAM is lost but the EPD keeps its image
+    nav.launchApp("home");
+    mtg->gameState().players[0].life = 1;
+    M5.Display.hostPowerCycle();
+    M5.Display.hostResetStats();
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_EXT0;
+    uint32_t nvsReads = HostNvs::instance().reads;
+
+    Settings restored;
+    TEST_ASSERT_TRUE(Resume::isWarmWake());
+    TEST_ASSERT_TRUE(Resume::restore(restored));
+    nav.draw(gfx);
+
+    TEST_ASSERT_EQUAL(120, restored.sleepTimeoutSecs);
+    TEST_ASSERT_EQUAL_PTR(mtg, nav.currentApp());
+    TEST_ASSERT_EQUAL(33, mtg->gameState().players[0].life);
+    TEST_ASSERT_EQUAL(7, mtg->gameState().players[1].life);
+    TEST_ASSERT_EQUAL(nvsReads, HostNvs::instance().reads);
+
+    // The redraw matches what the panel already shows, apart from the toolbar
+    TEST_ASSERT_LESS_OR_EQUAL(static_cast<uint64_t>(M5GFX::WIDTH) * Toolbar::HEIGHT,
+                              M5.Display.hostStats().changedPixels);
+
+    // The snapshot is single-use
+    TEST_ASSERT_FALSE(Resume::isWarmWake());
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+    nav.goHome();
+}
+
+void test_resume_keeps_settings_changed_in_app() {
+    auto& nav = Navigation::instance();
+    M5GFX* gfx = &M5.Display;
+    const Settings before = globalSettings;
+    nav.launchApp("settings");
+    nav.draw(gfx);
+    nav.handleTouch(430, Layout::TOOLBAR_H + Layout::HEADER_H + 180, false, true);  // Sleep 1m
+    TEST_ASSERT_EQUAL(60, globalSettings.sleepTimeoutSecs);
+    Resume::capture(globalSettings);
+
+    // Deep sleep: RAM is lost, the snapshot brings the edit back
+    globalSettings.initDefaults();
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_EXT0;
+    TEST_ASSERT_TRUE(Resume::restore(globalSettings));
+    TEST_ASSERT_EQUAL(60, globalSettings.sleepTimeoutSecs);
+    TEST_ASSERT_EQUAL(60, registeredApp<SettingsApp>("settings")->settings().sleepTimeoutSecs);
+
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+    globalSettings = before;
+    Preferences prefs;
+    globalSettings.save(prefs);
+    nav.goHome();
+}
+
+void test_resume_cold_boot_ignores_snapshot() {
+    Settings settings;
+    Navigation::instance().launchApp("mtg");
+    Resume::capture(settings);
+
+    // Power-on reset: no wake cause, so the snapshot is discarded
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+    TEST_ASSERT_FALSE(Resume::isWarmWake());
+    TEST_ASSERT_FALSE(Resume::restore(settings));
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_EXT0;
+    TEST_ASSERT_FALSE(Resume::isWarmWake());
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;
+    Navigation::instance().goHome();
+}
+
+// Deep sleep is the tier before power-off: touch resumes, and a timer that
+// runs out untouched brings the device up only to power it off
+void test_deep_sleep_times_out_to_power_off() {
+    uint32_t sleeps = M5.Power.deepSleepCalls;
+    Power::deepSleep();
+    TEST_ASSERT_EQUAL(sleeps + 1, M5.Power.deepSleepCalls);
+    TEST_ASSERT_EQUAL(static_cast<uint64_t>(Power::DEEP_SLEEP_MAX_SECS) * 1000 * 1000,
+                      M5.Power.deepSleepUs);
+
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_EXT0;  // Touch
+    TEST_ASSERT_FALSE(Power::wokeToPowerOff());
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_TIMER;
+    TEST_ASSERT_TRUE(Power::wokeToPowerOff());
+    HostSleep::wakeCause = ESP_SLEEP_WAKEUP_UNDEFINED;  // Power-on
+    TEST_ASSERT_FALSE(Power::wokeToPowerOff());
+}
+
 int main(int argc, char** argv) {
     UNITY_BEGIN();
 
@@ -125,6 +2425,130 @@ int main(int argc, char** argv) {
     RUN_TEST(test_rect_contains_zero_size);
     RUN_TEST(test_rect_default_constructor);
 
+    // InlineFunction tests
+    RUN_TEST(test_inline_function_default_empty);
+    RUN_TEST(test_inline_function_invokes_capture);
+    RUN_TEST(test_inline_function_args_and_return);
+    RUN_TEST(test_inline_function_copy_is_independent);
+
+    // Fixed container tests
+    RUN_TEST(test_fixed_string_truncates);
+    RUN_TEST(test_fixed_string_compare);
+    RUN_TEST(test_fixed_vector_rejects_when_full);
+    RUN_TEST(test_fixed_vector_insert_erase);
+
+    // WiFiNetworkList tests
+    RUN_TEST(test_wifi_list_ranked_connected_first);
+    RUN_TEST(test_wifi_list_dedupes_ssid);
+    RUN_TEST(test_wifi_list_bounded_keeps_strongest);
+    RUN_TEST(test_wifi_list_skips_empty_ssid);
+
+    // Memory budget tests
+    RUN_TEST(test_memory_ledger_tracks_peak);
+    RUN_TEST(test_memory_ledger_flags_over_budget_once);
+    RUN_TEST(test_memory_ledger_counts_allocs_per_screen);
+    RUN_TEST(test_screens_within_memory_budget);
+    RUN_TEST(test_wifi_screen_without_scan_memory);
+
+    // AppRegistry tests
+    RUN_TEST(test_registry_compiled_table_lookup);
+    RUN_TEST(test_registry_constructs_on_first_launch);
+    RUN_TEST(test_registry_reclaims_suspended_app);
+
+    // Power tier tests
+    RUN_TEST(test_power_tiers_escalate_with_inactivity);
+    RUN_TEST(test_power_timeout_zero_never_powers_off);
+    RUN_TEST(test_power_sleep_never_overshoots_next_tier);
+    RUN_TEST(test_power_commander_game_mostly_light_sleep);
+
+    // Power profile tests
+    RUN_TEST(test_power_profile_applies_together);
+    RUN_TEST(test_power_auto_saver_on_low_battery);
+    RUN_TEST(test_power_saver_coalesces_refreshes);
+
+    // Battery estimator tests
+    RUN_TEST(test_battery_filter_tracks_recorded_discharge);
+    RUN_TEST(test_battery_learns_each_profile);
+    RUN_TEST(test_battery_charging_pauses_prediction);
+    RUN_TEST(test_battery_coefficients_persist_across_boots);
+
+    // Energy ledger tests
+    RUN_TEST(test_energy_ledger_attributes_charge);
+    RUN_TEST(test_energy_refresh_charged_by_drawn_area);
+    RUN_TEST(test_energy_light_sleep_not_charged_as_cpu);
+
+    // Deferred logging tests
+    RUN_TEST(test_log_record_formats_like_printf);
+    RUN_TEST(test_log_record_copies_strings);
+    RUN_TEST(test_log_ring_wraps_and_counts_drops);
+
+    // Trace span tests
+    RUN_TEST(test_trace_ring_keeps_newest_spans);
+    RUN_TEST(test_trace_exports_nested_scopes_as_json);
+    RUN_TEST(test_trace_draw_span_contains_display);
+
+    // Sampling profiler tests
+    RUN_TEST(test_profile_ring_drops_when_full);
+    RUN_TEST(test_profile_sample_wire_format);
+
+    // Stall detector tests
+    RUN_TEST(test_stall_monitor_keeps_worst_and_blames_innermost);
+    RUN_TEST(test_stall_detects_slow_screen_callback);
+
+    // Diagnostics tests
+    RUN_TEST(test_perf_counters_window);
+    RUN_TEST(test_diagnostics_hidden_until_enabled);
+    RUN_TEST(test_diagnostics_redraws_only_changed_fields);
+
+    // Touch replay tests
+    RUN_TEST(test_touch_log_records_changes_only);
+    RUN_TEST(test_replay_four_player_game);
+    RUN_TEST(test_replay_rename_players);
+    RUN_TEST(test_replay_wifi_setup);
+
+    // EPD cost model tests
+    RUN_TEST(test_epd_model_costs_rows_and_full_updates);
+    RUN_TEST(test_epd_compare_modes_on_replay);
+
+    // Flash endurance tests
+    RUN_TEST(test_nvs_flash_model_wear);
+    RUN_TEST(test_wear_four_player_game);
+    RUN_TEST(test_wear_persistence_policies);
+
+    // Allocation tracker tests
+    RUN_TEST(test_alloc_scope_counts_new_and_delete);
+    RUN_TEST(test_life_tap_allocates_nothing);
+    RUN_TEST(test_keystroke_allocates_nothing);
+    RUN_TEST(test_screen_push_allocates_nothing);
+
+    RUN_TEST(test_drag_gesture_slop_and_steps);
+    RUN_TEST(test_life_drag_commits_on_release);
+    RUN_TEST(test_life_drag_refreshes_bounded);
+    RUN_TEST(test_auto_repeat_accelerates);
+    RUN_TEST(test_life_button_hold_repeats);
+    RUN_TEST(test_life_button_hold_stops_off_button);
+
+    RUN_TEST(test_touch_log_keeps_points_apart);
+    RUN_TEST(test_second_finger_ignored_off_cards);
+    RUN_TEST(test_two_cards_update_in_one_frame);
+    RUN_TEST(test_replay_two_player_multitouch);
+
+    RUN_TEST(test_life_commit_on_press);
+    RUN_TEST(test_life_commit_on_press_debounces);
+    RUN_TEST(test_touch_to_ink_by_commit_mode);
+
+    RUN_TEST(test_keyboard_key_at_matches_rects);
+    RUN_TEST(test_keyboard_keeps_keys_typed_before_draw);
+    RUN_TEST(test_keyboard_redraws_changed_parts_only);
+    RUN_TEST(test_keyboard_takes_overlapping_keys);
+    RUN_TEST(test_keyboard_name_typing_pixels);
+
+    // Deep-sleep resume tests
+    RUN_TEST(test_resume_warm_wake_skips_nvs_and_keeps_panel);
+    RUN_TEST(test_resume_keeps_settings_changed_in_app);
+    RUN_TEST(test_resume_cold_boot_ignores_snapshot);
+    RUN_TEST(test_deep_sleep_times_out_to_power_off);
+
     UNITY_END();
     return 0;
 }
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <M5Unified.h>
+#include <Preferences.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "app/Navigation.hpp"
+#include "utils/Power.hpp"
+#include "utils/TouchLog.hpp"
+
+// What one replayed event cost: everything since the previous event (held
+// frames, periodic saves) plus its own loop iteration
+struct ReplayEventStats {
+    uint32_t frames;           // display() calls
+    uint64_t refreshedPixels;  // Area pushed to the panel
+    uint32_t panelUs;          // Estimated panel update time (EpdModel)
+    uint32_t panelUc;          // Estimated panel charge
+    uint32_t nvsWrites;        // Entries written to NVS
+    uint32_t latencyUs;        // Virtual time from handleTouch to the end of draw
+    uint32_t cpuUs;            // Host time for the same iteration
+    uint32_t inkUs;            // Touch-to-ink, or 0: see TouchReplay
+};
+
+struct ReplayStats {
+    uint32_t events = 0;
+    uint32_t frames = 0;
+    uint64_t refreshedPixels = 0;
+    uint64_t panelUs = 0;
+    uint64_t panelUc = 0;
+    uint32_t nvsWrites = 0;
+    uint32_t maxLatencyUs = 0;
+    uint32_t maxCpuUs = 0;
+    uint32_t inkSamples = 0;
+    uint64_t inkTotalUs = 0;
+    uint32_t maxInkUs = 0;
+
+    void add(const ReplayEventStats& e) {
+        events++;
+        frames += e.frames;
+        refreshedPixels += e.refreshedPixels;
+        panelUs += e.panelUs;
+        panelUc += e.panelUc;
+        nvsWrites += e.nvsWrites;
+        if (e.latencyUs > maxLatencyUs) {
+            maxLatencyUs = e.latencyUs;
+        }
+        if (e.cpuUs > maxCpuUs) {
+            maxCpuUs = e.cpuUs;
+        }
+        if (e.inkUs > 0) {
+            inkSamples++;
+            inkTotalUs += e.inkUs;
+            if (e.inkUs > maxInkUs) {
+                maxInkUs = e.inkUs;
+            }
+        }
+    }
+
+    uint32_t meanInkUs() const {
+        return inkSamples ? static_cast<uint32_t>(inkTotalUs / inkSamples) : 0;
+    }
+};
+
+// Feeds a recorded touch session (TouchLog format) through Navigation the
+// way loop() does, under the virtual clock: each event waits out its delay
+// in frame-sized steps, repeating every held point each frame, then runs one
+// handleTouch/update/draw iteration. Events with no delay after the first
+// (several points seen in one loop) share that iteration; the stats of the
+// whole loop go to the first of them.
+//
+// Touch-to-ink is taken for a touch-down or release whose iteration
+// refreshed the panel: the virtual time since that finger went down, plus
+// the EPD update time of the refresh (EpdModel). It is what a player waits
+// from touching to seeing the result, the highlight for a Button.
+class TouchReplay {
+   public:
+    using EventCallback = void (*)(uint32_t index, const TouchEvent& event,
+                                   const ReplayEventStats& stats, void* ctx);
+
+    void onEvent(EventCallback callback, void* ctx) {
+        _callback = callback;
+        _ctx = ctx;
+    }
+
+    ReplayStats run(const char* session) {
+        auto& nav = Navigation::instance();
+        ReplayStats total;
+        for (Held& held : _held) {
+            held.down = false;
+        }
+        _loopEvents = 0;
+        mark();
+
+        char line[TouchLog::LINE_CHARS * 2];
+        const char* p = session;
+        while (*p) {
+            size_t len = strcspn(p, "\n");
+            size_t copy = len < sizeof(line) - 1 ? len : sizeof(line) - 1;
+            memcpy(line, p, copy);
+            line[copy] = '\0';
+            p += len + (p[len] == '\n' ? 1 : 0);
+
+            char appId[TouchLog::APP_ID_CHARS];
+            TouchEvent event;
+            if (TouchLog::parseApp(line, appId, sizeof(appId))) {
+                flush(total);
+                nav.launchApp(appId);
+                frame();
+                mark();
+            } else if (TouchLog::parseEvent(line, event)) {
+                if (event.dtMs > 0 || _loopEvents == MAX_LOOP_EVENTS) {
+                    flush(total);
+                }
+                _loop[_loopEvents++] = event;
+            }
+        }
+        flush(total);
+        return total;
+    }
+
+    static void print(const char* name, const ReplayStats& stats) {
+        printf("[replay] %-20s %4lu events %4lu frames %7.2f Mpx %6.1f s %6.3f mAh panel "
+               "%3lu NVS writes, max latency %lu ms, ink %lu/%lu ms, max cpu %lu us\n",
+               name, static_cast<unsigned long>(stats.events),
+               static_cast<unsigned long>(stats.frames), stats.refreshedPixels / 1e6,
+               stats.panelUs / 1e6, stats.panelUc / 3.6e6,
+               static_cast<unsigned long>(stats.nvsWrites),
+               static_cast<unsigned long>(stats.maxLatencyUs / 1000),
+               static_cast<unsigned long>(stats.meanInkUs() / 1000),
+               static_cast<unsigned long>(stats.maxInkUs / 1000),
+               static_cast<unsigned long>(stats.maxCpuUs));
+    }
+
+   private:
+    static constexpr uint32_t MAX_LOOP_EVENTS = TouchPoint::MAX_POINTS * 2;
+
+    struct Held {
+        bool down = false;
+        int16_t x = 0;
+        int16_t y = 0;
+    };
+
+    EventCallback _callback = nullptr;
+    void* _ctx = nullptr;
+    Held _held[TouchPoint::MAX_POINTS];
+    uint32_t _downUs[TouchPoint::MAX_POINTS] = {};
+    TouchEvent _loop[MAX_LOOP_EVENTS];
+    uint32_t _loopEvents = 0;
+    uint32_t _frames = 0;
+    uint64_t _pixels = 0;
+    uint64_t _panelUs = 0;
+    uint64_t _panelUc = 0;
+    uint32_t _writes = 0;
+
+    void mark() {
+        _frames = M5.Display.hostStats().displayCalls;
+        _pixels = M5.Display.hostStats().refreshedPixels;
+        _panelUs = M5.Display.hostStats().panelUs;
+        _panelUc = M5.Display.hostStats().panelUc;
+        _writes = HostNvs::instance().writes;
+    }
+
+    static void frame() {
+        auto& nav = Navigation::instance();
+        nav.update();
+        nav.draw(&M5.Display);
+    }
+
+    static void touch(uint8_t id, int16_t x, int16_t y, bool pressed, bool released) {
+        TouchPoint point;
+        point.id = id;
+        point.x = x;
+        point.y = y;
+        point.pressed = pressed;
+        point.released = released;
+        Navigation::instance().handleTouch(point);
+    }
+
+    void flush(ReplayStats& total) {
+        if (_loopEvents == 0) {
+            return;
+        }
+        ReplayEventStats stats = play();
+        for (uint32_t i = 0; i < _loopEvents; i++) {
+            ReplayEventStats eventStats = i == 0 ? stats : ReplayEventStats{};
+            if (_callback) {
+                _callback(total.events, _loop[i], eventStats, _ctx);
+            }
+            total.add(eventStats);
+        }
+        _loopEvents = 0;
+    }
+
+    // One loop iteration with every event in _loop, after the first one's delay
+    ReplayEventStats play() {
+        uint32_t frameMs = Power::profileConfig().frameMs;
+        uint32_t wait = _loop[0].dtMs;
+        while (wait > frameMs) {
+            HostClock::advance(frameMs);
+            wait -= frameMs;
+            for (uint8_t id = 0; id < TouchPoint::MAX_POINTS; id++) {
+                if (_held[id].down) {
+                    touch(id, _held[id].x, _held[id].y, true, false);
+                }
+            }
+            frame();
+        }
+        HostClock::advance(wait);
+
+        uint32_t startUs = micros();
+        uint32_t callsBefore = M5.Display.hostStats().displayCalls;
+        uint64_t panelBefore = M5.Display.hostStats().panelUs;
+        int inkPoint = -1;  // First touch-down or release of the loop
+        auto cpuStart = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < _loopEvents; i++) {
+            const TouchEvent& event = _loop[i];
+            bool down = event.pressed && !_held[event.id].down;
+            if (down) {
+                _downUs[event.id] = micros();
+            }
+            if (inkPoint < 0 && (down || event.released)) {
+                inkPoint = event.id;
+            }
+            touch(event.id, event.x, event.y, event.pressed, event.released);
+            _held[event.id].down = event.pressed && !event.released;
+            _held[event.id].x = event.x;
+            _held[event.id].y = event.y;
+        }
+        frame();
+        auto cpuEnd = std::chrono::steady_clock::now();
+
+        ReplayEventStats stats;
+        stats.frames = M5.Display.hostStats().displayCalls - _frames;
+        stats.refreshedPixels = M5.Display.hostStats().refreshedPixels - _pixels;
+        stats.panelUs = static_cast<uint32_t>(M5.Display.hostStats().panelUs - _panelUs);
+        stats.panelUc = static_cast<uint32_t>(M5.Display.hostStats().panelUc - _panelUc);
+        stats.nvsWrites = HostNvs::instance().writes - _writes;
+        stats.latencyUs = micros() - startUs;
+        stats.cpuUs = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(cpuEnd - cpuStart).count());
+        stats.inkUs = 0;
+        if (inkPoint >= 0 && M5.Display.hostStats().displayCalls > callsBefore) {
+            stats.inkUs = micros() - _downUs[inkPoint] +
+                          static_cast<uint32_t>(M5.Display.hostStats().panelUs - panelBefore);
+        }
+        mark();
+        return stats;
+    }
+};
@@ -0,0 +1,588 @@
+#pragma once
+
+// Touch sessions (TouchLog format) replayed by the native tests as regression
+// corpora. Scripted against the screen layouts with jittered positions and
+// play-like timings; a trace build records the same format with the serial
+// 'r' command. Each starts from a fresh install:
+//   FOUR_PLAYER_GAME  Switch to four players, then ~70 turns of life changes
+//   RENAME_PLAYERS    Switch to four players and rename each on the keyboard
+//   WIFI_SETUP        Scan, join a secured network, enable auto-connect
+//   TWO_PLAYER_MULTITOUCH  Two players at once: overlapping taps, taps in the
+//                          same loop, a drag against a held button, and a
+//                          second finger on a card already in use
+
+static const char* const FOUR_PLAYER_GAME = R"(~T app mtg
+~T 900 901 55 P
+~T 101 901 55 R
+~T 524 241 153 P
+~T 128 241 153 R
+~T 1381 52 49 P
+~T 73 51 48 P
+~T 51 51 48 R
+~T 673 174 268 P
+~T 132 174 268 R
+~T 275 173 273 P
+~T 88 173 273 R
+~T 398 175 273 P
+~T 59 174 272 P
+~T 54 174 272 R
+~T 614 660 265 P
+~T 68 660 265 R
+~T 504 659 271 P
+~T 147 659 271 R
+~T 488 658 270 P
+~T 43 657 269 P
+~T 91 657 269 R
+~T 623 177 504 P
+~T 117 177 504 R
+~T 310 179 497 P
+~T 125 179 497 R
+~T 270 898 273 P
+~T 145 898 273 R
+~T 698 902 270 P
+~T 100 902 270 R
+~T 388 539 505 P
+~T 59 540 505 P
+~T 61 540 505 R
+~T 261 779 497 P
+~T 119 779 497 R
+~T 502 777 499 P
+~T 27 778 499 P
+~T 40 778 499 R
+~T 455 532 497 P
+~T 130 532 497 R
+~T 692 532 501 P
+~T 130 532 501 R
+~T 292 899 498 P
+~T 82 899 498 R
+~T 343 177 265 P
+~T 54 178 266 P
+~T 39 178 266 R
+~T 539 175 273 P
+~T 100 175 273 R
+~T 585 184 265 P
+~T 146 184 265 R
+~T 303 661 501 P
+~T 28 660 501 P
+~T 93 660 501 R
+~T 333 656 504 P
+~T 20 655 505 P
+~T 54 655 505 R
+~T 263 422 274 P
+~T 40 423 274 P
+~T 29 423 274 R
+~T 558 426 266 P
+~T 82 427 266 P
+~T 24 427 266 R
+~T 497 420 267 P
+~T 41 421 267 P
+~T 58 421 267 R
+~T 520 653 273 P
+~T 106 653 273 R
+~T 606 427 500 P
+~T 93 427 500 R
+~T 527 304 500 P
+~T 159 304 500 R
+~T 563 308 498 P
+~T 160 308 498 R
+~T 668 307 498 P
+~T 83 308 499 P
+~T 28 308 499 R
+~T 6118 185 499 P
+~T 63 185 499 R
+~T 478 779 270 P
+~T 33 778 270 P
+~T 119 778 270 R
+~T 350 777 272 P
+~T 103 777 272 R
+~T 426 174 275 P
+~T 69 173 275 P
+~T 73 173 275 R
+~T 341 185 275 P
+~T 70 186 275 P
+~T 45 186 275 R
+~T 630 184 267 P
+~T 24 183 266 P
+~T 46 183 266 R
+~T 563 781 505 P
+~T 136 781 505 R
+~T 260 663 275 P
+~T 24 664 274 P
+~T 37 664 274 R
+~T 399 531 274 P
+~T 89 532 273 P
+~T 35 532 273 R
+~T 484 305 273 P
+~T 144 305 273 R
+~T 699 298 273 P
+~T 85 297 273 P
+~T 39 297 273 R
+~T 338 658 274 P
+~T 78 658 274 R
+~T 521 180 266 P
+~T 131 180 266 R
+~T 279 176 269 P
+~T 26 177 270 P
+~T 65 177 270 R
+~T 264 174 272 P
+~T 84 173 273 P
+~T 73 173 273 R
+~T 663 181 498 P
+~T 121 181 498 R
+~T 698 181 498 P
+~T 93 181 498 R
+~T 320 174 501 P
+~T 113 174 501 R
+~T 287 306 269 P
+~T 87 306 269 R
+~T 647 307 275 P
+~T 79 307 275 R
+~T 489 662 266 P
+~T 51 661 267 P
+~T 37 661 267 R
+~T 513 533 271 P
+~T 60 532 272 P
+~T 51 532 272 R
+~T 437 533 273 P
+~T 62 533 273 R
+~T 569 181 266 P
+~T 70 180 265 P
+~T 27 180 265 R
+~T 293 177 265 P
+~T 93 177 265 R
+~T 342 185 267 P
+~T 94 185 267 R
+~T 513 180 500 P
+~T 27 179 500 P
+~T 106 179 500 R
+~T 287 173 505 P
+~T 36 172 506 P
+~T 58 172 506 R
+~T 688 174 499 P
+~T 88 174 499 R
+~T 463 537 497 P
+~T 65 536 496 P
+~T 29 536 496 R
+~T 332 528 497 P
+~T 39 529 498 P
+~T 54 529 498 R
+~T 638 532 502 P
+~T 86 532 502 R
+~T 6728 656 495 P
+~T 94 656 495 R
+~T 508 53 273 P
+~T 130 53 273 R
+~T 478 60 275 P
+~T 73 60 275 R
+~T 503 56 273 P
+~T 47 55 273 P
+~T 82 55 273 R
+~T 623 776 271 P
+~T 141 776 271 R
+~T 277 774 266 P
+~T 76 774 266 R
+~T 700 780 267 P
+~T 62 781 268 P
+~T 30 781 268 R
+~T 400 180 497 P
+~T 34 179 497 P
+~T 31 179 497 R
+~T 436 181 500 P
+~T 81 182 499 P
+~T 21 182 499 R
+~T 432 173 500 P
+~T 50 174 501 P
+~T 33 174 501 R
+~T 296 652 267 P
+~T 22 653 266 P
+~T 71 653 266 R
+~T 293 181 497 P
+~T 134 181 497 R
+~T 503 778 504 P
+~T 79 778 504 R
+~T 272 782 505 P
+~T 151 782 505 R
+~T 608 776 503 P
+~T 124 776 503 R
+~T 658 306 275 P
+~T 23 305 274 P
+~T 128 305 274 R
+~T 576 297 271 P
+~T 106 297 271 R
+~T 535 306 265 P
+~T 66 306 265 R
+~T 483 662 273 P
+~T 68 662 273 R
+~T 631 180 269 P
+~T 154 180 269 R
+~T 368 183 502 P
+~T 154 183 502 R
+~T 397 528 504 P
+~T 158 528 504 R
+~T 351 537 497 P
+~T 40 538 498 P
+~T 29 538 498 R
+~T 540 528 502 P
+~T 37 527 503 P
+~T 40 527 503 R
+~T 612 778 272 P
+~T 126 778 272 R
+~T 642 782 268 P
+~T 25 783 267 P
+~T 50 783 267 R
+~T 480 179 498 P
+~T 94 179 498 R
+~T 357 182 496 P
+~T 36 183 496 P
+~T 33 183 496 R
+~T 317 183 503 P
+~T 34 184 502 P
+~T 103 184 502 R
+~T 451 776 495 P
+~T 63 776 495 R
+~T 598 780 499 P
+~T 117 780 499 R
+~T 311 651 500 P
+~T 102 651 500 R
+~T 679 652 498 P
+~T 110 652 498 R
+~T 7187 656 496 P
+~T 57 655 496 P
+~T 35 655 496 R
+~T 393 774 505 P
+~T 29 773 505 P
+~T 44 773 505 R
+~T 645 663 501 P
+~T 107 663 501 R
+~T 531 785 496 P
+~T 66 786 496 P
+~T 20 786 496 R
+~T 564 776 505 P
+~T 156 776 505 R
+~T 498 782 497 P
+~T 33 783 497 P
+~T 33 783 497 R
+~T 584 179 505 P
+~T 50 180 504 P
+~T 43 180 504 R
+~T 335 175 496 P
+~T 83 174 496 P
+~T 59 174 496 R
+~T 420 180 501 P
+~T 44 179 500 P
+~T 113 179 500 R
+~T 413 656 269 P
+~T 90 656 269 R
+~T 695 780 271 P
+~T 112 780 271 R
+~T 357 778 270 P
+~T 108 778 270 R
+~T 505 783 270 P
+~T 52 782 269 P
+~T 43 782 269 R
+~T 454 303 501 P
+~T 142 303 501 R
+~T 684 298 495 P
+~T 62 298 495 R
+~T 250 903 503 P
+~T 69 903 503 R
+~T 479 909 496 P
+~T 29 908 497 P
+~T 62 908 497 R
+~T 250 530 498 P
+~T 160 530 498 R
+~T 315 177 273 P
+~T 140 177 273 R
+~T 607 174 266 P
+~T 87 173 266 P
+~T 70 173 266 R
+~T 250 181 499 P
+~T 61 181 499 R
+~T 392 183 498 P
+~T 100 183 498 R
+~T 370 176 495 P
+~T 130 176 495 R
+~T 505 60 501 P
+~T 49 61 501 P
+~T 97 61 501 R
+~T 423 657 270 P
+~T 151 657 270 R
+~T 351 663 269 P
+~T 60 663 269 R
+~T 508 654 272 P
+~T 68 654 272 R
+~T 368 299 499 P
+~T 119 299 499 R
+~T 503 52 498 P
+~T 138 52 498 R
+~T 590 59 497 P
+~T 67 59 497 R
+~T 277 50 504 P
+~T 23 49 503 P
+~T 64 49 503 R
+~T 7611 184 500 P
+~T 117 184 500 R
+~T 347 429 273 P
+~T 83 429 273 R
+~T 266 429 271 P
+~T 99 429 271 R
+~T 251 177 496 P
+~T 50 176 497 P
+~T 20 176 497 R
+~T 670 652 265 P
+~T 115 652 265 R
+~T 350 659 272 P
+~T 66 660 271 P
+~T 41 660 271 R
+~T 642 651 501 P
+~T 28 650 501 P
+~T 83 650 501 R
+~T 349 652 504 P
+~T 54 653 505 P
+~T 101 653 505 R
+~T 272 662 500 P
+~T 93 662 500 R
+~T 662 51 495 P
+~T 141 51 495 R
+~T 304 61 502 P
+~T 120 61 502 R
+~T 447 56 502 P
+~T 51 55 501 P
+~T 41 55 501 R
+~T 560 301 500 P
+~T 90 301 500 R
+~T 635 176 271 P
+~T 22 177 272 P
+~T 58 177 272 R
+~T 528 175 271 P
+~T 101 175 271 R
+~T 356 179 272 P
+~T 72 179 272 R
+~T 463 660 505 P
+~T 88 659 505 P
+~T 30 659 505 R
+~T 440 184 499 P
+~T 35 183 498 P
+~T 57 183 498 R
+~T 370 177 504 P
+~T 24 178 504 P
+~T 55 178 504 R
+~T end 355
+)";
+
+static const char* const RENAME_PLAYERS = R"(~T app mtg
+~T 900 907 57 P
+~T 71 906 58 P
+~T 20 906 58 R
+~T 925 241 148 P
+~T 64 241 148 R
+~T 1288 56 54 P
+~T 38 55 53 P
+~T 51 55 53 R
+~T 951 244 112 P
+~T 24 245 113 P
+~T 60 245 113 R
+~T 195 887 338 P
+~T 78 887 338 R
+~T 151 888 343 P
+~T 56 888 343 R
+~T 239 878 339 P
+~T 21 877 339 P
+~T 42 877 339 R
+~T 159 889 344 P
+~T 88 889 344 R
+~T 152 884 344 P
+~T 39 885 343 P
+~T 31 885 343 R
+~T 202 890 341 P
+~T 52 890 341 R
+~T 166 879 340 P
+~T 76 879 340 R
+~T 189 886 335 P
+~T 90 886 335 R
+~T 281 113 396 P
+~T 94 113 396 R
+~T 350 763 390 P
+~T 38 764 390 P
+~T 31 764 390 R
+~T 286 647 339 P
+~T 51 647 339 R
+~T 280 358 449 P
+~T 96 358 449 R
+~T 291 232 340 P
+~T 31 233 341 P
+~T 76 233 341 R
+~T 686 576 504 P
+~T 26 575 505 P
+~T 92 575 505 R
+~T 1306 722 112 P
+~T 71 722 112 R
+~T 279 880 339 P
+~T 36 879 338 P
+~T 24 879 338 R
+~T 177 885 337 P
+~T 22 886 337 P
+~T 52 886 337 R
+~T 163 888 340 P
+~T 65 887 341 P
+~T 23 887 341 R
+~T 206 884 343 P
+~T 89 884 343 R
+~T 271 887 337 P
+~T 36 886 337 P
+~T 25 886 337 R
+~T 241 880 337 P
+~T 57 880 337 R
+~T 199 886 344 P
+~T 25 885 344 P
+~T 27 885 344 R
+~T 266 888 338 P
+~T 85 888 338 R
+~T 258 517 452 P
+~T 43 518 453 P
+~T 44 518 453 R
+~T 292 716 334 P
+~T 61 716 334 R
+~T 305 517 453 P
+~T 79 517 453 R
+~T 899 566 509 P
+~T 118 566 509 R
+~T 968 240 339 P
+~T 48 239 338 P
+~T 28 239 338 R
+~T 183 889 339 P
+~T 55 889 339 R
+~T 280 878 342 P
+~T 55 878 342 R
+~T 184 879 343 P
+~T 51 879 343 R
+~T 178 880 341 P
+~T 25 879 340 P
+~T 37 879 340 R
+~T 239 890 338 P
+~T 59 891 338 P
+~T 30 891 338 R
+~T 186 886 341 P
+~T 28 885 341 P
+~T 38 885 341 R
+~T 245 881 336 P
+~T 52 881 336 R
+~T 221 884 336 P
+~T 70 884 336 R
+~T 247 364 454 P
+~T 31 365 455 P
+~T 26 365 455 R
+~T 313 120 391 P
+~T 54 121 392 P
+~T 33 121 392 R
+~T 384 315 340 P
+~T 73 315 340 R
+~T 327 721 339 P
+~T 59 721 339 R
+~T 293 759 399 P
+~T 64 759 399 R
+~T 524 572 506 P
+~T 75 573 507 P
+~T 22 573 507 R
+~T 901 713 336 P
+~T 98 714 336 P
+~T 57 714 336 R
+~T 281 878 336 P
+~T 73 878 336 R
+~T 161 878 334 P
+~T 51 878 334 R
+~T 227 886 339 P
+~T 56 886 339 R
+~T 255 882 343 P
+~T 43 883 342 P
+~T 44 883 342 R
+~T 184 890 337 P
+~T 50 890 337 R
+~T 265 879 344 P
+~T 28 880 344 P
+~T 28 880 344 R
+~T 152 888 342 P
+~T 53 888 342 R
+~T 298 887 342 P
+~T 78 887 342 R
+~T 243 271 390 P
+~T 20 272 389 P
+~T 40 272 389 R
+~T 240 109 391 P
+~T 37 108 390 P
+~T 23 108 390 R
+~T 285 441 455 P
+~T 62 441 455 R
+~T 345 236 343 P
+~T 39 235 343 P
+~T 52 235 343 R
+~T 820 575 509 P
+~T 66 575 509 R
+~T end 147
+)";
+
+static const char* const WIFI_SETUP = R"(~T app settings
+~T 1200 400 137 P
+~T 60 400 137 R
+~T 926 910 59 P
+~T 70 910 59 R
+~T 2500 475 148 P
+~T 22 474 148 P
+~T 66 474 148 R
+~T 408 525 394 P
+~T 97 525 394 R
+~T 248 562 344 P
+~T 90 562 344 R
+~T 381 603 450 P
+~T 47 602 451 P
+~T 61 602 451 R
+~T 183 396 337 P
+~T 60 396 337 R
+~T 231 232 339 P
+~T 69 233 340 P
+~T 41 233 340 R
+~T 241 321 344 P
+~T 74 321 344 R
+~T 317 116 454 P
+~T 120 116 454 R
+~T 399 155 337 P
+~T 51 155 337 R
+~T 258 152 340 P
+~T 100 152 340 R
+~T 700 573 504 P
+~T 20 572 503 P
+~T 49 572 503 R
+~T 2000 51 54 P
+~T 139 51 54 R
+~T 1167 744 131 P
+~T 40 743 132 P
+~T 23 743 132 R
+~T end 35
+)";
+
+static const char* const TWO_PLAYER_MULTITOUCH = R"(~T app mtg
+~T 800 302 500 P
+~T 40 780 501 P 1
+~T 90 302 500 R
+~T 30 780 501 R 1
+~T 700 56 498 P
+~T 0 534 499 P 1
+~T 110 56 498 R
+~T 0 534 499 R 1
+~T 700 241 300 P
+~T 20 241 282 P
+~T 10 780 500 P 1
+~T 30 241 250 P
+~T 40 241 220 P
+~T 40 241 200 P
+~T 40 241 180 P
+~T 60 241 180 R
+~T 690 780 500 R 1
+~T 600 657 500 P 1
+~T 80 657 500 R 1
+~T 600 179 500 P
+~T 30 302 500 P 1
+~T 60 302 500 R 1
+~T 20 179 500 R
+~T end 23
+)";
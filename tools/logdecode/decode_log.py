@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""Decode the binary log stream of a -DLOG_BINARY firmware build.
+
+The device sends each format string once (a 'D' frame) and afterwards only its
+id, a timestamp and the raw arguments ('M' frames); see src/utils/Log.cpp and
+src/utils/LogRecord.hpp. Bytes outside frames (boot ROM, panics) are passed
+through as text.
+
+Usage:
+    python decode_log.py /dev/ttyACM0            # Live, needs pyserial
+    python decode_log.py capture.bin             # Saved with e.g. `cat /dev/ttyACM0 > capture.bin`
+    python decode_log.py /dev/ttyACM0 --raw out.bin   # Also keep the raw stream
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FRAME_SYNC = 0xA5
+LEVELS = "EWID"
+
+ARG_I32, ARG_I64, ARG_F64, ARG_STR, ARG_PTR = 1, 2, 3, 4, 5
+
+# %[flags][width][.precision][length]conversion, or %%
+SPEC_RE = re.compile(r"%(%|[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z|j|t|L)?[diuxXocfFeEgGsp])")
+
+
+def read_args(data):
+    """Yield (tag, value) for the tagged arguments of a message frame."""
+    i = 0
+    while i < len(data):
+        tag = data[i]
+        i += 1
+        if tag == ARG_I32:
+            yield tag, struct.unpack_from("<I", data, i)[0]
+            i += 4
+        elif tag in (ARG_I64, ARG_PTR):
+            yield tag, struct.unpack_from("<Q", data, i)[0]
+            i += 8
+        elif tag == ARG_F64:
+            yield tag, struct.unpack_from("<d", data, i)[0]
+            i += 8
+        elif tag == ARG_STR:
+            n = data[i]
+            yield tag, data[i + 1:i + 1 + n].decode("utf-8", "replace")
+            i += 1 + n
+        else:
+            return
+
+
+def format_message(fmt, args):
+    """Python rendering of LogRecord::format()."""
+    args = list(args)
+
+    def expand(match):
+        spec = match.group(1)
+        if spec == "%":
+            return "%"
+        if not args:
+            return "<?>"
+        tag, value = args.pop(0)
+        conv = spec[-1]
+        spec = "%" + re.sub(r"(hh|h|ll|l|z|j|t|L)(?=.$)", "", spec)
+        if conv in "di":
+            if tag == ARG_I32 and value >= 1 << 31:
+                value -= 1 << 32
+            elif tag == ARG_I64 and value >= 1 << 63:
+                value -= 1 << 64
+            return spec % value if tag in (ARG_I32, ARG_I64) else "<?>"
+        if conv in "uxXo":
+            return (spec.replace("u", "d") % value) if tag in (ARG_I32, ARG_I64) else "<?>"
+        if conv == "c":
+            return spec % chr(value) if tag == ARG_I32 else "<?>"
+        if conv in "fFeEgG":
+            return spec % value if tag == ARG_F64 else "<?>"
+        if conv == "s":
+            return spec % value if tag == ARG_STR else "<?>"
+        if conv == "p":
+            return "0x%x" % value if tag == ARG_PTR else "<?>"
+        return "<?>"
+
+    return SPEC_RE.sub(expand, fmt)
+
+
+class Decoder:
+    def __init__(self, out):
+        self.out = out
+        self.formats = {}
+        self.buf = bytearray()
+        self.text = bytearray()
+
+    def feed(self, data):
+        self.buf += data
+        while self.buf:
+            sync = self.buf.find(bytes([FRAME_SYNC]))
+            if sync < 0:
+                self._text(self.buf)
+                self.buf.clear()
+                return
+            if sync > 0:
+                self._text(self.buf[:sync])
+                del self.buf[:sync]
+            if len(self.buf) < 4:
+                return
+            ftype = self.buf[1]
+            length = self.buf[2] | (self.buf[3] << 8)
+            if len(self.buf) < 5 + length:
+                return
+            payload = bytes(self.buf[4:4 + length])
+            if (sum(self.buf[1:4 + length]) & 0xFF) != self.buf[4 + length]:
+                self._text(self.buf[:1])  # Not a frame: a stray 0xA5 in text
+                del self.buf[:1]
+                continue
+            del self.buf[:5 + length]
+            self._frame(chr(ftype), payload)
+
+    def _text(self, data):
+        self.text += data
+        while b"\n" in self.text:
+            line, _, rest = self.text.partition(b"\n")
+            self.out.write(line.decode("utf-8", "replace") + "\n")
+            self.text = bytearray(rest)
+
+    def _frame(self, ftype, payload):
+        if ftype == "D":
+            (fid,) = struct.unpack_from("<H", payload)
+            self.formats[fid] = payload[2:].decode("utf-8", "replace")
+        elif ftype == "M":
+            fid, level, _argc, us = struct.unpack_from("<HBBI", payload)
+            fmt = self.formats.get(fid)
+            if fmt is None:
+                text = "<unknown format %d>" % fid
+            else:
+                text = format_message(fmt, read_args(payload[8:]))
+            level_char = LEVELS[level] if level < len(LEVELS) else "?"
+            self.out.write("%10.6f [%s] %s\n" % (us / 1e6, level_char, text))
+        elif ftype == "R":
+            self.formats.clear()
+        elif ftype == "X":
+            (lost,) = struct.unpack_from("<I", payload)
+            self.out.write("[W] Log: dropped %d records\n" % lost)
+        self.out.flush()
+
+
+def open_source(path, baud):
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        try:
+            import serial
+        except ImportError:
+            print("ERROR: pyserial not installed. Run: pip install pyserial")
+            sys.exit(1)
+        port = serial.Serial(path, baud, timeout=0.1)
+        return lambda: port.read(4096)
+    f = open(path, "rb")
+    return lambda: f.read(4096) or None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="Serial port or capture file")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--raw", help="Also write the undecoded stream to this file")
+    args = parser.parse_args()
+
+    read = open_source(args.source, args.baud)
+    raw = open(args.raw, "wb") if args.raw else None
+    decoder = Decoder(sys.stdout)
+    try:
+        while True:
+            data = read()
+            if data is None:
+                break
+            if raw:
+                raw.write(data)
+            decoder.feed(data)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
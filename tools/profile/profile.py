@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""Symbolize samples from a -DPROFILE firmware build into a flat profile and call graph.
+
+The device streams one "~P <pc> <caller>" line per timer sample once profiling is
+started by sending 'p' over serial (see src/utils/Profiler.cpp). Addresses are
+resolved with addr2line against the firmware ELF of the same build.
+
+Usage:
+    python profile.py /dev/ttyACM0 --seconds 20       # Starts and stops profiling itself
+    python profile.py capture.txt                     # Saved serial output
+    python profile.py capture.txt --collapsed out.txt # Also write flamegraph.pl input
+"""
+
+import argparse
+import collections
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+DEFAULT_ELF = ".pio/build/m5papers3_profile/firmware.elf"
+ADDR2LINE = "xtensa-esp32s3-elf-addr2line"
+
+SAMPLE_RE = re.compile(r"~P ([0-9a-f]{8}) ([0-9a-f]{8})")
+START_RE = re.compile(r"~S (\d+)")
+DROPPED_RE = re.compile(r"~X (\d+)")
+
+
+class Capture:
+    def __init__(self):
+        self.samples = collections.Counter()  # (pc, caller) -> count
+        self.hz = None
+        self.dropped = 0
+
+    def feed_line(self, line):
+        m = SAMPLE_RE.search(line)
+        if m:
+            self.samples[(int(m.group(1), 16), int(m.group(2), 16))] += 1
+            return
+        m = START_RE.search(line)
+        if m:
+            self.hz = int(m.group(1))
+            return
+        m = DROPPED_RE.search(line)
+        if m:
+            self.dropped += int(m.group(1))
+
+    def total(self):
+        return sum(self.samples.values())
+
+
+def find_addr2line(path):
+    if path:
+        return path
+    found = shutil.which(ADDR2LINE)
+    if found:
+        return found
+    pio = os.path.expanduser("~/.platformio/packages/toolchain-xtensa-esp32s3/bin/" + ADDR2LINE)
+    matches = glob.glob(pio)
+    if matches:
+        return matches[0]
+    print("ERROR: %s not found; pass --addr2line" % ADDR2LINE)
+    sys.exit(1)
+
+
+def symbolize(addresses, elf, addr2line):
+    """Map each address to (function, file:line) with a single addr2line run."""
+    addresses = sorted(a for a in addresses if a)
+    names = {0: ("[interrupt]", "")}
+    if not addresses:
+        return names
+    out = subprocess.run([addr2line, "-f", "-C", "-e", elf] + ["0x%08x" % a for a in addresses],
+                         capture_output=True, text=True, check=True).stdout.splitlines()
+    for i, address in enumerate(addresses):
+        function = out[2 * i] if 2 * i < len(out) else "??"
+        location = os.path.basename(out[2 * i + 1]) if 2 * i + 1 < len(out) else ""
+        if function == "??":
+            function = "0x%08x" % address
+        names[address] = (function, location)
+    return names
+
+
+def report(capture, names, top, out):
+    total = capture.total()
+    if total == 0:
+        out.write("No samples. Was profiling started ('p') on a -DPROFILE build?\n")
+        return
+    rate = " at %d Hz" % capture.hz if capture.hz else ""
+    out.write("%d samples%s, %d dropped\n\n" % (total, rate, capture.dropped))
+
+    def name(address):
+        return names[address][0]
+
+    self_counts = collections.Counter()
+    lines = collections.Counter()
+    callers = collections.defaultdict(collections.Counter)
+    callees = collections.defaultdict(collections.Counter)
+    for (pc, caller), n in capture.samples.items():
+        function = name(pc)
+        self_counts[function] += n
+        lines[names[pc][1]] += n
+        if caller:
+            # The return address points after the call; step back into it
+            parent = name(caller - 1)
+            callers[function][parent] += n
+            callees[parent][function] += n
+
+    out.write("Flat profile (self time):\n")
+    out.write("  %6s %6s %8s  %s\n" % ("self%", "cum%", "samples", "function"))
+    cumulative = 0
+    for function, n in self_counts.most_common(top):
+        cumulative += n
+        out.write("  %6.2f %6.2f %8d  %s\n" % (100.0 * n / total, 100.0 * cumulative / total, n,
+                                              function))
+
+    out.write("\nHot lines:\n")
+    for location, n in lines.most_common(min(top, 15)):
+        out.write("  %6.2f %8d  %s\n" % (100.0 * n / total, n, location or "?"))
+
+    out.write("\nCall graph (callers above, callees below each function):\n")
+    for function, n in self_counts.most_common(top):
+        for parent, m in callers[function].most_common(3):
+            out.write("              %8d      %s\n" % (m, parent))
+        out.write("  %6.2f %8d  %s\n" % (100.0 * n / total, n, function))
+        for child, m in callees[function].most_common(3):
+            out.write("              %8d      %s\n" % (m, child))
+        out.write("  ----\n")
+
+
+def write_collapsed(capture, names, path):
+    """One "caller;function count" line per edge, for flamegraph.pl"""
+    stacks = collections.Counter()
+    for (pc, caller), n in capture.samples.items():
+        frames = [names[pc][0]]
+        if caller:
+            frames.insert(0, names[caller - 1][0])
+        stacks[";".join(frames)] += n
+    with open(path, "w") as f:
+        for stack, n in sorted(stacks.items()):
+            f.write("%s %d\n" % (stack, n))
+
+
+def capture_serial(path, baud, seconds, capture, raw):
+    try:
+        import serial
+    except ImportError:
+        print("ERROR: pyserial not installed. Run: pip install pyserial")
+        sys.exit(1)
+    port = serial.Serial(path, baud, timeout=0.1)
+    port.write(b"p")
+    deadline = time.time() + seconds
+    pending = b""
+    try:
+        while time.time() < deadline:
+            data = port.read(4096)
+            if raw:
+                raw.write(data)
+            pending += data
+            *complete, pending = pending.split(b"\n")
+            for line in complete:
+                capture.feed_line(line.decode("ascii", "replace"))
+    except KeyboardInterrupt:
+        pass
+    port.write(b"p")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="Serial port or capture file")
+    parser.add_argument("--elf", default=DEFAULT_ELF, help="Firmware ELF (default: %(default)s)")
+    parser.add_argument("--addr2line", help="Path to %s" % ADDR2LINE)
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--seconds", type=float, default=10, help="Serial capture length")
+    parser.add_argument("--top", type=int, default=30, help="Functions to list")
+    parser.add_argument("--raw", help="Also write the serial capture to this file")
+    parser.add_argument("--collapsed", help="Write collapsed stacks for flamegraph.pl")
+    args = parser.parse_args()
+
+    capture = Capture()
+    if args.source.startswith("/dev/") or args.source.upper().startswith("COM"):
+        raw = open(args.raw, "wb") if args.raw else None
+        capture_serial(args.source, args.baud, args.seconds, capture, raw)
+    else:
+        with open(args.source, encoding="ascii", errors="replace") as f:
+            for line in f:
+                capture.feed_line(line)
+
+    addresses = set()
+    for pc, caller in capture.samples:
+        addresses.add(pc)
+        if caller:
+            addresses.add(caller - 1)
+    names = symbolize(addresses, args.elf, find_addr2line(args.addr2line))
+
+    report(capture, names, args.top, sys.stdout)
+    if args.collapsed:
+        write_collapsed(capture, names, args.collapsed)
+
+
+if __name__ == "__main__":
+    main()